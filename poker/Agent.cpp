@@ -0,0 +1,128 @@
+#include "Agent.h"
+#include "HandEvaluator.h"
+
+Action Agent::toAction(const BotDecision& decision, const TableState& state) {
+    switch (decision.action) {
+        case BotAction::FOLD: return { ActionType::FOLD, 0 };
+        case BotAction::CHECK: return { ActionType::CHECK, 0 };
+        case BotAction::CALL: return { ActionType::CALL, 0 };
+        case BotAction::RAISE: return { ActionType::RAISE, state.currentBet + decision.amount };
+        case BotAction::ALL_IN: return { ActionType::ALL_IN, 0 };
+    }
+    return { ActionType::CALL, 0 };
+}
+
+int Agent::getPushFoldThreshold(const std::string& spec) {
+    if (spec.rfind("pushfold:", 0) == 0) {
+        return std::stoi(spec.substr(9));
+    }
+    return -1;
+}
+
+std::unique_ptr<Agent> Agent::create(const std::string& spec, const std::string& name, unsigned seed) {
+    if (spec == "bot") {
+        return std::make_unique<BotAgent>(name, seed);
+    }
+    if (spec.rfind("bot:", 0) == 0) {
+        BotConfig config;
+        if (!BotConfig::parse(spec.substr(4), config)) return nullptr;
+        return std::make_unique<BotAgent>(name, seed, config);
+    }
+    if (spec == "call") {
+        return std::make_unique<ScriptedAgent>(name, ScriptedAgent::parseScript("C"));
+    }
+    if (spec == "raise") {
+        return std::make_unique<ScriptedAgent>(name, ScriptedAgent::parseScript("R"));
+    }
+    if (spec == "allin") {
+        return std::make_unique<ScriptedAgent>(name, ScriptedAgent::parseScript("A"));
+    }
+    if (spec.rfind("script:", 0) == 0) {
+        return std::make_unique<ScriptedAgent>(name, ScriptedAgent::parseScript(spec.substr(7)));
+    }
+    if (getPushFoldThreshold(spec) >= 0) {
+        return std::make_unique<PushFoldAgent>(name, getPushFoldThreshold(spec));
+    }
+    return nullptr;
+}
+
+BotAgent::BotAgent(const std::string& name, unsigned seed, const BotConfig& config) : bot(name) {
+    bot.setSeed(seed);
+    bot.setConfig(config);
+}
+
+BotDecision BotAgent::decide(const AgentView& view) {
+    bot.resetForNewHand();
+    for (const Card& card : view.holeCards) {
+        bot.addCard(card);
+    }
+    bot.setBankroll(view.stack);
+    return bot.getAction(view.communityCards, view.potAmount, view.toCall, view.stack);
+}
+
+std::string BotAgent::getName() const {
+    return bot.getName();
+}
+
+void BotAgent::reseed(unsigned seed) {
+    bot.setSeed(seed);
+}
+
+ScriptedAgent::ScriptedAgent(const std::string& agentName, const std::vector<BotDecision>& actions)
+    : name(agentName), script(actions), nextIndex(0) {
+    if (script.empty()) {
+        script.push_back({ BotAction::CALL, 0, "" });
+    }
+}
+
+BotDecision ScriptedAgent::decide(const AgentView& view) {
+    BotDecision decision = script[nextIndex];
+    nextIndex = (nextIndex + 1) % script.size();
+    if (decision.action == BotAction::RAISE && decision.amount < view.minRaise) {
+        decision.amount = view.minRaise;
+    }
+    return decision;
+}
+
+std::string ScriptedAgent::getName() const {
+    return name;
+}
+
+void ScriptedAgent::reseed(unsigned) {
+    nextIndex = 0;
+}
+
+std::vector<BotDecision> ScriptedAgent::parseScript(const std::string& letters) {
+    std::vector<BotDecision> actions;
+    for (char letter : letters) {
+        switch (letter) {
+            case 'F': actions.push_back({ BotAction::FOLD, 0, "" }); break;
+            case 'K': actions.push_back({ BotAction::CHECK, 0, "" }); break;
+            case 'C': actions.push_back({ BotAction::CALL, 0, "" }); break;
+            case 'R': actions.push_back({ BotAction::RAISE, 0, "" }); break;
+            case 'A': actions.push_back({ BotAction::ALL_IN, 0, "" }); break;
+            default: break;
+        }
+    }
+    return actions;
+}
+
+PushFoldAgent::PushFoldAgent(const std::string& agentName, int scoreThreshold)
+    : name(agentName), threshold(scoreThreshold) {
+}
+
+BotDecision PushFoldAgent::decide(const AgentView& view) {
+    if (view.phase == GamePhase::PREFLOP && view.holeCards.size() >= 2) {
+        if (HandEvaluator::getPreflopScore(view.holeCards[0], view.holeCards[1]) >= threshold) {
+            return { BotAction::ALL_IN, view.stack, "" };
+        }
+        if (view.toCall > 0) {
+            return { BotAction::FOLD, 0, "" };
+        }
+    }
+    return { view.toCall > 0 ? BotAction::CALL : BotAction::CHECK, 0, "" };
+}
+
+std::string PushFoldAgent::getName() const {
+    return name;
+}
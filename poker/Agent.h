@@ -0,0 +1,85 @@
+#ifndef POKER_AGENT_H
+#define POKER_AGENT_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "BotPlayer.h"
+#include "GameBoard.h"
+#include "RulesEngine.h"
+
+// То, что видит агент в момент своего хода.
+struct AgentView {
+    const TableState* table;
+    int seat;
+    CardSpan holeCards;
+    CardSpan communityCards;
+    GamePhase phase;
+    int potAmount;
+    int toCall;
+    int minRaise;
+    int stack;
+};
+
+// Игрок без консоли: симулятор спрашивает решение через decide().
+// Для RAISE amount - размер повышения сверх текущей ставки.
+class Agent {
+public:
+    virtual ~Agent() = default;
+    virtual BotDecision decide(const AgentView& view) = 0;
+    virtual std::string getName() const = 0;
+    // Перезапуск с новым зерном: один агент переиспользуется для многих столов
+    virtual void reseed(unsigned) {}
+
+    // Решение агента в терминах движка правил (RAISE -> итоговая ставка).
+    static Action toAction(const BotDecision& decision, const TableState& state);
+    // Агент по описанию: bot, bot:<параметры BotConfig>, call, raise, allin,
+    // script:<FKCRA> или pushfold:<N>;
+    // nullptr, если описание не распознано.
+    static std::unique_ptr<Agent> create(const std::string& spec, const std::string& name, unsigned seed);
+    // Порог из описания pushfold:<N> или -1, если агент не пуш/фолд
+    static int getPushFoldThreshold(const std::string& spec);
+};
+
+// Агент на логике BotPlayer.
+class BotAgent : public Agent {
+private:
+    BotPlayer bot;
+
+public:
+    BotAgent(const std::string& name, unsigned seed, const BotConfig& config = BotConfig());
+    BotDecision decide(const AgentView& view) override;
+    std::string getName() const override;
+    void reseed(unsigned seed) override;
+};
+
+// Агент, повторяющий заданную последовательность действий по кругу.
+class ScriptedAgent : public Agent {
+private:
+    std::string name;
+    std::vector<BotDecision> script;
+    size_t nextIndex;
+
+public:
+    ScriptedAgent(const std::string& agentName, const std::vector<BotDecision>& actions);
+    BotDecision decide(const AgentView& view) override;
+    std::string getName() const override;
+    void reseed(unsigned seed) override;
+
+    // Сценарий из строки: F - сброс, K - чек, C - колл, R - рейз (минимальный), A - ва-банк.
+    static std::vector<BotDecision> parseScript(const std::string& letters);
+};
+
+// Пуш/фолд: на префлопе ва-банк (или колл ва-банка) с рукой не слабее порога по Чену.
+class PushFoldAgent : public Agent {
+private:
+    std::string name;
+    int threshold;
+
+public:
+    PushFoldAgent(const std::string& agentName, int scoreThreshold);
+    BotDecision decide(const AgentView& view) override;
+    std::string getName() const override;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#include "Arena.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "Equity.h"
+#include "Simulator.h"
+#include "TableRunner.h"
+
+Arena::Arena(Agent& first, Agent& second, const ArenaConfig& arenaConfig)
+    : agents{ &first, &second }, config(arenaConfig), equityRng(arenaConfig.seed), allInAdjusted(0) {
+    config.checkInterval = std::max(1LL, config.checkInterval);
+}
+
+double Arena::getAllInEquity(const TableState& state, int boardCount, std::mt19937& rng,
+                             const MonteCarloConfig& config) {
+    CardMask hole0 = (CardMask(1) << state.holeCards[0][0]) | (CardMask(1) << state.holeCards[0][1]);
+    CardMask hole1 = (CardMask(1) << state.holeCards[1][0]) | (CardMask(1) << state.holeCards[1][1]);
+    CardMask board = 0;
+    for (int i = 0; i < boardCount; i++) {
+        board |= CardMask(1) << state.board[i];
+    }
+    return Equity::headsUp(hole0, hole1, board, rng, config).mean;
+}
+
+double Arena::playHand(int firstSeat, int button, unsigned dealSeed) {
+    TableState state;
+    state.seatCount = 2;
+    state.smallBlind = config.smallBlind;
+    state.bigBlind = config.bigBlind;
+    state.stacks[0] = config.stack;
+    state.stacks[1] = config.stack;
+
+    // Агенты получают одни и те же зёрна в обеих половинах дубликата
+    agents[0]->reseed(dealSeed * 2 + 1);
+    agents[1]->reseed(dealSeed * 2 + 2);
+    Agent* seatAgents[2] = { agents[firstSeat], agents[1 - firstSeat] };
+
+    std::mt19937 dealRng(dealSeed);
+    int closedBoardCount = 0;
+    playTableHand(state, button, seatAgents, deck, dealRng, &closedBoardCount);
+
+    double net = state.stacks[firstSeat] - config.stack;
+    bool allInShowdown = state.phase == GamePhase::SHOWDOWN && closedBoardCount < 5 &&
+                         RulesEngine::countSeats(state.activeMask) == 2;
+    if (config.allInAdjustment && allInShowdown) {
+        double equity = getAllInEquity(state, closedBoardCount, equityRng, config.equity);
+        if (firstSeat == 1) {
+            equity = 1.0 - equity;
+        }
+        // Неуравненный излишек возвращается, разыгрывается только общая часть
+        int matched = std::min(state.committed[0], state.committed[1]);
+        net = (2.0 * equity - 1.0) * matched;
+        allInAdjusted++;
+    }
+    return net;
+}
+
+ArenaResult Arena::run() {
+    ArenaResult result;
+    RunningStats stats;
+    allInAdjusted = 0;
+    double toMb = 1000.0 / config.bigBlind;
+
+    auto start = std::chrono::steady_clock::now();
+    for (long long deal = 0; deal < config.maxDeals; deal++) {
+        unsigned dealSeed = TableRunner::getTableSeed(config.seed, static_cast<int>(deal));
+        int button = static_cast<int>(deal % 2);
+        double value;
+        if (config.duplicate) {
+            value = (playHand(0, button, dealSeed) + playHand(1, button, dealSeed)) / 2.0;
+            result.hands += 2;
+        } else {
+            value = playHand(static_cast<int>((deal / 2) % 2), button, dealSeed);
+            result.hands++;
+        }
+        stats.add(value * toMb);
+
+        long long deals = deal + 1;
+        if (deals >= config.minDeals && deals % config.checkInterval == 0) {
+            double halfWidth = stats.getHalfWidth(config.z);
+            if (std::fabs(stats.getMean()) > halfWidth) {
+                result.significant = true;
+                result.stopReason = "различие значимо";
+                break;
+            }
+            if (config.targetHalfWidth > 0.0 && halfWidth <= config.targetHalfWidth) {
+                result.stopReason = "достигнута заданная точность";
+                break;
+            }
+        }
+    }
+    if (!*result.stopReason) {
+        result.stopReason = "исчерпан лимит раздач";
+        result.significant = std::fabs(stats.getMean()) > stats.getHalfWidth(config.z);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    result.deals = stats.getCount();
+    result.allInAdjusted = allInAdjusted;
+    result.mbPerHand = stats.getMean();
+    result.halfWidth = stats.getHalfWidth(config.z);
+    result.standardDeviation = stats.getStandardDeviation();
+    result.seconds = elapsed.count();
+    return result;
+}
@@ -0,0 +1,66 @@
+#ifndef POKER_ARENA_H
+#define POKER_ARENA_H
+
+#include <random>
+#include "Agent.h"
+#include "Deck.h"
+#include "MonteCarlo.h"
+#include "RulesEngine.h"
+#include "Statistics.h"
+
+struct ArenaConfig {
+    long long minDeals = 2000;
+    long long maxDeals = 1000000;
+    long long checkInterval = 1000;  // как часто проверять условие остановки
+    double z = 3.0;                  // строже 1.96: условие проверяется многократно
+    double targetHalfWidth = 0.0;    // mb/hand; 0 - останавливаться только по значимости
+    bool duplicate = true;
+    bool allInAdjustment = true;
+    MonteCarloConfig equity = { 0.02, 1.96, 200, 5000, 100, SamplingMethod::QUASI_RANDOM };  // досдачи для ва-банка до флопа
+    int stack = 1000;
+    int smallBlind = 5;
+    int bigBlind = 10;
+    unsigned seed = 1;
+};
+
+struct ArenaResult {
+    long long deals = 0;
+    long long hands = 0;
+    long long allInAdjusted = 0;
+    double mbPerHand = 0.0;          // результат первого агента, тысячные большого блайнда
+    double halfWidth = 0.0;
+    double standardDeviation = 0.0;  // разброс одной раздачи, mb/hand
+    bool significant = false;
+    const char* stopReason = "";
+    double seconds = 0.0;
+};
+
+// Сравнение двух агентов хедз-ап с уменьшением дисперсии:
+//  - дубликатная сдача: каждая колода играется дважды, агенты меняются местами
+//    и получают карты друг друга, так что везение в картах взаимно гасится;
+//  - поправка на ва-банк: если торговля закончилась ва-банком до ривера,
+//    вместо фактического исхода засчитывается ожидание по эквити.
+// Раздачи идут, пока доверительный интервал не отделится от нуля, не станет
+// уже заданной точности или не кончится бюджет.
+class Arena {
+private:
+    Agent* agents[2];
+    ArenaConfig config;
+    Deck deck;
+    std::mt19937 equityRng;
+    long long allInAdjusted;
+
+    // Результат первого агента в фишках, если он сидит на месте firstSeat
+    double playHand(int firstSeat, int button, unsigned dealSeed);
+
+public:
+    Arena(Agent& first, Agent& second, const ArenaConfig& arenaConfig);
+
+    ArenaResult run();
+
+    // Доля банка места 0 при открытых boardCount картах борда в хедз-апе
+    static double getAllInEquity(const TableState& state, int boardCount, std::mt19937& rng,
+                                 const MonteCarloConfig& config);
+};
+
+#endif
@@ -3,25 +3,33 @@
 #include <algorithm>
 #include <iomanip>
 
-Bank::Bank() {
+Bank::Bank() : Bank(std::pmr::get_default_resource()) {
+}
+
+Bank::Bank(std::pmr::memory_resource* resource)
+    : betHistory(resource), seatHistory(MAX_SEATS, resource), roundTotals(resource) {
     potAmount = 0;
-    sidePotAmount = 0;
     currentRound = 0;
     maxBet = 0;
+    seatCount = 0;
+    seatedMask = 0;
+    activeMask = 0;
+    allInMask = 0;
+    calledMask = 0;
+    auditMode = false;
     betHistory.clear();
-    playerBets.clear();
-    playerSidePots.clear();
-    activePlayers.clear();
+    for (int seat = 0; seat < MAX_SEATS; seat++) {
+        playerBets[seat] = 0;
+        contributions[seat] = 0;
+        playerTotals[seat] = 0;
+        seatPlayers[seat] = INVALID_PLAYER_ID;
+    }
 }
 
 void Bank::addToPot(int amount) {
     potAmount += amount;
 }
 
-void Bank::addToSidePot(int amount) {
-    sidePotAmount += amount;
-}
-
 void Bank::setPotAmount(int amount) {
     potAmount = amount;
 }
@@ -30,67 +38,78 @@ int Bank::getPotAmount() const {
     return potAmount;
 }
 
-int Bank::getSidePotAmount() const {
-    return sidePotAmount;
-}
-
 void Bank::resetPot() {
     potAmount = 0;
+    allInMask = 0;
+    for (int seat = 0; seat < MAX_SEATS; seat++) {
+        contributions[seat] = 0;
+    }
 }
 
-void Bank::resetSidePot() {
-    sidePotAmount = 0;
-}
+void Bank::placeBet(int seat, int amount, bool isAllIn) {
+    if (seat < 0 || seat >= seatCount || !(seatedMask & (1u << seat))) {
+        std::cout << "Ошибка: Место " << seat << " не занято" << std::endl;
+        return;
+    }
 
-void Bank::placeBet(const std::string& playerName, int amount, bool isAllIn) {
-    BetInfo bet;
-    bet.amount = amount;
-    bet.round = currentRound;
-    bet.playerName = playerName;
-    bet.isAllIn = isAllIn;
-    bet.isFold = false;
-    
-    betHistory.push_back(bet);
-    playerBets[playerName] = amount;
-    
-    if (amount > maxBet) {
-        maxBet = amount;
+    if (auditMode) {
+        recordBet(seat, amount, isAllIn, false);
+    }
+
+    if (roundTotals.size() <= static_cast<size_t>(currentRound)) {
+        roundTotals.resize(currentRound + 1, std::array<int32_t, MAX_SEATS>{});
+    }
+    roundTotals[currentRound][seat] += amount;
+    playerTotals[seat] += amount;
+
+    uint16_t seatBit = static_cast<uint16_t>(1u << seat);
+    playerBets[seat] += amount;
+    contributions[seat] += amount;
+    if (isAllIn) {
+        allInMask |= seatBit;
+    }
+    if (playerBets[seat] > maxBet) {
+        maxBet = playerBets[seat];
+        calledMask = seatBit;
+    } else if (playerBets[seat] == maxBet) {
+        calledMask |= seatBit;
     }
-    
+
     addToPot(amount);
 }
 
-void Bank::foldPlayer(const std::string& playerName) {
+void Bank::foldPlayer(int seat) {
+    if (seat < 0 || seat >= seatCount) return;
+
+    if (auditMode) {
+        recordBet(seat, 0, false, true);
+    }
+
+    activeMask &= ~(1u << seat);
+}
+
+void Bank::recordBet(int seat, int amount, bool isAllIn, bool isFold) {
     BetInfo bet;
-    bet.amount = 0;
+    bet.amount = amount;
     bet.round = currentRound;
-    bet.playerName = playerName;
-    bet.isAllIn = false;
-    bet.isFold = true;
-    
+    bet.seat = static_cast<int8_t>(seat);
+    bet.isAllIn = isAllIn;
+    bet.isFold = isFold;
+    seatHistory[seat].push_back(static_cast<uint32_t>(betHistory.size()));
     betHistory.push_back(bet);
-    
-    // Remove from active players
-    auto it = std::find(activePlayers.begin(), activePlayers.end(), playerName);
-    if (it != activePlayers.end()) {
-        activePlayers.erase(it);
-    }
 }
 
-void Bank::callBet(const std::string& playerName, int callAmount) {
-    placeBet(playerName, callAmount);
+void Bank::callBet(int seat, int callAmount) {
+    placeBet(seat, callAmount);
 }
 
-void Bank::raiseBet(const std::string& playerName, int raiseAmount) {
-    placeBet(playerName, raiseAmount);
+void Bank::raiseBet(int seat, int raiseAmount) {
+    placeBet(seat, raiseAmount);
 }
 
-int Bank::getPlayerBet(const std::string& playerName) const {
-    auto it = playerBets.find(playerName);
-    if (it != playerBets.end()) {
-        return it->second;
-    }
-    return 0;
+int Bank::getPlayerBet(int seat) const {
+    if (seat < 0 || seat >= MAX_SEATS) return 0;
+    return playerBets[seat];
 }
 
 int Bank::getMaxBet() const {
@@ -99,51 +118,152 @@ int Bank::getMaxBet() const {
 
 void Bank::setMaxBet(int bet) {
     maxBet = bet;
+    calledMask = 0;
+    for (int seat = 0; seat < seatCount; seat++) {
+        if (playerBets[seat] >= maxBet) {
+            calledMask |= 1u << seat;
+        }
+    }
+}
+
+void Bank::resetRoundBets() {
+    for (int seat = 0; seat < MAX_SEATS; seat++) {
+        playerBets[seat] = 0;
+    }
+    maxBet = 0;
+    calledMask = seatedMask;
+}
+
+void Bank::startNewHand() {
+    resetPot();
+    currentRound = 0;
+    roundTotals.clear();
+    activeMask = seatedMask;
+    resetRoundBets();
 }
 
 void Bank::startNewRound() {
     currentRound++;
-    maxBet = 0;
-    playerBets.clear();
+    resetRoundBets();
 }
 
 void Bank::endRound() {
     // Reset bets for next round
-    playerBets.clear();
-    maxBet = 0;
+    resetRoundBets();
 }
 
 int Bank::getCurrentRound() const {
     return currentRound;
 }
 
-void Bank::addPlayer(const std::string& playerName) {
-    activePlayers.push_back(playerName);
-    playerBets[playerName] = 0;
+int Bank::addPlayer(const std::string& playerName) {
+    return addPlayer(PlayerRegistry::getId(playerName));
+}
+
+int Bank::addPlayer(PlayerId playerId) {
+    for (int seat = 0; seat < MAX_SEATS; seat++) {
+        uint16_t seatBit = static_cast<uint16_t>(1u << seat);
+        if (seatedMask & seatBit) continue;
+        clearSeat(seat);
+        seatPlayers[seat] = playerId;
+        seatedMask |= seatBit;
+        activeMask |= seatBit;
+        if (maxBet == 0) {
+            calledMask |= seatBit;
+        }
+        seatCount = std::max(seatCount, seat + 1);
+        return seat;
+    }
+    std::cout << "Ошибка: За столом не больше " << MAX_SEATS << " мест" << std::endl;
+    return -1;
+}
+
+void Bank::removePlayer(int seat) {
+    if (seat < 0 || seat >= seatCount) return;
+    uint16_t seatBit = static_cast<uint16_t>(1u << seat);
+    seatedMask &= ~seatBit;
+    activeMask &= ~seatBit;
+    allInMask &= ~seatBit;
+    calledMask &= ~seatBit;
+    clearSeat(seat);
+    seatPlayers[seat] = INVALID_PLAYER_ID;
+    while (seatCount > 0 && !(seatedMask & (1u << (seatCount - 1)))) {
+        seatCount--;
+    }
 }
 
-void Bank::removePlayer(const std::string& playerName) {
-    auto it = std::find(activePlayers.begin(), activePlayers.end(), playerName);
-    if (it != activePlayers.end()) {
-        activePlayers.erase(it);
+void Bank::clearSeat(int seat) {
+    playerBets[seat] = 0;
+    contributions[seat] = 0;
+    playerTotals[seat] = 0;
+    for (auto& totals : roundTotals) {
+        totals[seat] = 0;
     }
-    playerBets.erase(playerName);
+    seatHistory[seat].clear();
 }
 
 void Bank::setActivePlayers(const std::vector<std::string>& players) {
-    activePlayers = players;
-    playerBets.clear();
-    for (const auto& player : players) {
-        playerBets[player] = 0;
+    if (players.size() > MAX_SEATS) {
+        std::cout << "Ошибка: За столом не больше " << MAX_SEATS << " мест" << std::endl;
+        return;
     }
+    seatCount = static_cast<int>(players.size());
+    seatedMask = static_cast<uint16_t>((1u << seatCount) - 1);
+    activeMask = seatedMask;
+    allInMask = 0;
+    for (int seat = 0; seat < MAX_SEATS; seat++) {
+        PlayerId playerId = seat < seatCount ? PlayerRegistry::getId(players[seat]) : INVALID_PLAYER_ID;
+        if (playerId != seatPlayers[seat]) {
+            clearSeat(seat);
+        }
+        seatPlayers[seat] = playerId;
+    }
+    resetRoundBets();
 }
 
 std::vector<std::string> Bank::getActivePlayers() const {
-    return activePlayers;
+    std::vector<std::string> players;
+    for (int seat = 0; seat < seatCount; seat++) {
+        if (activeMask & (1u << seat)) {
+            players.push_back(PlayerRegistry::getName(seatPlayers[seat]));
+        }
+    }
+    return players;
+}
+
+uint16_t Bank::getActiveMask() const {
+    return activeMask;
+}
+
+bool Bank::isPlayerActive(int seat) const {
+    return seat >= 0 && seat < MAX_SEATS && (activeMask & (1u << seat));
+}
+
+int Bank::getSeatCount() const {
+    return seatCount;
+}
+
+PlayerId Bank::getPlayerId(int seat) const {
+    if (seat < 0 || seat >= MAX_SEATS) return INVALID_PLAYER_ID;
+    return seatPlayers[seat];
+}
+
+const std::string& Bank::getPlayerName(int seat) const {
+    return PlayerRegistry::getName(getPlayerId(seat));
+}
+
+int Bank::getSeat(PlayerId playerId) const {
+    for (int seat = 0; seat < seatCount; seat++) {
+        if ((seatedMask & (1u << seat)) && seatPlayers[seat] == playerId) {
+            return seat;
+        }
+    }
+    return -1;
 }
 
-bool Bank::isPlayerActive(const std::string& playerName) const {
-    return std::find(activePlayers.begin(), activePlayers.end(), playerName) != activePlayers.end();
+int Bank::getSeat(const std::string& playerName) const {
+    PlayerId playerId = PlayerRegistry::findId(playerName);
+    return playerId == INVALID_PLAYER_ID ? -1 : getSeat(playerId);
 }
 
 void Bank::distributeWinnings(const std::vector<std::string>& winners, const std::vector<int>& amounts) {
@@ -151,76 +271,113 @@ void Bank::distributeWinnings(const std::vector<std::string>& winners, const std
         std::cout << "Ошибка: Количество победителей не соответствует количеству сумм" << std::endl;
         return;
     }
-    
+
     std::cout << "\n=== РАСПРЕДЕЛЕНИЕ ВЫИГРЫШЕЙ ===" << std::endl;
     for (size_t i = 0; i < winners.size(); i++) {
         std::cout << winners[i] << " выигрывает: $" << amounts[i] << std::endl;
     }
     std::cout << "=============================" << std::endl;
-    
-    resetPot();
+
+    startNewHand();
 }
 
-void Bank::distributeSidePot(const std::vector<std::string>& winners, const std::vector<int>& amounts) {
-    if (winners.size() != amounts.size()) {
-        std::cout << "Ошибка: Количество победителей не соответствует количеству сумм" << std::endl;
-        return;
+std::vector<int> Bank::distributePots(const std::vector<int>& scores, int button) {
+    std::vector<int> winnings(seatCount, 0);
+    if (scores.size() != static_cast<size_t>(seatCount)) {
+        std::cout << "Ошибка: Количество оценок рук не соответствует количеству мест" << std::endl;
+        return winnings;
     }
-    
-    std::cout << "\n=== РАСПРЕДЕЛЕНИЕ САЙД-ПОТА ===" << std::endl;
-    for (size_t i = 0; i < winners.size(); i++) {
-        std::cout << winners[i] << " выигрывает сайд-пот: $" << amounts[i] << std::endl;
+
+    std::vector<PotLayer> pots = getPots();
+    int seatScores[MAX_SEATS] = {};
+    for (int seat = 0; seat < seatCount; seat++) {
+        seatScores[seat] = scores[seat];
+    }
+    int32_t payouts[MAX_SEATS] = {};
+    SidePots::award(pots.data(), static_cast<int>(pots.size()), seatScores, seatCount, button, payouts);
+
+    std::cout << "\n=== РАСПРЕДЕЛЕНИЕ ВЫИГРЫШЕЙ ===" << std::endl;
+    for (int seat = 0; seat < seatCount; seat++) {
+        winnings[seat] = payouts[seat];
+        if (payouts[seat] > 0) {
+            std::cout << getPlayerName(seat) << " выигрывает: $" << payouts[seat] << std::endl;
+        }
     }
     std::cout << "=============================" << std::endl;
-    
-    resetSidePot();
+
+    startNewHand();
+    return winnings;
 }
 
-std::vector<BetInfo> Bank::getBetHistory() const {
+void Bank::setAuditMode(bool enabled) {
+    auditMode = enabled;
+    if (!auditMode) {
+        betHistory.clear();
+        betHistory.shrink_to_fit();
+        for (auto& indexes : seatHistory) {
+            indexes.clear();
+            indexes.shrink_to_fit();
+        }
+    }
+}
+
+bool Bank::isAuditMode() const {
+    return auditMode;
+}
+
+const std::pmr::vector<BetInfo>& Bank::getBetHistory() const {
     return betHistory;
 }
 
-std::vector<BetInfo> Bank::getPlayerBetHistory(const std::string& playerName) const {
+std::vector<BetInfo> Bank::getPlayerBetHistory(int seat) const {
     std::vector<BetInfo> playerHistory;
-    for (const auto& bet : betHistory) {
-        if (bet.playerName == playerName) {
-            playerHistory.push_back(bet);
-        }
+    if (seat < 0 || seat >= MAX_SEATS) return playerHistory;
+    playerHistory.reserve(seatHistory[seat].size());
+    for (uint32_t index : seatHistory[seat]) {
+        playerHistory.push_back(betHistory[index]);
     }
     return playerHistory;
 }
 
-int Bank::getTotalBetsByPlayer(const std::string& playerName) const {
-    int total = 0;
-    for (const auto& bet : betHistory) {
-        if (bet.playerName == playerName && !bet.isFold) {
-            total += bet.amount;
-        }
-    }
-    return total;
+int Bank::getTotalBetsByPlayer(int seat) const {
+    if (seat < 0 || seat >= MAX_SEATS) return 0;
+    return playerTotals[seat];
 }
 
-int Bank::getRoundBetsByPlayer(const std::string& playerName, int round) const {
-    int total = 0;
-    for (const auto& bet : betHistory) {
-        if (bet.playerName == playerName && bet.round == round && !bet.isFold) {
-            total += bet.amount;
-        }
+int Bank::getRoundBetsByPlayer(int seat, int round) const {
+    if (seat < 0 || seat >= MAX_SEATS || round < 0 || static_cast<size_t>(round) >= roundTotals.size()) {
+        return 0;
     }
-    return total;
+    return roundTotals[round][seat];
 }
 
 void Bank::displayPot() const {
-    std::cout << "Основной банк: $" << potAmount << std::endl;
-    if (sidePotAmount > 0) {
-        std::cout << "Сайд-пот: $" << sidePotAmount << std::endl;
+    std::vector<PotLayer> pots = getPots();
+    if (pots.size() <= 1) {
+        std::cout << "Основной банк: $" << potAmount << std::endl;
+        return;
+    }
+    std::cout << "Основной банк: $" << pots[0].amount << std::endl;
+    for (size_t i = 1; i < pots.size(); i++) {
+        std::cout << "Сайд-пот " << i << ": $" << pots[i].amount << " (";
+        bool first = true;
+        for (int seat = 0; seat < seatCount; seat++) {
+            if (pots[i].eligible & (1u << seat)) {
+                std::cout << (first ? "" : ", ") << getPlayerName(seat);
+                first = false;
+            }
+        }
+        std::cout << ")" << std::endl;
     }
 }
 
 void Bank::displayBetHistory() const {
     std::cout << "\n=== ИСТОРИЯ СТАВОК ===" << std::endl;
+    if (!auditMode) {
+        std::cout << "История не ведётся: включите режим аудита" << std::endl;
+    }
     for (const auto& bet : betHistory) {
-        std::cout << "Раунд " << bet.round << ": " << bet.playerName;
+        std::cout << "Раунд " << bet.round << ": " << getPlayerName(bet.seat);
         if (bet.isFold) {
             std::cout << " сбросил карты";
         } else {
@@ -236,43 +393,30 @@ void Bank::displayBetHistory() const {
 
 void Bank::displayPlayerBets() const {
     std::cout << "\n=== ТЕКУЩИЕ СТАВКИ ===" << std::endl;
-    for (const auto& player : activePlayers) {
-        auto it = playerBets.find(player);
-        if (it != playerBets.end()) {
-            std::cout << player << ": $" << it->second << std::endl;
+    for (int seat = 0; seat < seatCount; seat++) {
+        if (activeMask & (1u << seat)) {
+            std::cout << getPlayerName(seat) << ": $" << playerBets[seat] << std::endl;
         }
     }
     std::cout << "===================" << std::endl;
 }
 
 bool Bank::allPlayersCalled() const {
-    if (activePlayers.empty()) return true;
-    
-    for (const auto& player : activePlayers) {
-        auto it = playerBets.find(player);
-        if (it == playerBets.end() || it->second < maxBet) {
-            return false;
-        }
-    }
-    return true;
+    // Игроки ва-банк уравнивать не обязаны
+    return (activeMask & ~allInMask & ~calledMask) == 0;
 }
 
 void Bank::resetAllBets() {
-    playerBets.clear();
-    maxBet = 0;
+    resetRoundBets();
 }
 
-void Bank::createSidePot(const std::string& allInPlayer, int allInAmount) {
-    // Move excess bets to side pot
-    for (auto& player : playerBets) {
-        if (player.first != allInPlayer && player.second > allInAmount) {
-            int excess = player.second - allInAmount;
-            addToSidePot(excess);
-            player.second = allInAmount;
-        }
-    }
+std::vector<PotLayer> Bank::getPots() const {
+    PotLayer layers[MAX_SEATS];
+    int count = SidePots::build(contributions, seatCount, activeMask, layers);
+    return std::vector<PotLayer>(layers, layers + count);
 }
 
-std::map<std::string, int> Bank::getSidePotDistribution() const {
-    return playerSidePots;
+int Bank::getPlayerContribution(int seat) const {
+    if (seat < 0 || seat >= MAX_SEATS) return 0;
+    return contributions[seat];
 }
@@ -1,74 +1,114 @@
 #ifndef POKER_BANK_H
 #define POKER_BANK_H
 
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
 #include <vector>
-#include <map>
 #include "Player.h"
+#include "SidePots.h"
+#include "PlayerRegistry.h"
 
 struct BetInfo {
     int amount;
     int round;
-    std::string playerName;
+    int8_t seat;
     bool isAllIn;
     bool isFold;
 };
 
+// Банк стола с индексацией по местам: ставки в массивах, состояние мест - битовые маски.
+// Игроки мест - ID из PlayerRegistry, имена нужны только для вывода.
 class Bank {
 private:
     int potAmount;
-    int sidePotAmount;
-    std::vector<BetInfo> betHistory;
-    std::map<std::string, int> playerBets;
-    std::map<std::string, int> playerSidePots;
+    std::pmr::vector<BetInfo> betHistory;    // только в режиме аудита
+    std::pmr::vector<std::pmr::vector<uint32_t>> seatHistory;  // индексы записей betHistory по местам
+    bool auditMode;
+    int32_t playerTotals[MAX_SEATS];    // сумма ставок места за всё время
+    std::pmr::vector<std::array<int32_t, MAX_SEATS>> roundTotals;  // [раунд раздачи][место]
+    int32_t playerBets[MAX_SEATS];      // ставки на текущей улице
+    int32_t contributions[MAX_SEATS];   // всё, что внесено за раздачу
+    PlayerId seatPlayers[MAX_SEATS];
+    int seatCount;                      // места 0..seatCount-1, часть может пустовать
+    uint16_t seatedMask;
+    uint16_t activeMask;                // не сбросившие карты
+    uint16_t allInMask;
+    uint16_t calledMask;                // ставка на улице не меньше maxBet
     int currentRound;
     int maxBet;
-    std::vector<std::string> activePlayers;
+
+    void resetRoundBets();
+    // Ставки, итоги и история места - следующий игрок на месте их не наследует
+    void clearSeat(int seat);
+    void recordBet(int seat, int amount, bool isAllIn, bool isFold);
 
 public:
     Bank();
-    
+    // Динамическая память банка (история, итоги по раундам) берётся из resource,
+    // например из HandArena раздачи; resource должен пережить банк.
+    explicit Bank(std::pmr::memory_resource* resource);
+
     void addToPot(int amount);
-    void addToSidePot(int amount);
     void setPotAmount(int amount);
     int getPotAmount() const;
-    int getSidePotAmount() const;
     void resetPot();
-    void resetSidePot();
-    
-    void placeBet(const std::string& playerName, int amount, bool isAllIn = false);
-    void foldPlayer(const std::string& playerName);
-    void callBet(const std::string& playerName, int callAmount);
-    void raiseBet(const std::string& playerName, int raiseAmount);
-    int getPlayerBet(const std::string& playerName) const;
+
+    // amount - фишки, добавленные к ставке места на этой улице
+    void placeBet(int seat, int amount, bool isAllIn = false);
+    void foldPlayer(int seat);
+    void callBet(int seat, int callAmount);
+    void raiseBet(int seat, int raiseAmount);
+    int getPlayerBet(int seat) const;
     int getMaxBet() const;
     void setMaxBet(int bet);
-    
+
+    // Новая раздача: банк, взносы, счётчик улиц и итоги по раундам начинаются заново
+    void startNewHand();
     void startNewRound();
     void endRound();
     int getCurrentRound() const;
-    
-    void addPlayer(const std::string& playerName);
-    void removePlayer(const std::string& playerName);
+
+    // Сажает игрока на первое свободное место; -1, если стол заполнен
+    int addPlayer(const std::string& playerName);
+    int addPlayer(PlayerId playerId);
+    // Итоги и история места очищаются: следующий игрок на месте их не наследует
+    void removePlayer(int seat);
+    // Игроки занимают места 0..n-1 по порядку; место, сменившее игрока, очищается
     void setActivePlayers(const std::vector<std::string>& players);
     std::vector<std::string> getActivePlayers() const;
-    bool isPlayerActive(const std::string& playerName) const;
-    
+    uint16_t getActiveMask() const;
+    bool isPlayerActive(int seat) const;
+    int getSeatCount() const;
+    PlayerId getPlayerId(int seat) const;
+    const std::string& getPlayerName(int seat) const;
+    // Место игрока; -1, если игрока нет за столом
+    int getSeat(PlayerId playerId) const;
+    int getSeat(const std::string& playerName) const;
+
     void distributeWinnings(const std::vector<std::string>& winners, const std::vector<int>& amounts);
-    void distributeSidePot(const std::vector<std::string>& winners, const std::vector<int>& amounts);
-    
-    std::vector<BetInfo> getBetHistory() const;
-    std::vector<BetInfo> getPlayerBetHistory(const std::string& playerName) const;
-    int getTotalBetsByPlayer(const std::string& playerName) const;
-    int getRoundBetsByPlayer(const std::string& playerName, int round) const;
-    
+    // Делит основной банк и сайд-поты по силе рук (индекс - место, больше - сильнее).
+    // Возвращает выигрыш каждого места; выплата закрывает раздачу (startNewHand).
+    std::vector<int> distributePots(const std::vector<int>& scores, int button);
+
+    // Полная история ставок ведётся только в режиме аудита; итоги - всегда
+    void setAuditMode(bool enabled);
+    bool isAuditMode() const;
+    const std::pmr::vector<BetInfo>& getBetHistory() const;
+    std::vector<BetInfo> getPlayerBetHistory(int seat) const;
+    int getTotalBetsByPlayer(int seat) const;
+    int getRoundBetsByPlayer(int seat, int round) const;
+
     void displayPot() const;
     void displayBetHistory() const;
     void displayPlayerBets() const;
     bool allPlayersCalled() const;
     void resetAllBets();
-    
-    void createSidePot(const std::string& allInPlayer, int allInAmount);
-    std::map<std::string, int> getSidePotDistribution() const;
+
+    // Основной банк и сайд-поты по взносам игроков за раздачу
+    std::vector<PotLayer> getPots() const;
+    int getPlayerContribution(int seat) const;
 };
 
 #endif
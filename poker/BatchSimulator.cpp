@@ -0,0 +1,176 @@
+#include "BatchSimulator.h"
+#include <algorithm>
+#include <chrono>
+
+BatchSimulator::BatchSimulator(const BatchConfig& batchConfig, unsigned seed)
+    : config(batchConfig), rng(seed), rounds(0) {
+    size_t count = static_cast<size_t>(std::max(1, config.tables));
+    config.tables = static_cast<int>(count);
+    for (int seat = 0; seat < 2; seat++) {
+        stacks[seat].assign(count, 0);
+        bets[seat].assign(count, 0);
+        strength[seat].assign(count, 0);
+        holeMasks[seat].assign(count, 0);
+        net[seat].assign(count, 0);
+    }
+    for (auto& street : streetMasks) {
+        street.assign(count, 0);
+    }
+    pots.assign(count, 0);
+    phases.assign(count, GamePhase::PREFLOP);
+    contested.assign(count, 0);
+    boardMasks.assign(count, 0);
+}
+
+const SimulationStats& BatchSimulator::run(long long roundCount) {
+    auto start = std::chrono::steady_clock::now();
+    for (long long round = 0; round < roundCount; round++) {
+        deal();
+        playPreflop(static_cast<int>(rounds % 2));
+        dealStreet(0, GamePhase::FLOP);
+        dealStreet(1, GamePhase::TURN);
+        dealStreet(2, GamePhase::RIVER);
+        showdown();
+        accumulate();
+        rounds++;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    stats.seconds += elapsed.count();
+    return stats;
+}
+
+const SimulationStats& BatchSimulator::getStats() const {
+    return stats;
+}
+
+void BatchSimulator::deal() {
+    // Девять разных карт на стол: 2+2 карманные и 5 на борд. Выборка с отказом
+    // по битовой маске дешевле тасования всей колоды.
+    static const int STREET_SIZES[3] = { 3, 1, 1 };
+    for (int table = 0; table < config.tables; table++) {
+        CardMask used = 0;
+        auto draw = [&]() {
+            while (true) {
+                int code = static_cast<int>(rng() % Card::DECK_SIZE);
+                CardMask bit = CardMask(1) << code;
+                if (!(used & bit)) {
+                    used |= bit;
+                    return code;
+                }
+            }
+        };
+        for (int seat = 0; seat < 2; seat++) {
+            int first = draw();
+            int second = draw();
+            holeMasks[seat][table] = (CardMask(1) << first) | (CardMask(1) << second);
+            strength[seat][table] = static_cast<int8_t>(
+                HandEvaluator::getPreflopScore(Card::fromCode(first), Card::fromCode(second)));
+        }
+        for (int street = 0; street < 3; street++) {
+            CardMask mask = 0;
+            for (int i = 0; i < STREET_SIZES[street]; i++) {
+                mask |= CardMask(1) << draw();
+            }
+            streetMasks[street][table] = mask;
+        }
+    }
+}
+
+void BatchSimulator::playPreflop(int button) {
+    // Кнопка ставит малый блайнд и решает первой: пуш или фолд. Большой блайнд
+    // отвечает на пуш коллом или фолдом. Всё считается без ветвлений по столам.
+    int other = 1 - button;
+    int threshold0 = config.thresholds[button];
+    int threshold1 = config.thresholds[other];
+    const int32_t stack = config.stack;
+    const int32_t smallBlind = std::min(config.smallBlind, stack);
+    const int32_t bigBlind = std::min(config.bigBlind, stack);
+
+    int32_t* buttonBets = bets[button].data();
+    int32_t* otherBets = bets[other].data();
+    int32_t* buttonNet = net[button].data();
+    int32_t* otherNet = net[other].data();
+    const int8_t* buttonStrength = strength[button].data();
+    const int8_t* otherStrength = strength[other].data();
+    int32_t* pot = pots.data();
+    uint8_t* live = contested.data();
+    int32_t* buttonStack = stacks[button].data();
+    int32_t* otherStack = stacks[other].data();
+
+    for (int table = 0; table < config.tables; table++) {
+        bool push = buttonStrength[table] >= threshold0;
+        bool call = otherStrength[table] >= threshold1;
+        bool allIn = push && call;
+
+        buttonBets[table] = allIn ? stack : (push ? bigBlind : smallBlind);
+        otherBets[table] = allIn ? stack : bigBlind;
+        buttonStack[table] = stack - buttonBets[table];
+        otherStack[table] = stack - otherBets[table];
+        pot[table] = buttonBets[table] + otherBets[table];
+        live[table] = allIn ? 1 : 0;
+
+        // Без колла банк забирает тот, кто остался; лишнее сверх уравненного возвращается
+        int32_t foldSwing = push ? bigBlind : -smallBlind;
+        buttonNet[table] = allIn ? 0 : foldSwing;
+        otherNet[table] = allIn ? 0 : -foldSwing;
+    }
+
+    for (int table = 0; table < config.tables; table++) {
+        phases[table] = GamePhase::PREFLOP;
+        boardMasks[table] = 0;
+    }
+}
+
+void BatchSimulator::dealStreet(int street, GamePhase phase) {
+    const CardMask* streetCards = streetMasks[street].data();
+    const uint8_t* live = contested.data();
+    CardMask* board = boardMasks.data();
+    GamePhase* tablePhases = phases.data();
+    for (int table = 0; table < config.tables; table++) {
+        CardMask keep = CardMask(0) - live[table];
+        board[table] |= streetCards[table] & keep;
+        tablePhases[table] = live[table] ? phase : tablePhases[table];
+    }
+}
+
+void BatchSimulator::showdown() {
+    const uint8_t* live = contested.data();
+    const CardMask* board = boardMasks.data();
+    const CardMask* hole0 = holeMasks[0].data();
+    const CardMask* hole1 = holeMasks[1].data();
+    int32_t* net0 = net[0].data();
+    int32_t* net1 = net[1].data();
+    const int32_t stack = config.stack;
+
+    for (int table = 0; table < config.tables; table++) {
+        if (!live[table]) continue;
+        int score0 = HandEvaluator::evaluateMask(hole0[table] | board[table]);
+        int score1 = HandEvaluator::evaluateMask(hole1[table] | board[table]);
+        int sign = (score0 > score1) - (score0 < score1);
+        net0[table] = sign * stack;
+        net1[table] = -sign * stack;
+        phases[table] = GamePhase::SHOWDOWN;
+    }
+}
+
+void BatchSimulator::accumulate() {
+    long long showdowns = 0, ties = 0, wins0 = 0, wins1 = 0, sum0 = 0, sum1 = 0;
+    const uint8_t* live = contested.data();
+    const int32_t* net0 = net[0].data();
+    const int32_t* net1 = net[1].data();
+    for (int table = 0; table < config.tables; table++) {
+        showdowns += live[table];
+        wins0 += net0[table] > 0;
+        wins1 += net0[table] < 0;
+        ties += net0[table] == 0;
+        sum0 += net0[table];
+        sum1 += net1[table];
+    }
+    stats.hands += config.tables;
+    stats.showdowns += showdowns;
+    stats.ties += ties;
+    stats.wins[0] += wins0;
+    stats.wins[1] += wins1;
+    stats.netChips[0] += sum0;
+    stats.netChips[1] += sum1;
+}
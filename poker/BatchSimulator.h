@@ -0,0 +1,57 @@
+#ifndef POKER_BATCHSIMULATOR_H
+#define POKER_BATCHSIMULATOR_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "GameBoard.h"
+#include "HandEvaluator.h"
+#include "Simulator.h"
+
+struct BatchConfig {
+    int tables = 4096;
+    int stack = 1000;
+    int smallBlind = 5;
+    int bigBlind = 10;
+    // Порог силы руки по Чену для пуша/колла ва-банка, по местам
+    int thresholds[2] = { 8, 8 };
+};
+
+// Пакетный режим: N хедз-ап столов пуш/фолд хранятся параллельными массивами
+// (структура массивов), каждая стадия раздачи - один плоский цикл по всем
+// столам без ветвлений по объектам. Раздача на столе i эквивалентна игре двух
+// PushFoldAgent в Simulator с теми же порогами.
+class BatchSimulator {
+private:
+    BatchConfig config;
+    std::mt19937_64 rng;
+    SimulationStats stats;
+    long long rounds;
+
+    // Состояние столов, индекс - номер стола
+    std::vector<int32_t> stacks[2];
+    std::vector<int32_t> bets[2];
+    std::vector<int32_t> pots;
+    std::vector<GamePhase> phases;
+    std::vector<uint8_t> contested;     // оба игрока в ва-банке
+    std::vector<int8_t> strength[2];    // сила стартовой руки
+    std::vector<CardMask> holeMasks[2];
+    std::vector<CardMask> streetMasks[3];  // флоп, тёрн, ривер, сданные заранее
+    std::vector<CardMask> boardMasks;
+    std::vector<int32_t> net[2];
+
+    void deal();
+    void playPreflop(int button);
+    void dealStreet(int street, GamePhase phase);
+    void showdown();
+    void accumulate();
+
+public:
+    BatchSimulator(const BatchConfig& batchConfig, unsigned seed);
+
+    // Каждый раунд играет по одной раздаче на всех столах
+    const SimulationStats& run(long long roundCount);
+    const SimulationStats& getStats() const;
+};
+
+#endif
@@ -1,62 +1,504 @@
 #include "BetHistory.h"
+#include "BetSegment.h"
+#include "CsvIngest.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <limits>
 #include <map>
 #include <sstream>
+#include <filesystem>
 
-BetHistory::BetHistory() : filename("bet_history.txt"), autoSave(false) {
-    history.clear();
+namespace {
+
+const std::string STANDARD_NOTES[] = {
+    "",
+    "Player folded",
+    "Player checked",
+    "Player called",
+    "Player raised",
+    "Player went all-in",
+    "Small blind",
+    "Big blind"
+};
+
+const char CSV_HEADER[] = "Player,Action,Amount,Round,Timestamp,Notes";
+// Необязательная первая строка снимка CSV: поколение журнала, уже вошедшее в снимок
+const char CSV_CHECKPOINT[] = "# wal ";
+
+const char* const ACTION_NAMES[] = {
+    "FOLD", "CHECK", "CALL", "RAISE", "ALL_IN", "SMALL_BLIND", "BIG_BLIND"
+};
+
+bool parseAction(std::string_view text, BetAction& action) {
+    for (size_t i = 0; i < sizeof(ACTION_NAMES) / sizeof(ACTION_NAMES[0]); i++) {
+        if (text == ACTION_NAMES[i]) {
+            action = static_cast<BetAction>(i);
+            return true;
+        }
+    }
+    return false;
 }
 
-BetHistory::BetHistory(const std::string& file) : filename(file), autoSave(false) {
-    history.clear();
+// Разобранный кусок CSV: строки ссылаются на имена и заметки куска по номеру,
+// строки текста остаются в окне чтения до слияния
+struct CsvBetRow {
+    uint32_t player;
+    uint32_t note;
+    BetAction action;
+    int32_t amount;
+    int32_t round;
+    int64_t timeMs;
+};
+
+struct CsvBetChunk {
+    std::vector<CsvBetRow> rows;
+    std::vector<std::string_view> names;
+    std::vector<std::string_view> noteTexts;
+    std::unordered_map<std::string_view, uint32_t> nameIndex;
+    std::unordered_map<std::string_view, uint32_t> noteIndex;
+    std::vector<uint32_t> commas;
+    std::vector<PlayerId> playerIds;
+    std::vector<uint16_t> noteCodes;
+    TimestampParser timestamps;
+
+    void clear() {
+        rows.clear();
+        names.clear();
+        noteTexts.clear();
+        nameIndex.clear();
+        noteIndex.clear();
+    }
+};
+
+uint32_t indexOf(std::unordered_map<std::string_view, uint32_t>& index, std::vector<std::string_view>& values,
+                 std::string_view value) {
+    auto inserted = index.emplace(value, static_cast<uint32_t>(values.size()));
+    if (inserted.second) {
+        values.push_back(value);
+    }
+    return inserted.first->second;
 }
 
-void BetHistory::addBet(const std::string& playerName, BetAction action, int amount, int round, const std::string& notes) {
-    BetRecord record(playerName, action, amount, round, notes);
-    history.push_back(record);
+bool parseCheckpoint(std::string_view line, uint32_t& checkpoint) {
+    const size_t prefix = sizeof(CSV_CHECKPOINT) - 1;
+    if (line.compare(0, prefix, CSV_CHECKPOINT) != 0) return false;
+    std::string_view value = line.substr(prefix);
+    if (!value.empty() && value.back() == '\r') value.remove_suffix(1);
+    return CsvIngest::parseNumber(value, checkpoint);
+}
+
+// Поколение журнала, записанное в снимке, без чтения самих записей
+uint32_t readCheckpoint(const std::string& file) {
+    if (BetSegment::isSegmentFile(file)) {
+        BetSegmentReader reader;
+        return reader.open(file) ? reader.getCheckpoint() : 0;
+    }
+    std::ifstream inFile(file, std::ios::binary);
+    std::string line;
+    uint32_t checkpoint = 0;
+    if (std::getline(inFile, line) && parseCheckpoint(line, checkpoint)) {
+        return checkpoint;
+    }
+    return 0;
+}
+
+// Поле строки журнала: переводы строк рвут строку, табуляция - поля (кроме последнего)
+void appendLogField(std::string& line, std::string_view text, bool lastField) {
+    for (char c : text) {
+        line += (c == '\n' || c == '\r' || (c == '\t' && !lastField)) ? ' ' : c;
+    }
+}
+
+int64_t getNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+constexpr int64_t MINUTE_MS = 60 * 1000;
+constexpr int64_t HOUR_MS = 60 * MINUTE_MS;
+
+// timeMs - base помещается в int32; разность считается без переполнения int64
+bool fitsOffset(int64_t timeMs, int64_t base) {
+    uint64_t distance = timeMs >= base ? uint64_t(timeMs) - uint64_t(base) : uint64_t(base) - uint64_t(timeMs);
+    uint64_t limit = timeMs >= base ? uint64_t(std::numeric_limits<int32_t>::max())
+                                    : uint64_t(std::numeric_limits<int32_t>::max()) + 1;
+    return distance <= limit;
+}
+
+int64_t floorTo(int64_t value, int64_t step) {
+    int64_t quotient = value / step;
+    return ((value % step != 0 && value < 0) ? quotient - 1 : quotient) * step;
+}
+
+int64_t ceilTo(int64_t value, int64_t step) {
+    int64_t floor = floorTo(value, step);
+    return floor == value ? floor : floor + step;
+}
+
+int64_t toMs(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point toTimePoint(int64_t timeMs) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(timeMs)));
+}
+
+void addToBucket(std::map<int64_t, TimeBucket>& buckets, int64_t start, BetAction action, int amount, int sign) {
+    // Записи обычно идут по времени: нужный отрезок последний или следующий за ним
+    auto it = buckets.empty() ? buckets.end() : std::prev(buckets.end());
+    if (it == buckets.end() || it->first != start) {
+        it = buckets.lower_bound(start);
+        if (it == buckets.end() || it->first != start) {
+            it = buckets.emplace_hint(it, start, TimeBucket());
+            it->second.start = toTimePoint(start);
+        }
+    }
+    TimeBucket& bucket = it->second;
+    bucket.actionCounts[static_cast<size_t>(action)] += sign;
+    bucket.totalAmount += static_cast<int64_t>(amount) * sign;
+    bucket.records += sign;
+    if (bucket.records == 0) {
+        buckets.erase(it);
+    }
+}
+
+void addBucket(TimeBucket& total, const TimeBucket& bucket) {
+    for (size_t i = 0; i < BET_ACTION_COUNT; i++) {
+        total.actionCounts[i] += bucket.actionCounts[i];
+    }
+    total.totalAmount += bucket.totalAmount;
+    total.records += bucket.records;
+}
+
+}
+
+BetHistory::BetHistory() : BetHistory("bet_history.txt") {
+}
+
+BetHistory::BetHistory(const std::string& file) : BetHistory(file, std::pmr::get_default_resource()) {
+}
+
+BetHistory::BetHistory(const std::string& file, std::pmr::memory_resource* resource)
+    : players(resource), actions(resource), amounts(resource), rounds(resource), notes(resource),
+      timeOffsets(resource), timeBlocks(resource), blockSequences(resource), sequenceOffsets(resource),
+      nextSequence(0), customNotes(resource), customNoteCodes(resource),
+      roundsOrdered(true), deletedCount(0), orderedCount(0), filename(file), fileFormat(HistoryFormat::CSV), autoSave(false),
+      logGeneration(0), logCompactThreshold(DEFAULT_LOG_COMPACT), logCompactRetry(0) {
+}
+
+void BetHistory::append(PlayerId playerId, BetAction action, int amount, int round, uint16_t note, int64_t timeMs) {
+    append(playerId, action, amount, round, note, timeMs, nextSequence++);
+}
+
+void BetHistory::append(PlayerId playerId, BetAction action, int amount, int round, uint16_t note, int64_t timeMs,
+                        uint64_t sequence) {
+    if (players.size() % SEQUENCE_BLOCK == 0) {
+        blockSequences.push_back(sequence);
+    }
+
+    players.push_back(playerId);
+    actions.push_back(action);
+    amounts.push_back(amount);
+    rounds.push_back(round);
+    notes.push_back(note);
+    if (timeBlocks.empty() || !fitsOffset(timeMs, timeBlocks.back().base)) {
+        timeBlocks.push_back({ static_cast<uint32_t>(players.size() - 1), timeMs });
+    }
+    timeOffsets.push_back(static_cast<int32_t>(timeMs - timeBlocks.back().base));
+    sequenceOffsets.push_back(static_cast<uint32_t>(sequence - blockSequences.back()));
+
+    uint32_t position = static_cast<uint32_t>(players.size() - 1);
+    postings[playerId].push_back(position);
+    addToStats(position);
+    if (orderedCount == position && (position == 0 || getTimeMs(position) >= getTimeMs(position - 1))) {
+        orderedCount++;
+    } else {
+        lateTimes.emplace(getTimeMs(position), position);
+    }
+    addToRollups(position, 1);
+    if (!roundRuns.empty() && roundRuns.back().round == round && roundRuns.back().end == position) {
+        roundRuns.back().end++;
+    } else {
+        if (!roundRuns.empty() && round < roundRuns.back().round) {
+            roundsOrdered = false;
+        }
+        roundRuns.push_back({ round, position, position + 1 });
+    }
+}
+
+template <typename F>
+void BetHistory::forEachRoundRun(int round, F f) const {
+    if (roundsOrdered) {
+        auto range = std::equal_range(roundRuns.begin(), roundRuns.end(), RoundRun{ round, 0, 0 },
+                                      [](const RoundRun& a, const RoundRun& b) { return a.round < b.round; });
+        for (auto it = range.first; it != range.second; ++it) {
+            f(it->begin, it->end);
+        }
+        return;
+    }
+    for (const RoundRun& run : roundRuns) {
+        if (run.round == round) {
+            f(run.begin, run.end);
+        }
+    }
+}
+
+bool BetHistory::isRecordDeleted(size_t index) const {
+    return players[index] == INVALID_PLAYER_ID;
+}
+
+void BetHistory::markDeleted(size_t index) {
+    addToRollups(index, -1);
+    PlayerId playerId = players[index];
+    if (PlayerEntry* entry = playerEntries.find(playerId)) {
+        unrank(playerId, *entry);
+        PlayerBetStats& stats = entry->stats;
+        stats.actionCounts[static_cast<size_t>(actions[index])]--;
+        stats.totalAmount -= amounts[index];
+        stats.records--;
+        if (stats.records == 0) {
+            playerEntries.erase(playerId);
+        } else {
+            if (getSequence(index) == entry->firstSequence) {
+                // Следующая живая запись игрока: в списке позиций после удаляемой
+                const std::vector<uint32_t>& positions = *postings.find(playerId);
+                auto it = std::upper_bound(positions.begin(), positions.end(), static_cast<uint32_t>(index));
+                while (players[*it] != playerId) {
+                    ++it;
+                }
+                entry->firstSequence = getSequence(*it);
+            }
+            rank(playerId, *entry);
+        }
+    }
+    players[index] = INVALID_PLAYER_ID;
+    amounts[index] = 0;
+    deletedCount++;
+}
+
+int64_t BetHistory::getTimeMs(size_t index) const {
+    // Обычно блок времени один; иначе - двоичный поиск по началам блоков
+    const TimeBlock* block = &timeBlocks.back();
+    if (index < block->begin) {
+        auto it = std::upper_bound(timeBlocks.begin(), timeBlocks.end(), index,
+                                   [](size_t i, const TimeBlock& b) { return i < b.begin; });
+        block = &*std::prev(it);
+    }
+    return block->base + timeOffsets[index];
+}
+
+size_t BetHistory::findTime(int64_t timeMs) const {
+    size_t low = 0;
+    size_t high = orderedCount;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (getTimeMs(middle) < timeMs) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+template <typename F>
+void BetHistory::forEachInTimeRange(int64_t fromMs, int64_t toMs, F f) const {
+    if (fromMs >= toMs) return;
+    size_t end = findTime(toMs);
+    for (size_t i = findTime(fromMs); i < end; i++) {
+        if (!isRecordDeleted(i)) {
+            f(i);
+        }
+    }
+    if (lateTimes.empty()) return;
+
+    // Позиции хвоста больше позиций начала: после сортировки порядок хранения сохраняется
+    std::vector<uint32_t> late;
+    auto last = lateTimes.lower_bound({ toMs, 0 });
+    for (auto it = lateTimes.lower_bound({ fromMs, 0 }); it != last; ++it) {
+        late.push_back(it->second);
+    }
+    std::sort(late.begin(), late.end());
+    for (uint32_t i : late) {
+        if (!isRecordDeleted(i)) {
+            f(i);
+        }
+    }
+}
+
+void BetHistory::addToRollups(size_t index, int sign) {
+    int64_t timeMs = getTimeMs(index);
+    addToBucket(minuteBuckets, floorTo(timeMs, MINUTE_MS), actions[index], amounts[index], sign);
+    addToBucket(hourBuckets, floorTo(timeMs, HOUR_MS), actions[index], amounts[index], sign);
+}
+
+uint64_t BetHistory::getSequence(size_t index) const {
+    return blockSequences[index / SEQUENCE_BLOCK] + sequenceOffsets[index];
+}
+
+size_t BetHistory::findSequence(uint64_t sequence) const {
+    auto block = std::upper_bound(blockSequences.begin(), blockSequences.end(), sequence);
+    if (block == blockSequences.begin()) return 0;
+    size_t blockIndex = static_cast<size_t>(block - blockSequences.begin()) - 1;
+    size_t begin = blockIndex * SEQUENCE_BLOCK;
+    size_t end = std::min(players.size(), begin + SEQUENCE_BLOCK);
+    uint64_t offset = sequence - blockSequences[blockIndex];
+    if (offset > std::numeric_limits<uint32_t>::max()) return end;
+    auto position = std::lower_bound(sequenceOffsets.begin() + begin, sequenceOffsets.begin() + end,
+                                     static_cast<uint32_t>(offset));
+    return static_cast<size_t>(position - sequenceOffsets.begin());
+}
+
+void BetHistory::addToStats(size_t index) {
+    PlayerId playerId = players[index];
+    bool isNew = !playerEntries.contains(playerId);
+    PlayerEntry& entry = playerEntries[playerId];
+    if (isNew) {
+        entry.firstSequence = getSequence(index);
+    } else {
+        unrank(playerId, entry);
+    }
+    entry.stats.actionCounts[static_cast<size_t>(actions[index])]++;
+    entry.stats.totalAmount += amounts[index];
+    entry.stats.records++;
+    rank(playerId, entry);
+}
+
+void BetHistory::unrank(PlayerId playerId, const PlayerEntry& entry) {
+    aggressionRanking.erase(RankKey{ entry.rankedFactor, entry.firstSequence, playerId });
+}
+
+void BetHistory::rank(PlayerId playerId, PlayerEntry& entry) {
+    entry.rankedFactor = entry.stats.getAggressionFactor();
+    aggressionRanking.insert(RankKey{ entry.rankedFactor, entry.firstSequence, playerId });
+}
+
+double PlayerBetStats::getAggressionFactor() const {
+    int raises = getCount(BetAction::RAISE);
+    int totalActions = raises + getCount(BetAction::CALL) + getCount(BetAction::CHECK);
+    if (totalActions == 0) return 0.0;
+    
+    return static_cast<double>(raises) / totalActions;
+}
+
+size_t BetHistory::getStorageSize() const {
+    return players.size();
+}
+
+uint16_t BetHistory::internNote(const std::string& text) {
+    for (uint16_t code = 0; code < static_cast<uint16_t>(BetNote::CUSTOM); code++) {
+        if (STANDARD_NOTES[code] == text) {
+            return code;
+        }
+    }
+    auto it = customNoteCodes.find(std::pmr::string(text, customNoteCodes.get_allocator()));
+    if (it != customNoteCodes.end()) {
+        return it->second;
+    }
+    size_t code = static_cast<size_t>(BetNote::CUSTOM) + customNotes.size();
+    if (code > std::numeric_limits<uint16_t>::max()) {
+        std::cout << "Ошибка: Слишком много разных заметок, заметка не сохранена" << std::endl;
+        return static_cast<uint16_t>(BetNote::NONE);
+    }
+    customNotes.emplace_back(text);
+    customNoteCodes.emplace(customNotes.back(), static_cast<uint16_t>(code));
+    return static_cast<uint16_t>(code);
+}
+
+std::string BetHistory::getNoteString(uint16_t note) const {
+    return std::string(getNoteView(note));
+}
+
+std::string_view BetHistory::getNoteView(uint16_t note) const {
+    if (note < static_cast<uint16_t>(BetNote::CUSTOM)) {
+        return STANDARD_NOTES[note];
+    }
+    size_t index = note - static_cast<size_t>(BetNote::CUSTOM);
+    return index < customNotes.size() ? std::string_view(customNotes[index]) : std::string_view();
+}
+
+void BetHistory::addBet(PlayerId playerId, BetAction action, int amount, int round, BetNote note) {
+    append(playerId, action, amount, round, static_cast<uint16_t>(note), getNowMs());
     
     if (autoSave) {
-        saveToFile();
+        logBet(players.size() - 1);
     }
 }
 
+void BetHistory::addBet(PlayerId playerId, BetAction action, int amount, int round, const std::string& notes) {
+    append(playerId, action, amount, round, internNote(notes), getNowMs());
+    
+    if (autoSave) {
+        logBet(players.size() - 1);
+    }
+}
+
+void BetHistory::addBet(const std::string& playerName, BetAction action, int amount, int round, const std::string& notes) {
+    addBet(PlayerRegistry::getId(playerName), action, amount, round, notes);
+}
+
 void BetHistory::addFold(const std::string& playerName, int round) {
-    addBet(playerName, BetAction::FOLD, 0, round, "Player folded");
+    addBet(PlayerRegistry::getId(playerName), BetAction::FOLD, 0, round, BetNote::FOLDED);
 }
 
 void BetHistory::addCheck(const std::string& playerName, int round) {
-    addBet(playerName, BetAction::CHECK, 0, round, "Player checked");
+    addBet(PlayerRegistry::getId(playerName), BetAction::CHECK, 0, round, BetNote::CHECKED);
 }
 
 void BetHistory::addCall(const std::string& playerName, int amount, int round) {
-    addBet(playerName, BetAction::CALL, amount, round, "Player called");
+    addBet(PlayerRegistry::getId(playerName), BetAction::CALL, amount, round, BetNote::CALLED);
 }
 
 void BetHistory::addRaise(const std::string& playerName, int amount, int round) {
-    addBet(playerName, BetAction::RAISE, amount, round, "Player raised");
+    addBet(PlayerRegistry::getId(playerName), BetAction::RAISE, amount, round, BetNote::RAISED);
 }
 
 void BetHistory::addAllIn(const std::string& playerName, int amount, int round) {
-    addBet(playerName, BetAction::ALL_IN, amount, round, "Player went all-in");
+    addBet(PlayerRegistry::getId(playerName), BetAction::ALL_IN, amount, round, BetNote::ALL_IN);
 }
 
 void BetHistory::addBlind(const std::string& playerName, int amount, int round, bool isBigBlind) {
     BetAction action = isBigBlind ? BetAction::BIG_BLIND : BetAction::SMALL_BLIND;
-    std::string note = isBigBlind ? "Big blind" : "Small blind";
-    addBet(playerName, action, amount, round, note);
+    BetNote note = isBigBlind ? BetNote::BIG_BLIND : BetNote::SMALL_BLIND;
+    addBet(PlayerRegistry::getId(playerName), action, amount, round, note);
+}
+
+BetRecordView BetHistory::getRecordView(size_t index) const {
+    return { players[index], actions[index], amounts[index], rounds[index], getTimeMs(index), getNoteView(notes[index]) };
+}
+
+BetRecord BetHistory::getRecord(size_t index) const {
+    BetRecord record;
+    record.playerId = players[index];
+    record.action = actions[index];
+    record.amount = amounts[index];
+    record.round = rounds[index];
+    record.timestamp = toTimePoint(getTimeMs(index));
+    record.notes = getNoteString(notes[index]);
+    return record;
 }
 
-std::vector<BetRecord> BetHistory::getHistory() const {
-    return history;
+std::vector<BetRecord> BetHistory::snapshotHistory() const {
+    std::vector<BetRecord> records;
+    records.reserve(getHistorySize());
+    for (size_t i = 0; i < players.size(); i++) {
+        if (!isRecordDeleted(i)) {
+            records.push_back(getRecord(i));
+        }
+    }
+    return records;
 }
 
 std::vector<BetRecord> BetHistory::getPlayerHistory(const std::string& playerName) const {
+    PlayerId playerId = PlayerRegistry::findId(playerName);
     std::vector<BetRecord> playerHistory;
-    for (const auto& record : history) {
-        if (record.playerName == playerName) {
-            playerHistory.push_back(record);
+    if (const std::vector<uint32_t>* positions = postings.find(playerId)) {
+        for (uint32_t position : *positions) {
+            if (players[position] == playerId) {
+                playerHistory.push_back(getRecord(position));
+            }
         }
     }
     return playerHistory;
@@ -64,201 +506,544 @@ std::vector<BetRecord> BetHistory::getPlayerHistory(const std::string& playerNam
 
 std::vector<BetRecord> BetHistory::getRoundHistory(int round) const {
     std::vector<BetRecord> roundHistory;
-    for (const auto& record : history) {
-        if (record.round == round) {
-            roundHistory.push_back(record);
+    forEachRoundRun(round, [this, &roundHistory](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            if (!isRecordDeleted(i)) {
+                roundHistory.push_back(getRecord(i));
+            }
         }
-    }
+    });
     return roundHistory;
 }
 
 std::vector<BetRecord> BetHistory::getPlayerRoundHistory(const std::string& playerName, int round) const {
+    PlayerId playerId = PlayerRegistry::findId(playerName);
     std::vector<BetRecord> playerRoundHistory;
-    for (const auto& record : history) {
-        if (record.playerName == playerName && record.round == round) {
-            playerRoundHistory.push_back(record);
+    const std::vector<uint32_t>* positions = postings.find(playerId);
+    if (!positions) return playerRoundHistory;
+    // Позиции игрока внутри отрезка раунда - двоичным поиском по его списку
+    forEachRoundRun(round, [&](uint32_t begin, uint32_t end) {
+        auto it = std::lower_bound(positions->begin(), positions->end(), begin);
+        for (; it != positions->end() && *it < end; ++it) {
+            if (players[*it] == playerId) {
+                playerRoundHistory.push_back(getRecord(*it));
+            }
         }
-    }
+    });
     return playerRoundHistory;
 }
 
 int BetHistory::getTotalBetsByPlayer(const std::string& playerName) const {
-    int total = 0;
-    for (const auto& record : history) {
-        if (record.playerName == playerName) {
-            total += record.amount;
-        }
-    }
-    return total;
+    const PlayerEntry* entry = playerEntries.find(PlayerRegistry::findId(playerName));
+    return entry ? static_cast<int>(entry->stats.totalAmount) : 0;
 }
 
 int BetHistory::getTotalBetsByPlayerInRound(const std::string& playerName, int round) const {
+    PlayerId playerId = PlayerRegistry::findId(playerName);
     int total = 0;
-    for (const auto& record : history) {
-        if (record.playerName == playerName && record.round == round) {
-            total += record.amount;
+    const std::vector<uint32_t>* positions = postings.find(playerId);
+    if (!positions) return 0;
+    forEachRoundRun(round, [&](uint32_t begin, uint32_t end) {
+        auto it = std::lower_bound(positions->begin(), positions->end(), begin);
+        for (; it != positions->end() && *it < end; ++it) {
+            total += players[*it] == playerId ? amounts[*it] : 0;
         }
-    }
+    });
     return total;
 }
 
 int BetHistory::getTotalPotInRound(int round) const {
     int total = 0;
-    for (const auto& record : history) {
-        if (record.round == round) {
-            total += record.amount;
+    forEachRoundRun(round, [this, &total](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            total += amounts[i];
         }
-    }
+    });
     return total;
 }
 
 int BetHistory::getPlayerActionCount(const std::string& playerName, BetAction action) const {
-    int count = 0;
-    for (const auto& record : history) {
-        if (record.playerName == playerName && record.action == action) {
-            count++;
-        }
-    }
-    return count;
+    return getPlayerActionCount(PlayerRegistry::findId(playerName), action);
+}
+
+int BetHistory::getPlayerActionCount(PlayerId playerId, BetAction action) const {
+    const PlayerEntry* entry = playerEntries.find(playerId);
+    return entry ? entry->stats.getCount(action) : 0;
 }
 
 double BetHistory::getPlayerAggressionFactor(const std::string& playerName) const {
-    int raises = getPlayerActionCount(playerName, BetAction::RAISE);
-    int calls = getPlayerActionCount(playerName, BetAction::CALL);
-    int checks = getPlayerActionCount(playerName, BetAction::CHECK);
-    
-    int totalActions = raises + calls + checks;
-    if (totalActions == 0) return 0.0;
-    
-    return static_cast<double>(raises) / totalActions;
+    return getPlayerAggressionFactor(PlayerRegistry::findId(playerName));
 }
 
-std::vector<std::string> BetHistory::getMostAggressivePlayers() const {
-    std::map<std::string, double> aggressionFactors;
-    
-    // Get unique player names
-    std::vector<std::string> players;
-    for (const auto& record : history) {
-        if (std::find(players.begin(), players.end(), record.playerName) == players.end()) {
-            players.push_back(record.playerName);
-        }
+double BetHistory::getPlayerAggressionFactor(PlayerId playerId) const {
+    const PlayerEntry* entry = playerEntries.find(playerId);
+    return entry ? entry->stats.getAggressionFactor() : 0.0;
+}
+
+const PlayerBetStats* BetHistory::getPlayerBetStats(PlayerId playerId) const {
+    const PlayerEntry* entry = playerEntries.find(playerId);
+    return entry ? &entry->stats : nullptr;
+}
+
+std::vector<std::string> BetHistory::getMostAggressivePlayers(size_t limit) const {
+    size_t count = limit == 0 ? aggressionRanking.size() : std::min(limit, aggressionRanking.size());
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (auto it = aggressionRanking.begin(); names.size() < count; ++it) {
+        names.push_back(PlayerRegistry::getName(it->player));
     }
-    
-    // Calculate aggression factors
-    for (const auto& player : players) {
-        aggressionFactors[player] = getPlayerAggressionFactor(player);
+    return names;
+}
+
+std::vector<std::string> BetHistory::getTightestPlayers(size_t limit) const {
+    size_t count = limit == 0 ? aggressionRanking.size() : std::min(limit, aggressionRanking.size());
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (auto it = aggressionRanking.rbegin(); names.size() < count; ++it) {
+        names.push_back(PlayerRegistry::getName(it->player));
     }
-    
-    // Sort by aggression factor
-    std::sort(players.begin(), players.end(), 
-              [&aggressionFactors](const std::string& a, const std::string& b) {
-                  return aggressionFactors[a] > aggressionFactors[b];
-              });
-    
-    return players;
+    return names;
 }
 
-std::vector<std::string> BetHistory::getTightestPlayers() const {
-    std::vector<std::string> aggressive = getMostAggressivePlayers();
-    std::reverse(aggressive.begin(), aggressive.end());
-    return aggressive;
+std::vector<BetRecord> BetHistory::getHistoryBetween(std::chrono::system_clock::time_point from,
+                                                     std::chrono::system_clock::time_point to) const {
+    std::vector<BetRecord> records;
+    forEachInTimeRange(toMs(from), toMs(to), [this, &records](size_t i) {
+        records.push_back(getRecord(i));
+    });
+    return records;
+}
+
+std::vector<TimeBucket> BetHistory::getRollup(TimeGranularity granularity, std::chrono::system_clock::time_point from,
+                                              std::chrono::system_clock::time_point to) const {
+    const std::map<int64_t, TimeBucket>& buckets = granularity == TimeGranularity::HOUR ? hourBuckets : minuteBuckets;
+    std::vector<TimeBucket> result;
+    auto end = buckets.lower_bound(toMs(to));
+    for (auto it = buckets.lower_bound(toMs(from)); it != end; ++it) {
+        result.push_back(it->second);
+    }
+    return result;
+}
+
+void BetHistory::addRange(TimeBucket& total, int64_t fromMs, int64_t toMs) const {
+    forEachInTimeRange(fromMs, toMs, [this, &total](size_t i) {
+        total.actionCounts[static_cast<size_t>(actions[i])]++;
+        total.totalAmount += amounts[i];
+        total.records++;
+    });
+}
+
+TimeBucket BetHistory::getTotalsBetween(std::chrono::system_clock::time_point from,
+                                        std::chrono::system_clock::time_point to) const {
+    TimeBucket total;
+    total.start = from;
+    int64_t fromMs = toMs(from);
+    int64_t endMs = toMs(to);
+    if (fromMs >= endMs) return total;
+
+    // Середина - целыми часами, края до часа - целыми минутами, остаток - по записям
+    int64_t firstHour = ceilTo(fromMs, HOUR_MS);
+    int64_t lastHour = floorTo(endMs, HOUR_MS);
+    if (firstHour >= lastHour) {
+        firstHour = lastHour = endMs;
+    }
+    auto hoursEnd = hourBuckets.lower_bound(lastHour);
+    for (auto it = hourBuckets.lower_bound(firstHour); it != hoursEnd; ++it) {
+        addBucket(total, it->second);
+    }
+    const std::pair<int64_t, int64_t> edges[] = { { fromMs, firstHour }, { lastHour, endMs } };
+    for (const auto& edge : edges) {
+        if (edge.first >= edge.second) continue;
+        int64_t firstMinute = ceilTo(edge.first, MINUTE_MS);
+        int64_t lastMinute = floorTo(edge.second, MINUTE_MS);
+        if (firstMinute >= lastMinute) {
+            addRange(total, edge.first, edge.second);
+            continue;
+        }
+        auto minutesEnd = minuteBuckets.lower_bound(lastMinute);
+        for (auto it = minuteBuckets.lower_bound(firstMinute); it != minutesEnd; ++it) {
+            addBucket(total, it->second);
+        }
+        addRange(total, edge.first, firstMinute);
+        addRange(total, lastMinute, edge.second);
+    }
+    return total;
 }
 
 std::map<std::string, int> BetHistory::getPlayerStats(const std::string& playerName) const {
     std::map<std::string, int> stats;
+    const PlayerBetStats* counts = getPlayerBetStats(PlayerRegistry::findId(playerName));
+    PlayerBetStats empty;
+    if (!counts) counts = &empty;
     
-    stats["Total Bets"] = getTotalBetsByPlayer(playerName);
-    stats["Folds"] = getPlayerActionCount(playerName, BetAction::FOLD);
-    stats["Checks"] = getPlayerActionCount(playerName, BetAction::CHECK);
-    stats["Calls"] = getPlayerActionCount(playerName, BetAction::CALL);
-    stats["Raises"] = getPlayerActionCount(playerName, BetAction::RAISE);
-    stats["All-Ins"] = getPlayerActionCount(playerName, BetAction::ALL_IN);
+    stats["Total Bets"] = static_cast<int>(counts->totalAmount);
+    stats["Folds"] = counts->getCount(BetAction::FOLD);
+    stats["Checks"] = counts->getCount(BetAction::CHECK);
+    stats["Calls"] = counts->getCount(BetAction::CALL);
+    stats["Raises"] = counts->getCount(BetAction::RAISE);
+    stats["All-Ins"] = counts->getCount(BetAction::ALL_IN);
     
     return stats;
 }
 
-void BetHistory::saveToFile() const {
+void BetHistory::saveToFile() {
     saveToFile(filename);
 }
 
-void BetHistory::saveToFile(const std::string& file) const {
-    std::ofstream outFile(file);
-    if (!outFile.is_open()) {
-        std::cout << "Ошибка: Не удалось открыть файл " << file << " для записи" << std::endl;
-        return;
+void BetHistory::saveToFile(const std::string& file) {
+    // Снимок без checkpoint рядом с журналом при загрузке получил бы журнал повторно
+    if (log.isOpen() && file == filename) {
+        compactLog();
+    } else {
+        writeSnapshot(file, 0);
     }
-    
-    outFile << "Player,Action,Amount,Round,Timestamp,Notes" << std::endl;
-    
-    for (const auto& record : history) {
-        outFile << record.playerName << ","
-                << getActionString(record.action) << ","
-                << record.amount << ","
-                << record.round << ","
-                << getTimestampString(record.timestamp) << ","
-                << record.notes << std::endl;
+}
+
+bool BetHistory::writeSnapshot(const std::string& file, uint32_t checkpoint) const {
+    return fileFormat == HistoryFormat::BINARY ? writeBinary(file, checkpoint) : writeCSV(file, checkpoint, true);
+}
+
+bool BetHistory::writeCSV(const std::string& file, uint32_t checkpoint, bool milliseconds) const {
+    CsvWriter writer;
+    if (!writer.open(file)) {
+        return false;
     }
-    
-    outFile.close();
+    if (checkpoint > 0) {
+        writer.addLine(CSV_CHECKPOINT + std::to_string(checkpoint));
+    }
+    writer.addLine(CSV_HEADER);
+    writeMatches(writer, BetFilter(), 0, milliseconds);
+    return writer.close();
 }
 
 void BetHistory::loadFromFile() {
-    loadFromFile(filename);
+    log.commit();
+    uint32_t checkpoint = loadSnapshot(filename);
+    logGeneration = checkpoint;
+    replayLog(checkpoint, true);
+    if (log.isOpen()) {
+        compactLog();
+    }
+}
+
+size_t BetHistory::replayLog(uint32_t checkpoint, bool apply) {
+    // Строки до первой G - журнал без поколений; их не содержит только снимок без checkpoint
+    size_t pending = 0;
+    uint32_t generation = 0;
+    BetLog::replay(getLogFilename(), [&](const std::string& line) {
+        if (line.compare(0, 2, "G\t") == 0) {
+            if (CsvIngest::parseNumber(std::string_view(line).substr(2), generation) && apply) {
+                logGeneration = std::max(logGeneration, generation);
+            }
+            return;
+        }
+        if (checkpoint > 0 && generation <= checkpoint) return;
+        pending++;
+        if (apply) {
+            applyLogLine(line);
+        }
+    });
+    return pending;
 }
 
 void BetHistory::loadFromFile(const std::string& file) {
-    std::ifstream inFile(file);
+    loadSnapshot(file);
+    if (log.isOpen()) {
+        compactLog();
+    }
+}
+
+uint32_t BetHistory::loadSnapshot(const std::string& file) {
+    if (BetSegment::isSegmentFile(file)) {
+        return loadBinary(file);
+    }
+    return loadCSV(file);
+}
+
+bool BetHistory::writeBinary(const std::string& file, uint32_t checkpoint) const {
+    BetSegmentWriter writer;
+    if (!writer.open(file, checkpoint)) {
+        return false;
+    }
+    // Словарь заметок пишется целиком, поэтому коды заметок в сегменте те же
+    for (const auto& note : customNotes) {
+        writer.addNote(note);
+    }
+    PlayerTable<uint32_t> segmentPlayers;
+    for (size_t i = 0; i < players.size(); i++) {
+        if (isRecordDeleted(i)) continue;
+        const uint32_t* player = segmentPlayers.find(players[i]);
+        if (!player) {
+            player = &(segmentPlayers[players[i]] = writer.addPlayer(PlayerRegistry::getName(players[i])));
+        }
+        SegmentRecord record = {};
+        record.player = *player;
+        record.action = static_cast<uint8_t>(actions[i]);
+        record.note = notes[i];
+        record.amount = amounts[i];
+        record.round = rounds[i];
+        record.timeMs = getTimeMs(i);
+        writer.addRecord(record);
+    }
+    if (!writer.finish()) {
+        std::cout << "Ошибка: Не удалось записать файл " << file << std::endl;
+        return false;
+    }
+    return true;
+}
+
+uint32_t BetHistory::loadBinary(const std::string& file) {
+    BetSegmentReader reader;
+    if (!reader.open(file)) {
+        return 0;
+    }
+    clearColumns();
+
+    std::vector<PlayerId> playerIds(reader.getPlayerCount());
+    for (uint32_t i = 0; i < playerIds.size(); i++) {
+        playerIds[i] = PlayerRegistry::getId(std::string(reader.getPlayerName(i)));
+    }
+    std::vector<uint16_t> noteCodes(reader.getNoteCount());
+    for (uint32_t i = 0; i < noteCodes.size(); i++) {
+        noteCodes[i] = internNote(std::string(reader.getNote(i)));
+    }
+
+    size_t count = reader.getRecordCount();
+    players.reserve(count);
+    actions.reserve(count);
+    amounts.reserve(count);
+    rounds.reserve(count);
+    notes.reserve(count);
+    timeOffsets.reserve(count);
+
+    const uint16_t firstCustom = static_cast<uint16_t>(BetNote::CUSTOM);
+    const SegmentRecord* records = reader.getRecords();
+    for (size_t i = 0; i < count; i++) {
+        const SegmentRecord& record = records[i];
+        if (record.player >= playerIds.size() || record.action > static_cast<uint8_t>(BetAction::BIG_BLIND)) {
+            continue;
+        }
+        uint16_t note = record.note;
+        if (note >= firstCustom) {
+            size_t index = note - firstCustom;
+            note = index < noteCodes.size() ? noteCodes[index] : static_cast<uint16_t>(BetNote::NONE);
+        }
+        append(playerIds[record.player], static_cast<BetAction>(record.action), record.amount,
+               record.round, note, record.timeMs);
+    }
+    return reader.getCheckpoint();
+}
+
+uint32_t BetHistory::loadCSV(const std::string& file) {
+    std::ifstream inFile(file, std::ios::binary);
     if (!inFile.is_open()) {
         std::cout << "Ошибка: Не удалось открыть файл " << file << " для чтения" << std::endl;
-        return;
+        return 0;
     }
-    
-    history.clear();
-    std::string line;
-    std::getline(inFile, line); // Skip header
-    
-    while (std::getline(inFile, line)) {
-        std::istringstream iss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        while (std::getline(iss, token, ',')) {
-            tokens.push_back(token);
-        }
-        
-        if (tokens.size() >= 6) {
-            BetAction action;
-            std::string actionStr = tokens[1];
-            if (actionStr == "FOLD") action = BetAction::FOLD;
-            else if (actionStr == "CHECK") action = BetAction::CHECK;
-            else if (actionStr == "CALL") action = BetAction::CALL;
-            else if (actionStr == "RAISE") action = BetAction::RAISE;
-            else if (actionStr == "ALL_IN") action = BetAction::ALL_IN;
-            else if (actionStr == "SMALL_BLIND") action = BetAction::SMALL_BLIND;
-            else if (actionStr == "BIG_BLIND") action = BetAction::BIG_BLIND;
-            else continue;
-            
-            BetRecord record(tokens[0], action, std::stoi(tokens[2]), 
-                           std::stoi(tokens[3]), tokens[5]);
-            history.push_back(record);
-        }
+    std::string header;
+    std::getline(inFile, header);
+    uint32_t checkpoint = 0;
+    if (parseCheckpoint(header, checkpoint)) {
+        std::getline(inFile, header);
     }
-    
+    std::streamoff offset = inFile.good() ? static_cast<std::streamoff>(inFile.tellg()) : -1;
     inFile.close();
+
+    clearColumns();
+    if (offset < 0) return checkpoint;
+    int64_t nowMs = getNowMs();
+    std::vector<CsvBetChunk> chunks(CsvIngest::getSlotCount());
+
+    // Заметка - последнее поле: запятые в старых неэкранированных заметках остаются в ней
+    auto parse = [&chunks, nowMs](size_t slot, std::string_view text) {
+        CsvBetChunk& chunk = chunks[slot];
+        chunk.clear();
+        std::string_view fields[6];
+        CsvIngest::forEachLine(text, [&chunk, &fields, nowMs](std::string_view line) {
+            CsvBetRow row;
+            if (!CsvIngest::splitFields(line, fields, 6, 5, chunk.commas) || !parseAction(fields[1], row.action) ||
+                !CsvIngest::parseNumber(fields[2], row.amount) || !CsvIngest::parseNumber(fields[3], row.round)) {
+                return;
+            }
+            if (!chunk.timestamps.parse(fields[4], row.timeMs)) {
+                row.timeMs = nowMs;
+            }
+            row.player = indexOf(chunk.nameIndex, chunk.names, fields[0]);
+            row.note = indexOf(chunk.noteIndex, chunk.noteTexts, fields[5]);
+            chunk.rows.push_back(row);
+        });
+    };
+    auto merge = [this, &chunks](size_t slot) {
+        CsvBetChunk& chunk = chunks[slot];
+        chunk.playerIds.resize(chunk.names.size());
+        for (size_t i = 0; i < chunk.names.size(); i++) {
+            chunk.playerIds[i] = PlayerRegistry::getId(CsvIngest::unescape(chunk.names[i]));
+        }
+        chunk.noteCodes.resize(chunk.noteTexts.size());
+        for (size_t i = 0; i < chunk.noteTexts.size(); i++) {
+            chunk.noteCodes[i] = internNote(CsvIngest::unescape(chunk.noteTexts[i]));
+        }
+        for (const CsvBetRow& row : chunk.rows) {
+            append(chunk.playerIds[row.player], row.action, row.amount, row.round, chunk.noteCodes[row.note], row.timeMs);
+        }
+    };
+    CsvIngest::ingest(file, offset, static_cast<unsigned>(chunks.size()), parse, merge);
+    return checkpoint;
 }
 
 void BetHistory::setAutoSave(bool enable) {
-    autoSave = enable;
+    if (enable && !log.isOpen()) {
+        // Журнал прошлого запуска, не вошедший в снимок, очистка журнала потеряла бы
+        if (replayLog(readCheckpoint(filename), false) > 0) {
+            if (isEmpty()) {
+                loadFromFile();
+            } else {
+                std::cout << "Ошибка: Журнал " << getLogFilename()
+                          << " не восстановлен, автосохранение не включено" << std::endl;
+                autoSave = false;
+                return;
+            }
+        }
+        // Дальше журнал продолжает снимок текущей истории
+        if (log.open(getLogFilename())) {
+            compactLog();
+        }
+    } else if (!enable) {
+        log.close();
+    }
+    autoSave = enable && log.isOpen();
 }
 
 void BetHistory::setFilename(const std::string& file) {
     filename = file;
+    if (log.isOpen()) {
+        log.close();
+        setAutoSave(true);
+    }
+}
+
+void BetHistory::setFileFormat(HistoryFormat format) {
+    fileFormat = format;
+}
+
+HistoryFormat BetHistory::getFileFormat() const {
+    return fileFormat;
+}
+
+void BetHistory::setLogPolicy(size_t groupCommit, LogSync sync) {
+    log.setGroupCommit(groupCommit, sync);
+}
+
+void BetHistory::setLogCompactThreshold(size_t records) {
+    logCompactThreshold = records;
+}
+
+void BetHistory::flushLog() {
+    log.commit();
+}
+
+void BetHistory::compactLog() {
+    if (!log.isOpen()) return;
+    // Неудачная попытка откладывает следующую, пока журнал не вырастет вдвое
+    logCompactRetry = log.getRecordCount() * 2;
+    if (!log.commit()) return;
+    // Снимок пишется во временный файл и подменяет старый переименованием. Он помнит
+    // текущее поколение журнала: если очистка журнала не успеет, при загрузке эти
+    // строки пропускаются.
+    uint32_t checkpoint = std::max<uint32_t>(logGeneration, 1);
+    std::string tempFile = filename + ".tmp";
+    if (!writeSnapshot(tempFile, checkpoint) || !BetLog::syncFile(tempFile)) return;
+    std::error_code error;
+    std::filesystem::rename(tempFile, filename, error);
+    if (error) {
+        std::cout << "Ошибка: Не удалось заменить файл " << filename << std::endl;
+        return;
+    }
+    // Если каталог не сброшен, после сбоя может остаться старый снимок: журнал нужен целиком
+    if (BetLog::syncDirectory(filename)) {
+        log.truncate();
+        logCompactRetry = 0;
+    }
+    // Строки после замены снимка в него не вошли - они идут следующим поколением
+    logGeneration = checkpoint + 1;
+    log.append("G\t" + std::to_string(logGeneration));
+    log.commit();
+}
+
+std::string BetHistory::getLogFilename() const {
+    return filename + ".wal";
+}
+
+// Строки журнала, поля через табуляцию:
+//   G поколение - начало журнала после очистки
+//   A игрок действие сумма раунд время_мс заметка
+//   P игрок   - очистка истории игрока
+//   R раунд   - очистка раунда
+//   C         - очистка всей истории
+void BetHistory::logBet(size_t index) {
+    logLine.assign("A\t");
+    appendLogField(logLine, PlayerRegistry::getName(players[index]), false);
+    logLine += '\t';
+    logLine += std::to_string(static_cast<int>(actions[index]));
+    logLine += '\t';
+    logLine += std::to_string(amounts[index]);
+    logLine += '\t';
+    logLine += std::to_string(rounds[index]);
+    logLine += '\t';
+    logLine += std::to_string(getTimeMs(index));
+    logLine += '\t';
+    appendLogField(logLine, getNoteView(notes[index]), true);
+    log.append(logLine);
+    if (log.getRecordCount() > std::max({ logCompactThreshold, getHistorySize(), logCompactRetry })) {
+        compactLog();
+    }
+}
+
+void BetHistory::logClear(char kind, const std::string& argument) {
+    logLine.assign(1, kind);
+    if (!argument.empty()) {
+        logLine += '\t';
+        appendLogField(logLine, argument, false);
+    }
+    log.append(logLine);
+}
+
+void BetHistory::applyLogLine(const std::string& line) {
+    // Заметка - последнее поле и может содержать табуляцию
+    const size_t MAX_FIELDS = 7;
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t tab = fields.size() + 1 < MAX_FIELDS ? line.find('\t', start) : std::string::npos;
+        fields.push_back(line.substr(start, tab - start));
+        if (tab == std::string::npos) break;
+        start = tab + 1;
+    }
+
+    int round = 0;
+    if (fields[0] == "A" && fields.size() == MAX_FIELDS) {
+        int action = 0;
+        int amount = 0;
+        int64_t timeMs = 0;
+        if (CsvIngest::parseNumber(fields[2], action) && action <= static_cast<int>(BetAction::BIG_BLIND) &&
+            CsvIngest::parseNumber(fields[3], amount) && CsvIngest::parseNumber(fields[4], round) &&
+            CsvIngest::parseNumber(fields[5], timeMs)) {
+            append(PlayerRegistry::getId(fields[1]), static_cast<BetAction>(action), amount, round,
+                   internNote(fields[6]), timeMs);
+        }
+    } else if (fields[0] == "P" && fields.size() == 2) {
+        removePlayer(PlayerRegistry::findId(fields[1]));
+    } else if (fields[0] == "R" && fields.size() == 2 && CsvIngest::parseNumber(fields[1], round)) {
+        removeRound(round);
+    } else if (fields[0] == "C") {
+        clearColumns();
+    }
 }
 
 void BetHistory::displayHistory() const {
     std::cout << "\n=== BET HISTORY ===" << std::endl;
-    for (const auto& record : history) {
-        std::cout << "Round " << record.round << ": " << record.playerName
+    forEachRecord([this](const BetRecordView& record) {
+        std::cout << "Round " << record.round << ": " << PlayerRegistry::getName(record.playerId)
                   << " " << getActionString(record.action);
         if (record.amount > 0) {
             std::cout << " $" << record.amount;
@@ -266,8 +1051,8 @@ void BetHistory::displayHistory() const {
         if (!record.notes.empty()) {
             std::cout << " (" << record.notes << ")";
         }
-        std::cout << " - " << getTimestampString(record.timestamp) << std::endl;
-    }
+        std::cout << " - " << getTimestampString(toTimePoint(record.timeMs)) << std::endl;
+    });
     std::cout << "==================" << std::endl;
 }
 
@@ -291,7 +1076,7 @@ void BetHistory::displayRoundHistory(int round) const {
     std::cout << "\n=== ROUND " << round << " HISTORY ===" << std::endl;
     auto roundHistory = getRoundHistory(round);
     for (const auto& record : roundHistory) {
-        std::cout << record.playerName << " " << getActionString(record.action);
+        std::cout << PlayerRegistry::getName(record.playerId) << " " << getActionString(record.action);
         if (record.amount > 0) {
             std::cout << " $" << record.amount;
         }
@@ -305,19 +1090,22 @@ void BetHistory::displayRoundHistory(int round) const {
 
 void BetHistory::displayStatistics() const {
     std::cout << "\n=== BETTING STATISTICS ===" << std::endl;
-    std::cout << "Total records: " << history.size() << std::endl;
+    std::cout << "Total records: " << getHistorySize() << std::endl;
     
-    // Get unique players
-    std::vector<std::string> players;
-    for (const auto& record : history) {
-        if (std::find(players.begin(), players.end(), record.playerName) == players.end()) {
-            players.push_back(record.playerName);
-        }
+    // Игроки в порядке появления в истории
+    std::vector<std::pair<uint64_t, PlayerId>> order;
+    playerEntries.forEach([&order](PlayerId playerId, const PlayerEntry& entry) {
+        order.emplace_back(entry.firstSequence, playerId);
+    });
+    std::sort(order.begin(), order.end());
+    std::vector<std::string> playerNames;
+    for (const auto& player : order) {
+        playerNames.push_back(PlayerRegistry::getName(player.second));
     }
     
-    std::cout << "Players: " << players.size() << std::endl;
+    std::cout << "Players: " << playerNames.size() << std::endl;
     
-    for (const auto& player : players) {
+    for (const auto& player : playerNames) {
         std::cout << "\n" << player << ":" << std::endl;
         auto stats = getPlayerStats(player);
         for (const auto& stat : stats) {
@@ -341,63 +1129,196 @@ void BetHistory::displayPlayerStatistics(const std::string& playerName) const {
     std::cout << "=========================" << std::endl;
 }
 
+void BetHistory::compact() {
+    std::pmr::vector<PlayerId> oldPlayers(std::move(players));
+    std::pmr::vector<BetAction> oldActions(std::move(actions));
+    std::pmr::vector<int32_t> oldAmounts(std::move(amounts));
+    std::pmr::vector<int32_t> oldRounds(std::move(rounds));
+    std::pmr::vector<uint16_t> oldNotes(std::move(notes));
+    std::pmr::vector<int32_t> oldTimeOffsets(std::move(timeOffsets));
+    std::pmr::vector<TimeBlock> oldTimeBlocks(std::move(timeBlocks));
+    std::pmr::vector<uint64_t> oldBlockSequences(std::move(blockSequences));
+    std::pmr::vector<uint32_t> oldSequenceOffsets(std::move(sequenceOffsets));
+    clearColumns();
+
+    size_t timeBlock = 0;
+    for (size_t i = 0; i < oldPlayers.size(); i++) {
+        while (timeBlock + 1 < oldTimeBlocks.size() && oldTimeBlocks[timeBlock + 1].begin <= i) {
+            timeBlock++;
+        }
+        if (oldPlayers[i] != INVALID_PLAYER_ID) {
+            append(oldPlayers[i], oldActions[i], oldAmounts[i], oldRounds[i], oldNotes[i],
+                   oldTimeBlocks[timeBlock].base + oldTimeOffsets[i],
+                   oldBlockSequences[i / SEQUENCE_BLOCK] + oldSequenceOffsets[i]);
+        }
+    }
+}
+
+void BetHistory::compactIfSparse() {
+    if (players.size() >= MIN_COMPACT_SIZE && deletedCount * 2 > players.size()) {
+        compact();
+    }
+}
+
+void BetHistory::clearColumns() {
+    players.clear();
+    actions.clear();
+    amounts.clear();
+    rounds.clear();
+    notes.clear();
+    timeOffsets.clear();
+    timeBlocks.clear();
+    blockSequences.clear();
+    sequenceOffsets.clear();
+    postings.clear();
+    roundRuns.clear();
+    playerEntries.clear();
+    aggressionRanking.clear();
+    minuteBuckets.clear();
+    hourBuckets.clear();
+    roundsOrdered = true;
+    orderedCount = 0;
+    lateTimes.clear();
+    deletedCount = 0;
+}
+
 void BetHistory::clearHistory() {
-    history.clear();
+    clearColumns();
+    if (autoSave) {
+        logClear('C', "");
+    }
 }
 
 void BetHistory::clearPlayerHistory(const std::string& playerName) {
-    history.erase(
-        std::remove_if(history.begin(), history.end(),
-                      [&playerName](const BetRecord& record) {
-                          return record.playerName == playerName;
-                      }),
-        history.end()
-    );
+    removePlayer(PlayerRegistry::findId(playerName));
+    if (autoSave) {
+        logClear('P', playerName);
+    }
+}
+
+void BetHistory::removePlayer(PlayerId playerId) {
+    const std::vector<uint32_t>* positions = postings.find(playerId);
+    if (!positions) return;
+    // Счётчики уходят целиком, без пересчёта на каждой записи
+    if (const PlayerEntry* entry = playerEntries.find(playerId)) {
+        unrank(playerId, *entry);
+        playerEntries.erase(playerId);
+    }
+    for (uint32_t position : *positions) {
+        if (players[position] == playerId) {
+            markDeleted(position);
+        }
+    }
+    postings.erase(playerId);
+    compactIfSparse();
 }
 
 void BetHistory::clearRoundHistory(int round) {
-    history.erase(
-        std::remove_if(history.begin(), history.end(),
-                      [round](const BetRecord& record) {
-                          return record.round == round;
-                      }),
-        history.end()
-    );
+    removeRound(round);
+    if (autoSave) {
+        logClear('R', std::to_string(round));
+    }
+}
+
+void BetHistory::removeRound(int round) {
+    // Списки игроков сохраняют позиции надгробий: запросы сверяют игрока в столбце
+    forEachRoundRun(round, [this](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            if (!isRecordDeleted(i)) {
+                markDeleted(i);
+            }
+        }
+    });
+    roundRuns.erase(std::remove_if(roundRuns.begin(), roundRuns.end(),
+                                   [round](const RoundRun& run) { return run.round == round; }),
+                    roundRuns.end());
+    compactIfSparse();
 }
 
 size_t BetHistory::getHistorySize() const {
-    return history.size();
+    return players.size() - deletedCount;
 }
 
 bool BetHistory::isEmpty() const {
-    return history.empty();
+    return getHistorySize() == 0;
 }
 
 void BetHistory::exportToCSV(const std::string& filename) const {
-    saveToFile(filename);
+    writeCSV(filename, 0, false);
 }
 
 void BetHistory::exportPlayerToCSV(const std::string& playerName, const std::string& filename) const {
-    std::ofstream outFile(filename);
-    if (!outFile.is_open()) {
-        std::cout << "Ошибка: Не удалось открыть файл " << filename << " для записи" << std::endl;
+    CsvWriter writer;
+    if (!writer.open(filename)) {
         return;
     }
-    
-    outFile << "Player,Action,Amount,Round,Timestamp,Notes" << std::endl;
-    
-    for (const auto& record : history) {
-        if (record.playerName == playerName) {
-            outFile << record.playerName << ","
-                    << getActionString(record.action) << ","
-                    << record.amount << ","
-                    << record.round << ","
-                    << getTimestampString(record.timestamp) << ","
-                    << record.notes << std::endl;
+    writer.addLine(CSV_HEADER);
+    BetFilter filter;
+    filter.player = PlayerRegistry::findId(playerName);
+    if (filter.player != INVALID_PLAYER_ID) {
+        writeMatches(writer, filter, 0);
+    }
+    writer.close();
+}
+
+size_t BetHistory::exportToCSV(const std::string& filename, ExportCursor& cursor, const BetFilter& filter) const {
+    CsvWriter writer;
+    if (!writer.open(filename, true)) {
+        return 0;
+    }
+    if (writer.startedEmptyFile()) {
+        writer.addLine(CSV_HEADER);
+    }
+    size_t written = writeMatches(writer, filter, findSequence(cursor.sequence));
+    if (!writer.close()) {
+        std::cout << "Ошибка: Не удалось записать файл " << filename << std::endl;
+        return 0;
+    }
+    cursor.sequence = nextSequence;
+    return written;
+}
+
+size_t BetHistory::writeMatches(CsvWriter& writer, const BetFilter& filter, size_t from, bool milliseconds) const {
+    size_t written = 0;
+    auto visit = [&](size_t index) {
+        bool matches = !isRecordDeleted(index) &&
+                       (filter.player == INVALID_PLAYER_ID || players[index] == filter.player) &&
+                       (filter.anyRound || rounds[index] == filter.round) &&
+                       (filter.actionMask >> static_cast<unsigned>(actions[index]) & 1u);
+        if (matches) {
+            writeRecord(writer, index, milliseconds);
+            written++;
+        }
+    };
+
+    if (filter.player != INVALID_PLAYER_ID) {
+        if (const std::vector<uint32_t>* positions = postings.find(filter.player)) {
+            for (auto it = std::lower_bound(positions->begin(), positions->end(), from); it != positions->end(); ++it) {
+                visit(*it);
+            }
+        }
+    } else if (!filter.anyRound) {
+        forEachRoundRun(filter.round, [&](uint32_t begin, uint32_t end) {
+            for (size_t i = std::max<size_t>(begin, from); i < end; i++) {
+                visit(i);
+            }
+        });
+    } else {
+        for (size_t i = from; i < players.size(); i++) {
+            visit(i);
         }
     }
-    
-    outFile.close();
+    return written;
+}
+
+void BetHistory::writeRecord(CsvWriter& writer, size_t index, bool milliseconds) const {
+    writer.addField(PlayerRegistry::getName(players[index]));
+    writer.addField(ACTION_NAMES[static_cast<size_t>(actions[index])]);
+    writer.addField(int64_t(amounts[index]));
+    writer.addField(int64_t(rounds[index]));
+    writer.addTimestamp(getTimeMs(index), milliseconds);
+    writer.addField(getNoteView(notes[index]));
+    writer.endRow();
 }
 
 std::string BetHistory::getActionString(BetAction action) const {
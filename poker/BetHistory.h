@@ -1,13 +1,21 @@
 #ifndef POKER_BETHISTORY_H
 #define POKER_BETHISTORY_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <fstream>
 #include <map>
+#include <set>
+#include <memory_resource>
+#include <unordered_map>
+#include "PlayerRegistry.h"
+#include "BetLog.h"
+#include "CsvWriter.h"
 
-enum class BetAction {
+enum class BetAction : uint8_t {
     FOLD,
     CHECK,
     CALL,
@@ -17,32 +25,236 @@ enum class BetAction {
     BIG_BLIND
 };
 
+constexpr size_t BET_ACTION_COUNT = 7;
+
+// Стандартные заметки хранятся кодом; прочие тексты - в словаре истории
+// с кодами от CUSTOM.
+enum class BetNote : uint16_t {
+    NONE,
+    FOLDED,
+    CHECKED,
+    CALLED,
+    RAISED,
+    ALL_IN,
+    SMALL_BLIND,
+    BIG_BLIND,
+    CUSTOM
+};
+
+// Формат saveToFile и снимков автосохранения; loadFromFile распознаёт формат сам
+enum class HistoryFormat {
+    CSV,    // время с мс; выгрузки exportToCSV - до секунды
+    BINARY  // сегмент BetSegment
+};
+
+// Счётчики игрока по живым записям истории
+struct PlayerBetStats {
+    int actionCounts[BET_ACTION_COUNT] = {};
+    int64_t totalAmount = 0;
+    int records = 0;
+
+    int getCount(BetAction action) const {
+        return actionCounts[static_cast<size_t>(action)];
+    }
+    // Доля рейзов среди рейзов, коллов и чеков
+    double getAggressionFactor() const;
+};
+
+// Отбор записей для экспорта; по умолчанию подходят все
+struct BetFilter {
+    PlayerId player = INVALID_PLAYER_ID;  // INVALID_PLAYER_ID - любой игрок
+    bool anyRound = true;
+    int round = 0;
+    uint32_t actionMask = ~0u;            // бит 1 << BetAction
+};
+
+// Шаг сводок по времени; отрезки выровнены по эпохе (UTC)
+enum class TimeGranularity {
+    MINUTE,
+    HOUR
+};
+
+// Сводка живых записей за отрезок времени [start, start + шаг)
+struct TimeBucket {
+    std::chrono::system_clock::time_point start;
+    int actionCounts[BET_ACTION_COUNT] = {};
+    int64_t totalAmount = 0;
+    int records = 0;
+
+    int getCount(BetAction action) const {
+        return actionCounts[static_cast<size_t>(action)];
+    }
+    double getAverageAmount() const {
+        return records == 0 ? 0.0 : static_cast<double>(totalAmount) / records;
+    }
+};
+
+// Запись в развёрнутом виде: так её отдают запросы, хранится история по столбцам.
 struct BetRecord {
-    std::string playerName;
+    PlayerId playerId;
     BetAction action;
     int amount;
     int round;
     std::chrono::system_clock::time_point timestamp;
     std::string notes;
-    
-    BetRecord(const std::string& name, BetAction act, int amt, int rnd, const std::string& note = "")
-        : playerName(name), action(act), amount(amt), round(rnd), 
-          timestamp(std::chrono::system_clock::now()), notes(note) {}
 };
 
+// Запись без копий: поля из столбцов, заметка - из словаря истории.
+// Действительна, пока история не меняется.
+struct BetRecordView {
+    PlayerId playerId;
+    BetAction action;
+    int amount;
+    int round;
+    int64_t timeMs;  // мс от эпохи
+    std::string_view notes;
+};
+
+// История ставок в столбцах (structure of arrays): ID игрока, 1 байт действия,
+// 32-битные сумма и раунд, код заметки, время как 32-битное смещение в мс от базы
+// блока времени и номер записи как смещение от начала блока из SEQUENCE_BLOCK записей.
+// Блок времени длится, пока смещения помещаются в int32 (около 24 суток в обе стороны
+// от базы), затем начинается новый. Около 24 байт на действие без отдельных блоков
+// в куче; подсчёты по игроку и действию идут по плотным столбцам.
+//
+// Индексы: у каждого игрока список позиций его записей, у раундов - отрезки позиций
+// (раунды обычно дописываются по порядку). Удалённые записи остаются на месте как
+// надгробия (игрок INVALID_PLAYER_ID, сумма 0) и вычищаются, когда их больше половины.
+//
+// Автосохранение: снимок в filename и журнал действий filename.wal. Действие дописывает
+// в журнал одну строку; когда журнал длиннее истории (и не короче порога), история
+// записывается новым снимком, а журнал очищается. loadFromFile() читает снимок и журнал.
+// Журнал делится на поколения (строка G в начале); снимок помнит последнее вошедшее в него
+// поколение, поэтому сбой между заменой снимка и очисткой журнала не удваивает записи.
+//
+// Время: пока записи дописываются по времени (обычный случай), отбор по отрезку времени -
+// двоичный поиск по столбцу времени. Записи после первой пришедшей не по порядку
+// попадают в отсортированный индекс хвоста, так что отбор остаётся логарифмическим.
+// Поминутные и почасовые сводки ведутся при добавлении и удалении записей, поэтому
+// итоги за месяцы не требуют обхода истории.
 class BetHistory {
 private:
-    std::vector<BetRecord> history;
+    static constexpr size_t SEQUENCE_BLOCK = 1024;
+    static constexpr size_t MIN_COMPACT_SIZE = 1024;
+    static constexpr size_t DEFAULT_LOG_COMPACT = 4096;
+
+    struct RoundRun {
+        int32_t round;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    struct TimeBlock {
+        uint32_t begin;  // первая позиция блока
+        int64_t base;    // мс от эпохи
+    };
+
+    struct PlayerEntry {
+        PlayerBetStats stats;
+        uint64_t firstSequence;  // первая живая запись игрока
+        double rankedFactor;     // с каким ключом игрок лежит в рейтинге
+    };
+
+    // Рейтинг агрессии: фактор по убыванию, при равенстве - кто раньше появился в истории
+    struct RankKey {
+        double factor;
+        uint64_t firstSequence;
+        PlayerId player;
+
+        bool operator<(const RankKey& other) const {
+            if (factor != other.factor) return factor > other.factor;
+            if (firstSequence != other.firstSequence) return firstSequence < other.firstSequence;
+            return player < other.player;
+        }
+    };
+
+    std::pmr::vector<PlayerId> players;
+    std::pmr::vector<BetAction> actions;
+    std::pmr::vector<int32_t> amounts;
+    std::pmr::vector<int32_t> rounds;
+    std::pmr::vector<uint16_t> notes;
+    std::pmr::vector<int32_t> timeOffsets;  // мс от base блока времени записи
+    std::pmr::vector<TimeBlock> timeBlocks;
+    std::pmr::vector<uint64_t> blockSequences;   // порядковый номер первой записи блока
+    std::pmr::vector<uint32_t> sequenceOffsets;  // номер записи от blockSequences[i / SEQUENCE_BLOCK]
+    uint64_t nextSequence;                       // номера растут и не переиспользуются
+    std::pmr::vector<std::pmr::string> customNotes;
+    std::pmr::unordered_map<std::pmr::string, uint16_t> customNoteCodes;
+    PlayerTable<std::vector<uint32_t>> postings;  // позиции записей игрока по возрастанию
+    std::vector<RoundRun> roundRuns;
+    bool roundsOrdered;                            // раунды отрезков не убывают
+    size_t deletedCount;
+    PlayerTable<PlayerEntry> playerEntries;
+    std::set<RankKey> aggressionRanking;
+    size_t orderedCount;                           // в начале хранилища время не убывает
+    std::set<std::pair<int64_t, uint32_t>> lateTimes;  // (время, позиция) записей после orderedCount
+    std::map<int64_t, TimeBucket> minuteBuckets;   // ключ - начало отрезка в мс от эпохи
+    std::map<int64_t, TimeBucket> hourBuckets;
     std::string filename;
+    HistoryFormat fileFormat;
     bool autoSave;
+    BetLog log;
+    uint32_t logGeneration;  // поколение строк, дописываемых в журнал
+    size_t logCompactThreshold;
+    size_t logCompactRetry;  // длина журнала для новой попытки, если прошлая его не очистила
+    std::string logLine;  // буфер строки журнала, память переиспользуется
     
     std::string getActionString(BetAction action) const;
     std::string getTimestampString(const std::chrono::system_clock::time_point& time) const;
+    // milliseconds - время с мс (снимки); выгрузки пишут время до секунды
+    void writeRecord(CsvWriter& writer, size_t index, bool milliseconds) const;
+    size_t writeMatches(CsvWriter& writer, const BetFilter& filter, size_t from, bool milliseconds = false) const;
+    std::string_view getNoteView(uint16_t note) const;
+    uint64_t getSequence(size_t index) const;
+    // Первая позиция хранилища с номером не меньше sequence
+    size_t findSequence(uint64_t sequence) const;
+    int64_t getTimeMs(size_t index) const;
+    // Первая позиция упорядоченного начала хранилища со временем не меньше timeMs
+    size_t findTime(int64_t timeMs) const;
+    // f(index) для живых записей со временем в [fromMs, toMs)
+    template <typename F>
+    void forEachInTimeRange(int64_t fromMs, int64_t toMs, F f) const;
+    void addToRollups(size_t index, int sign);
+    void addRange(TimeBucket& total, int64_t fromMs, int64_t toMs) const;
+    uint16_t internNote(const std::string& text);
+    void append(PlayerId playerId, BetAction action, int amount, int round, uint16_t note, int64_t timeMs);
+    void append(PlayerId playerId, BetAction action, int amount, int round, uint16_t note, int64_t timeMs,
+                uint64_t sequence);
+    void markDeleted(size_t index);
+    void addToStats(size_t index);
+    void unrank(PlayerId playerId, const PlayerEntry& entry);
+    void rank(PlayerId playerId, PlayerEntry& entry);
+    void clearColumns();
+    void removePlayer(PlayerId playerId);
+    void removeRound(int round);
+    // Убирает надгробия, если их больше половины записей
+    void compactIfSparse();
+    void compact();
+    // f(begin, end) для каждого отрезка позиций раунда
+    template <typename F>
+    void forEachRoundRun(int round, F f) const;
+    // checkpoint - поколение журнала, уже вошедшее в снимок (0 - нет)
+    bool writeSnapshot(const std::string& file, uint32_t checkpoint) const;
+    bool writeCSV(const std::string& file, uint32_t checkpoint, bool milliseconds) const;
+    bool writeBinary(const std::string& file, uint32_t checkpoint) const;
+    // Возвращают checkpoint прочитанного снимка
+    uint32_t loadSnapshot(const std::string& file);
+    uint32_t loadCSV(const std::string& file);
+    uint32_t loadBinary(const std::string& file);
+    // Строки журнала новее checkpoint; apply - применить их, иначе только посчитать
+    size_t replayLog(uint32_t checkpoint, bool apply);
+    void logBet(size_t index);
+    void logClear(char kind, const std::string& argument);
+    void applyLogLine(const std::string& line);
 
 public:
     BetHistory();
     BetHistory(const std::string& file);
+    // Столбцы и словарь заметок берутся из resource; resource должен пережить историю
+    BetHistory(const std::string& file, std::pmr::memory_resource* resource);
     
+    void addBet(PlayerId playerId, BetAction action, int amount, int round, BetNote note = BetNote::NONE);
+    void addBet(PlayerId playerId, BetAction action, int amount, int round, const std::string& notes);
     void addBet(const std::string& playerName, BetAction action, int amount, int round, const std::string& notes = "");
     void addFold(const std::string& playerName, int round);
     void addCheck(const std::string& playerName, int round);
@@ -51,7 +263,18 @@ public:
     void addAllIn(const std::string& playerName, int amount, int round);
     void addBlind(const std::string& playerName, int amount, int round, bool isBigBlind = false);
     
-    std::vector<BetRecord> getHistory() const;
+    // index - позиция в хранилище (0..getStorageSize()-1), удалённые пропускайте через isRecordDeleted
+    BetRecordView getRecordView(size_t index) const;
+    BetRecord getRecord(size_t index) const;
+    size_t getStorageSize() const;
+    bool isRecordDeleted(size_t index) const;
+    // f(const BetRecordView&) для живых записей в порядке хранения, без копий строк
+    template <typename F>
+    void forEachRecord(F f) const;
+    // Копия всей истории в развёрнутом виде (с копиями заметок) для тех, кому она нужна
+    // отдельно от истории; для чтения - forEachRecord
+    std::vector<BetRecord> snapshotHistory() const;
+    std::string getNoteString(uint16_t note) const;
     std::vector<BetRecord> getPlayerHistory(const std::string& playerName) const;
     std::vector<BetRecord> getRoundHistory(int round) const;
     std::vector<BetRecord> getPlayerRoundHistory(const std::string& playerName, int round) const;
@@ -59,19 +282,47 @@ public:
     int getTotalBetsByPlayer(const std::string& playerName) const;
     int getTotalBetsByPlayerInRound(const std::string& playerName, int round) const;
     int getTotalPotInRound(int round) const;
+    int getPlayerActionCount(PlayerId playerId, BetAction action) const;
     int getPlayerActionCount(const std::string& playerName, BetAction action) const;
+    double getPlayerAggressionFactor(PlayerId playerId) const;
     double getPlayerAggressionFactor(const std::string& playerName) const;
+    // Счётчики игрока или nullptr, если живых записей нет; O(1)
+    const PlayerBetStats* getPlayerBetStats(PlayerId playerId) const;
     
-    std::vector<std::string> getMostAggressivePlayers() const;
-    std::vector<std::string> getTightestPlayers() const;
+    // limit - сколько первых мест рейтинга вернуть (0 - всех); O(limit)
+    std::vector<std::string> getMostAggressivePlayers(size_t limit = 0) const;
+    std::vector<std::string> getTightestPlayers(size_t limit = 0) const;
     std::map<std::string, int> getPlayerStats(const std::string& playerName) const;
+
+    // Записи со временем в [from, to) в порядке хранения
+    std::vector<BetRecord> getHistoryBetween(std::chrono::system_clock::time_point from,
+                                             std::chrono::system_clock::time_point to) const;
+    // Непустые отрезки, начинающиеся в [from, to), по возрастанию времени
+    std::vector<TimeBucket> getRollup(TimeGranularity granularity, std::chrono::system_clock::time_point from,
+                                      std::chrono::system_clock::time_point to) const;
+    // Итог за [from, to): целые часы и минуты берутся из сводок, края - из записей
+    TimeBucket getTotalsBetween(std::chrono::system_clock::time_point from,
+                                std::chrono::system_clock::time_point to) const;
     
-    void saveToFile() const;
-    void saveToFile(const std::string& file) const;
+    // Снимок в filename при открытом журнале записывается через compactLog()
+    void saveToFile();
+    void saveToFile(const std::string& file);
     void loadFromFile();
     void loadFromFile(const std::string& file);
+    // Непустой журнал прошлого запуска сначала восстанавливается в пустую историю;
+    // поверх непустой истории автосохранение не включается, чтобы не потерять журнал
     void setAutoSave(bool enable);
     void setFilename(const std::string& file);
+    void setFileFormat(HistoryFormat format);
+    HistoryFormat getFileFormat() const;
+    // Запись журнала группами по groupCommit строк; NONE - без fsync
+    void setLogPolicy(size_t groupCommit, LogSync sync);
+    // Минимальная длина журнала (в строках) для записи нового снимка
+    void setLogCompactThreshold(size_t records);
+    void flushLog();
+    // Записывает снимок и очищает журнал
+    void compactLog();
+    std::string getLogFilename() const;
     
     void displayHistory() const;
     void displayPlayerHistory(const std::string& playerName) const;
@@ -87,6 +338,18 @@ public:
     
     void exportToCSV(const std::string& filename) const;
     void exportPlayerToCSV(const std::string& playerName, const std::string& filename) const;
+    // Дописывает в filename записи после cursor, подходящие под filter (заголовок - в пустой файл),
+    // и переводит cursor на конец истории. Возвращает число выгруженных записей.
+    size_t exportToCSV(const std::string& filename, ExportCursor& cursor, const BetFilter& filter = BetFilter()) const;
 };
 
+template <typename F>
+void BetHistory::forEachRecord(F f) const {
+    for (size_t i = 0; i < players.size(); i++) {
+        if (!isRecordDeleted(i)) {
+            f(getRecordView(i));
+        }
+    }
+}
+
 #endif
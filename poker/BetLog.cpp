@@ -0,0 +1,198 @@
+#include "BetLog.h"
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+int openAppend(const std::string& file) {
+#ifdef _WIN32
+    return _open(file.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return ::open(file.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#endif
+}
+
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+        int written = _write(fd, data, static_cast<unsigned>(size));
+#else
+        ssize_t written = ::write(fd, data, size);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool syncFd(int fd) {
+#ifdef _WIN32
+    return _commit(fd) == 0;
+#else
+    return ::fsync(fd) == 0;
+#endif
+}
+
+bool truncateFile(int fd) {
+#ifdef _WIN32
+    return _chsize(fd, 0) == 0;
+#else
+    return ::ftruncate(fd, 0) == 0;
+#endif
+}
+
+void closeFile(int fd) {
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+}
+
+BetLog::BetLog() : fd(-1), pendingRecords(0), recordCount(0), groupSize(1), sync(LogSync::NONE) {
+}
+
+BetLog::~BetLog() {
+    close();
+}
+
+bool BetLog::open(const std::string& file) {
+    close();
+    fd = openAppend(file);
+    if (fd < 0) {
+        std::cout << "Ошибка: Не удалось открыть журнал " << file << std::endl;
+        return false;
+    }
+    path = file;
+    recordCount = 0;
+    return true;
+}
+
+void BetLog::close() {
+    if (fd < 0) return;
+    commit();
+    closeFile(fd);
+    fd = -1;
+}
+
+bool BetLog::isOpen() const {
+    return fd >= 0;
+}
+
+const std::string& BetLog::getPath() const {
+    return path;
+}
+
+void BetLog::setGroupCommit(size_t records, LogSync syncPolicy) {
+    groupSize = records > 0 ? records : 1;
+    sync = syncPolicy;
+    if (pendingRecords >= groupSize) {
+        commit();
+    }
+}
+
+void BetLog::append(const std::string& line) {
+    buffer += line;
+    buffer += '\n';
+    pendingRecords++;
+    recordCount++;
+    if (pendingRecords >= groupSize) {
+        commit();
+    }
+}
+
+bool BetLog::commit() {
+    if (fd < 0 || buffer.empty()) return fd >= 0;
+    bool ok = writeAll(fd, buffer.data(), buffer.size());
+    if (ok && sync == LogSync::ON_COMMIT) {
+        ok = syncFd(fd);
+    }
+    if (!ok) {
+        std::cout << "Ошибка: Не удалось записать журнал " << path << std::endl;
+    }
+    buffer.clear();
+    pendingRecords = 0;
+    return ok;
+}
+
+bool BetLog::truncate() {
+    if (fd < 0) return false;
+    buffer.clear();
+    pendingRecords = 0;
+    recordCount = 0;
+    if (!truncateFile(fd)) {
+        std::cout << "Ошибка: Не удалось очистить журнал " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+size_t BetLog::getRecordCount() const {
+    return recordCount;
+}
+
+bool BetLog::syncFile(const std::string& file) {
+#ifdef _WIN32
+    int fileFd = _open(file.c_str(), _O_RDWR | _O_BINARY);
+#else
+    int fileFd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+    bool ok = fileFd >= 0 && syncFd(fileFd);
+    if (fileFd >= 0) {
+        closeFile(fileFd);
+    }
+    if (!ok) {
+        std::cout << "Ошибка: Не удалось сбросить на диск " << file << std::endl;
+    }
+    return ok;
+}
+
+bool BetLog::syncDirectory(const std::string& file) {
+#ifdef _WIN32
+    // Переименование в NTFS журналируется самой файловой системой
+    (void)file;
+    return true;
+#else
+    std::filesystem::path directory = std::filesystem::path(file).parent_path();
+    int dirFd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    bool ok = dirFd >= 0 && ::fsync(dirFd) == 0;
+    if (dirFd >= 0) {
+        closeFile(dirFd);
+    }
+    if (!ok) {
+        std::cout << "Ошибка: Не удалось сбросить на диск каталог " << directory.string() << std::endl;
+    }
+    return ok;
+#endif
+}
+
+bool BetLog::replay(const std::string& file, const std::function<void(const std::string&)>& f) {
+    std::ifstream inFile(file, std::ios::binary);
+    if (!inFile.is_open()) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(inFile, line)) {
+        // Без завершающего '\n' строка дописана не до конца
+        if (inFile.eof()) break;
+        f(line);
+    }
+    return true;
+}
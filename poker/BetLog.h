@@ -0,0 +1,55 @@
+#ifndef POKER_BETLOG_H
+#define POKER_BETLOG_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+// Когда сбрасывать журнал на диск
+enum class LogSync {
+    NONE,       // только write(): переживает падение программы, но не ОС
+    ON_COMMIT   // fsync после каждой записанной группы
+};
+
+// Журнал только на дозапись (write-ahead log): строки копятся в буфере и уходят
+// в файл одним write() на группу из groupSize строк. Файл открыт всё время,
+// поэтому запись не зависит от размера уже накопленного журнала.
+class BetLog {
+private:
+    int fd;
+    std::string path;
+    std::string buffer;
+    size_t pendingRecords;
+    size_t recordCount;     // строк с открытия или последнего усечения
+    size_t groupSize;
+    LogSync sync;
+
+public:
+    BetLog();
+    ~BetLog();
+    BetLog(const BetLog&) = delete;
+    BetLog& operator=(const BetLog&) = delete;
+
+    // Открывает файл на дозапись, создаёт при отсутствии
+    bool open(const std::string& file);
+    void close();
+    bool isOpen() const;
+    const std::string& getPath() const;
+
+    void setGroupCommit(size_t records, LogSync syncPolicy);
+    // line без перевода строки
+    void append(const std::string& line);
+    // Записывает накопленную группу и при ON_COMMIT делает fsync
+    bool commit();
+    // Очищает файл после записи снимка
+    bool truncate();
+    size_t getRecordCount() const;
+
+    // f(line) для каждой целой строки файла; оборванная последняя строка пропускается
+    static bool replay(const std::string& file, const std::function<void(const std::string&)>& f);
+    // Сбрасывает на диск содержимое файла и запись о нём в каталоге (после переименования)
+    static bool syncFile(const std::string& file);
+    static bool syncDirectory(const std::string& file);
+};
+
+#endif
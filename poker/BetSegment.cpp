@@ -0,0 +1,267 @@
+#include "BetSegment.h"
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char BetSegment::MAGIC[4] = { 'P', 'K', 'B', 'H' };
+
+bool BetSegment::isSegmentFile(const std::string& file) {
+    std::ifstream inFile(file, std::ios::binary);
+    char magic[4] = {};
+    inFile.read(magic, sizeof(magic));
+    return inFile.gcount() == sizeof(magic) && std::memcmp(magic, MAGIC, sizeof(magic)) == 0;
+}
+
+BetSegmentWriter::BetSegmentWriter() : recordCount(0) {
+}
+
+bool BetSegmentWriter::open(const std::string& file, uint32_t checkpoint) {
+    out.open(file, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cout << "Ошибка: Не удалось открыть файл " << file << " для записи" << std::endl;
+        return false;
+    }
+    block.clear();
+    block.reserve(RECORD_BLOCK);
+    playerStrings.clear();
+    noteStrings.clear();
+    playerEnds.clear();
+    noteEnds.clear();
+    recordCount = 0;
+
+    SegmentHeader header = {};
+    std::memcpy(header.magic, BetSegment::MAGIC, sizeof(header.magic));
+    header.version = BetSegment::VERSION;
+    header.recordSize = sizeof(SegmentRecord);
+    header.checkpoint = checkpoint;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return out.good();
+}
+
+uint32_t BetSegmentWriter::addPlayer(std::string_view name) {
+    playerStrings.append(name.data(), name.size());
+    playerEnds.push_back(playerStrings.size());
+    return static_cast<uint32_t>(playerEnds.size() - 1);
+}
+
+uint32_t BetSegmentWriter::addNote(std::string_view text) {
+    noteStrings.append(text.data(), text.size());
+    noteEnds.push_back(noteStrings.size());
+    return static_cast<uint32_t>(noteEnds.size() - 1);
+}
+
+void BetSegmentWriter::addRecord(const SegmentRecord& record) {
+    block.push_back(record);
+    if (block.size() == RECORD_BLOCK) {
+        flushBlock();
+    }
+}
+
+void BetSegmentWriter::flushBlock() {
+    out.write(reinterpret_cast<const char*>(block.data()),
+              static_cast<std::streamsize>(block.size() * sizeof(SegmentRecord)));
+    recordCount += block.size();
+    block.clear();
+}
+
+bool BetSegmentWriter::finish() {
+    flushBlock();
+
+    uint64_t playerStart = sizeof(SegmentHeader) + recordCount * sizeof(SegmentRecord);
+    uint64_t noteStart = playerStart + playerStrings.size();
+    uint64_t stringsEnd = noteStart + noteStrings.size();
+    uint64_t padding = (8 - stringsEnd % 8) % 8;
+    out.write(playerStrings.data(), static_cast<std::streamsize>(playerStrings.size()));
+    out.write(noteStrings.data(), static_cast<std::streamsize>(noteStrings.size()));
+    const char zeros[8] = {};
+    out.write(zeros, static_cast<std::streamsize>(padding));
+
+    // Таблица: начало каждой строки и конец последней, смещения от начала файла
+    auto writeTable = [this](uint64_t start, const std::vector<uint64_t>& ends) {
+        out.write(reinterpret_cast<const char*>(&start), sizeof(start));
+        for (uint64_t end : ends) {
+            uint64_t offset = start + end;
+            out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+        }
+    };
+    SegmentFooter footer = {};
+    footer.recordCount = recordCount;
+    footer.playerTableOffset = stringsEnd + padding;
+    footer.noteTableOffset = footer.playerTableOffset + (playerEnds.size() + 1) * sizeof(uint64_t);
+    footer.playerCount = static_cast<uint32_t>(playerEnds.size());
+    footer.noteCount = static_cast<uint32_t>(noteEnds.size());
+    footer.version = BetSegment::VERSION;
+    std::memcpy(footer.magic, BetSegment::MAGIC, sizeof(footer.magic));
+    writeTable(playerStart, playerEnds);
+    writeTable(noteStart, noteEnds);
+    out.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+
+    out.close();
+    return !out.fail();
+}
+
+BetSegmentReader::BetSegmentReader()
+    : data(nullptr), size(0), records(nullptr), playerTable(nullptr), noteTable(nullptr), footer(), checkpoint(0) {
+#ifdef _WIN32
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+#endif
+}
+
+BetSegmentReader::~BetSegmentReader() {
+    close();
+}
+
+bool BetSegmentReader::open(const std::string& file) {
+    close();
+#ifdef _WIN32
+    fileHandle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER fileSize;
+    if (fileHandle != INVALID_HANDLE_VALUE && GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart > 0) {
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle) {
+            data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+            size = static_cast<size_t>(fileSize.QuadPart);
+        }
+    }
+#else
+    int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info;
+    if (fd >= 0 && ::fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* mapped = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            data = static_cast<const char*>(mapped);
+            size = static_cast<size_t>(info.st_size);
+            ::madvise(mapped, size, MADV_SEQUENTIAL);
+        }
+    }
+    if (fd >= 0) {
+        ::close(fd);  // отображение остаётся действительным
+    }
+#endif
+    if (!data) {
+        std::cout << "Ошибка: Не удалось открыть файл " << file << " для чтения" << std::endl;
+        close();
+        return false;
+    }
+    if (!validate()) {
+        std::cout << "Ошибка: Файл " << file << " повреждён или другой версии" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool BetSegmentReader::validate() {
+    if (size < sizeof(SegmentHeader) + sizeof(SegmentFooter)) return false;
+    SegmentHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    std::memcpy(&footer, data + size - sizeof(SegmentFooter), sizeof(footer));
+    if (std::memcmp(header.magic, BetSegment::MAGIC, 4) != 0 || header.version != BetSegment::VERSION ||
+        header.recordSize != sizeof(SegmentRecord) ||
+        std::memcmp(footer.magic, BetSegment::MAGIC, 4) != 0 || footer.version != BetSegment::VERSION) {
+        return false;
+    }
+    checkpoint = header.checkpoint;
+
+    uint64_t footerOffset = size - sizeof(SegmentFooter);
+    if (footer.recordCount > (footerOffset - sizeof(SegmentHeader)) / sizeof(SegmentRecord)) return false;
+    uint64_t recordsEnd = sizeof(SegmentHeader) + footer.recordCount * sizeof(SegmentRecord);
+    uint64_t playerTableSize = (uint64_t(footer.playerCount) + 1) * sizeof(uint64_t);
+    uint64_t noteTableSize = (uint64_t(footer.noteCount) + 1) * sizeof(uint64_t);
+    // Смещения из файла не складываются до проверки границ: сумма могла бы переполниться
+    if (footer.playerTableOffset % sizeof(uint64_t) != 0 || footer.playerTableOffset < recordsEnd ||
+        footer.playerTableOffset > footerOffset || playerTableSize > footerOffset - footer.playerTableOffset ||
+        footer.noteTableOffset != footer.playerTableOffset + playerTableSize ||
+        noteTableSize != footerOffset - footer.noteTableOffset) {
+        return false;
+    }
+
+    records = reinterpret_cast<const SegmentRecord*>(data + sizeof(SegmentHeader));
+    playerTable = reinterpret_cast<const uint64_t*>(data + footer.playerTableOffset);
+    noteTable = reinterpret_cast<const uint64_t*>(data + footer.noteTableOffset);
+
+    // Строки лежат между записями и таблицами, смещения не убывают
+    uint64_t previous = recordsEnd;
+    for (uint32_t i = 0; i <= footer.playerCount; i++) {
+        if (playerTable[i] < previous) return false;
+        previous = playerTable[i];
+    }
+    for (uint32_t i = 0; i <= footer.noteCount; i++) {
+        if (noteTable[i] < previous) return false;
+        previous = noteTable[i];
+    }
+    return previous <= footer.playerTableOffset;
+}
+
+void BetSegmentReader::close() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (data) ::munmap(const_cast<char*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+    records = nullptr;
+    playerTable = nullptr;
+    noteTable = nullptr;
+    footer = SegmentFooter();
+    checkpoint = 0;
+}
+
+bool BetSegmentReader::isOpen() const {
+    return data != nullptr;
+}
+
+size_t BetSegmentReader::getRecordCount() const {
+    return static_cast<size_t>(footer.recordCount);
+}
+
+uint32_t BetSegmentReader::getCheckpoint() const {
+    return checkpoint;
+}
+
+const SegmentRecord* BetSegmentReader::getRecords() const {
+    return records;
+}
+
+const SegmentRecord& BetSegmentReader::getRecord(size_t index) const {
+    return records[index];
+}
+
+std::string_view BetSegmentReader::getString(const uint64_t* table, uint32_t index) const {
+    return std::string_view(data + table[index], static_cast<size_t>(table[index + 1] - table[index]));
+}
+
+uint32_t BetSegmentReader::getPlayerCount() const {
+    return footer.playerCount;
+}
+
+std::string_view BetSegmentReader::getPlayerName(uint32_t index) const {
+    return index < footer.playerCount ? getString(playerTable, index) : std::string_view();
+}
+
+uint32_t BetSegmentReader::getNoteCount() const {
+    return footer.noteCount;
+}
+
+std::string_view BetSegmentReader::getNote(uint32_t index) const {
+    return index < footer.noteCount ? getString(noteTable, index) : std::string_view();
+}
@@ -0,0 +1,123 @@
+#ifndef POKER_BETSEGMENT_H
+#define POKER_BETSEGMENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Двоичный сегмент истории ставок (порядок байт - little-endian):
+//   заголовок | записи SegmentRecord | строки игроков | строки заметок |
+//   таблицы смещений строк (uint64, count + 1) | SegmentFooter
+// Записи фиксированной ширины читаются прямо из отображённого файла.
+// Игрок в записи - номер в словаре сегмента, а не PlayerId процесса.
+
+struct SegmentHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t checkpoint;    // поколение журнала автосохранения, уже вошедшее в сегмент (0 - нет)
+};
+
+struct SegmentRecord {
+    uint32_t player;    // номер в словаре игроков
+    uint8_t action;     // BetAction
+    uint8_t reserved;
+    uint16_t note;      // BetNote; от CUSTOM - CUSTOM + номер в словаре заметок
+    int32_t amount;
+    int32_t round;
+    int64_t timeMs;     // мс от эпохи
+};
+
+struct SegmentFooter {
+    uint64_t recordCount;
+    uint64_t playerTableOffset;
+    uint64_t noteTableOffset;
+    uint32_t playerCount;
+    uint32_t noteCount;
+    uint32_t version;
+    char magic[4];
+};
+
+static_assert(sizeof(SegmentHeader) == 16, "SegmentHeader layout");
+static_assert(sizeof(SegmentRecord) == 24, "SegmentRecord layout");
+static_assert(sizeof(SegmentFooter) == 40, "SegmentFooter layout");
+
+class BetSegment {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static const char MAGIC[4];
+
+    // Начинается ли файл с заголовка сегмента
+    static bool isSegmentFile(const std::string& file);
+};
+
+// Пишет сегмент потоком: записи уходят в файл блоками, в памяти остаются только словари.
+class BetSegmentWriter {
+private:
+    static constexpr size_t RECORD_BLOCK = 4096;
+
+    std::ofstream out;
+    std::vector<SegmentRecord> block;
+    std::string playerStrings;
+    std::string noteStrings;
+    std::vector<uint64_t> playerEnds;
+    std::vector<uint64_t> noteEnds;
+    uint64_t recordCount;
+
+    void flushBlock();
+
+public:
+    BetSegmentWriter();
+
+    bool open(const std::string& file, uint32_t checkpoint = 0);
+    // Номера в словарях идут подряд с 0 в порядке добавления
+    uint32_t addPlayer(std::string_view name);
+    uint32_t addNote(std::string_view text);
+    void addRecord(const SegmentRecord& record);
+    // Дописывает словари и footer; без finish() файл не читается
+    bool finish();
+};
+
+// Читает сегмент через отображение файла в память без копирования записей.
+class BetSegmentReader {
+private:
+    const char* data;
+    size_t size;
+    const SegmentRecord* records;
+    const uint64_t* playerTable;
+    const uint64_t* noteTable;
+    SegmentFooter footer;
+    uint32_t checkpoint;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+    bool validate();
+    std::string_view getString(const uint64_t* table, uint32_t index) const;
+
+public:
+    BetSegmentReader();
+    ~BetSegmentReader();
+    BetSegmentReader(const BetSegmentReader&) = delete;
+    BetSegmentReader& operator=(const BetSegmentReader&) = delete;
+
+    bool open(const std::string& file);
+    void close();
+    bool isOpen() const;
+
+    size_t getRecordCount() const;
+    uint32_t getCheckpoint() const;
+    // Указатель на первую запись; действителен до close()
+    const SegmentRecord* getRecords() const;
+    const SegmentRecord& getRecord(size_t index) const;
+    uint32_t getPlayerCount() const;
+    std::string_view getPlayerName(uint32_t index) const;
+    uint32_t getNoteCount() const;
+    std::string_view getNote(uint32_t index) const;
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "BotPlayer.h"
 #include "HandEvaluator.h"
+#include "Equity.h"
 #include <iostream>
 #include <algorithm>
 #include <chrono>
@@ -17,6 +18,63 @@ BotPlayer::BotPlayer(const std::string& name, int initialBankroll)
     rng.seed(std::chrono::steady_clock::now().time_since_epoch().count());
 }
 
+void BotPlayer::setSeed(unsigned seed) {
+    rng.seed(seed);
+}
+
+void BotPlayer::setConfig(const BotConfig& botConfig) {
+    config = botConfig;
+}
+
+const BotConfig& BotPlayer::getConfig() const {
+    return config;
+}
+
+const MonteCarloResult& BotPlayer::getLastEquity() const {
+    return lastEquity;
+}
+
+void BotPlayer::setHudStats(std::shared_ptr<const HudStats> stats) {
+    hudStats = std::move(stats);
+}
+
+const std::shared_ptr<const HudStats>& BotPlayer::getHudStats() const {
+    return hudStats;
+}
+
+bool BotConfig::parse(const std::string& text, BotConfig& config) {
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        size_t equals = item.find('=');
+        if (equals == std::string::npos) return false;
+        std::string key = item.substr(0, equals);
+        if (key == "sampling") {
+            std::string method = item.substr(equals + 1);
+            if (method == "random") config.sampling = SamplingMethod::RANDOM;
+            else if (method == "stratified") config.sampling = SamplingMethod::STRATIFIED;
+            else if (method == "quasi") config.sampling = SamplingMethod::QUASI_RANDOM;
+            else return false;
+            continue;
+        }
+        try {
+            double value = std::stod(item.substr(equals + 1));
+            if (key == "allin") config.allInThreshold = value;
+            else if (key == "freq") config.allInFrequency = value;
+            else if (key == "raise") config.raiseThreshold = value;
+            else if (key == "pot") config.raisePotFraction = value;
+            else if (key == "min") config.minRaise = static_cast<int>(value);
+            else if (key == "equity") config.useEquity = value != 0.0;
+            else if (key == "precision") config.equityPrecision = value;
+            else if (key == "cbet") config.cbetFoldThreshold = value;
+            else return false;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void BotPlayer::setBankroll(int amount) {
     bankroll = amount;
 }
@@ -33,20 +91,20 @@ int BotPlayer::getCurrentBet() const {
     return currentBet;
 }
 
-BotDecision BotPlayer::getAction(const std::vector<Card>& communityCards, 
+BotDecision BotPlayer::getAction(CardSpan communityCards, 
                                 int potAmount, int currentBet, int maxBet) {
     return makeDecision(communityCards, potAmount, currentBet, maxBet);
 }
 
-BotDecision BotPlayer::makeDecision(const std::vector<Card>& communityCards, 
+BotDecision BotPlayer::makeDecision(CardSpan communityCards, 
                                    int potAmount, int currentBet, int maxBet) {
     BotDecision decision;
     
     double handStrength = evaluateHandStrength(getHand(), communityCards);
     double randomRisk = getRandomDouble(0.0, 1.0);
     
-    if (handStrength > 0.6) {
-        if (randomRisk < 0.7) {
+    if (handStrength > config.allInThreshold) {
+        if (randomRisk < config.allInFrequency) {
             decision.action = BotAction::ALL_IN;
             decision.amount = bankroll;
             decision.reasoning = "ВА-БАНК! Сильная рука!";
@@ -55,10 +113,14 @@ BotDecision BotPlayer::makeDecision(const std::vector<Card>& communityCards,
             decision.amount = calculateRaiseAmount(handStrength, potAmount);
             decision.reasoning = "РЕЙЗ! Иду до победы!";
         }
-    } else if (handStrength > 0.1) {
+    } else if (handStrength > config.raiseThreshold) {
         decision.action = BotAction::RAISE;
         decision.amount = calculateRaiseAmount(handStrength, potAmount);
         decision.reasoning = "РЕЙЗ! Рискую!";
+    } else if (shouldContinuationBet(communityCards, currentBet)) {
+        decision.action = BotAction::RAISE;
+        decision.amount = calculateRaiseAmount(handStrength, potAmount);
+        decision.reasoning = "КОНТБЕТ! Они всё равно сбросят!";
     } else {
         decision.action = BotAction::CALL;
         decision.amount = currentBet;
@@ -68,18 +130,43 @@ BotDecision BotPlayer::makeDecision(const std::vector<Card>& communityCards,
     if (decision.amount > bankroll) {
         decision.amount = bankroll;
         decision.action = BotAction::ALL_IN;
-        decision.reasoning += " (ВА-БАНК)";
+        decision.reasoning = "Ставка больше банкролла (ВА-БАНК)";
     }
     
     return decision;
 }
 
-double BotPlayer::evaluateHandStrength(const std::vector<Card>& hand, 
-                                      const std::vector<Card>& communityCards) {
+bool BotPlayer::shouldContinuationBet(CardSpan communityCards, int currentBet) const {
+    if (!hudStats || communityCards.size() != 3 || currentBet != 0) return false;
+    if (hudStats->getPreflopAggressor() != getId()) return false;
+
+    // Доля сбросов на контбет у оставшихся соперников за последние раздачи
+    HudCounter folds;
+    for (PlayerId opponent : hudStats->getHandPlayers()) {
+        if (opponent == getId()) continue;
+        HudCounter counter = hudStats->getWindowCounter(opponent, HudStat::FOLD_TO_CBET);
+        folds.hits += counter.hits;
+        folds.chances += counter.chances;
+    }
+    return folds.chances >= MIN_CBET_SAMPLES && folds.getRate() >= config.cbetFoldThreshold;
+}
+
+double BotPlayer::evaluateHandStrength(CardSpan hand, 
+                                      CardSpan communityCards) {
     if (hand.empty()) return 0.0;
     
-    std::vector<Card> fullHand = hand;
-    fullHand.insert(fullHand.end(), communityCards.begin(), communityCards.end());
+    if (config.useEquity) {
+        MonteCarloConfig monteCarlo;
+        monteCarlo.targetHalfWidth = config.equityPrecision;
+        monteCarlo.maxSamples = 20000;
+        monteCarlo.method = config.sampling;
+        lastEquity = Equity::vsRandom(HandEvaluator::toMask(hand), HandEvaluator::toMask(communityCards),
+                                      1, rng, monteCarlo);
+        return lastEquity.mean;
+    }
+    
+    HandCards fullHand(hand);
+    fullHand.append(communityCards);
     
     HandEvaluation evaluation = HandEvaluator::evaluateHand(fullHand);
     
@@ -97,13 +184,13 @@ double BotPlayer::evaluateHandStrength(const std::vector<Card>& hand,
 }
 
 int BotPlayer::calculateRaiseAmount(double handStrength, int potAmount) {
-    int baseRaise = static_cast<int>(potAmount * 0.75);
+    int baseRaise = static_cast<int>(potAmount * config.raisePotFraction);
     int raiseAmount = static_cast<int>(baseRaise * handStrength);
     
     int randomFactor = getRandomAmount(0, 50);
     raiseAmount += randomFactor;
     
-    return std::max(30, raiseAmount);
+    return std::max(config.minRaise, raiseAmount);
 }
 
 int BotPlayer::getRandomAmount(int min, int max) {
@@ -132,7 +219,13 @@ void BotPlayer::displayDecision(const BotDecision& decision) const {
     if (decision.amount > 0) {
         std::cout << " $" << decision.amount;
     }
-    std::cout << " - " << decision.reasoning << std::endl;
+    std::cout << " - " << decision.reasoning;
+    if (config.useEquity) {
+        std::cout << std::fixed << std::setprecision(3) << " (эквити " << lastEquity.mean
+                  << " ± " << lastEquity.halfWidth << ", выборок: " << lastEquity.samples << ")"
+                  << std::defaultfloat;
+    }
+    std::cout << std::endl;
 }
 
 bool BotPlayer::canAffordBet(int amount) const {
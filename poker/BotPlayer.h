@@ -2,6 +2,9 @@
 #define POKER_BOTPLAYER_H
 
 #include "Player.h"
+#include "MonteCarlo.h"
+#include "HudStats.h"
+#include <memory>
 #include <vector>
 #include <string>
 #include <random>
@@ -17,20 +20,44 @@ enum class BotAction {
 struct BotDecision {
     BotAction action;
     int amount;
-    std::string reasoning;
+    const char* reasoning;
+};
+
+// Параметры стиля игры бота; по умолчанию - агрессивный бот из консольной игры.
+struct BotConfig {
+    double allInThreshold = 0.6;   // сила руки, с которой бот думает о ва-банке
+    double allInFrequency = 0.7;   // доля ва-банков среди таких рук
+    double raiseThreshold = 0.1;   // сила руки для рейза, ниже - колл
+    double raisePotFraction = 0.75;
+    int minRaise = 30;
+    bool useEquity = false;        // сила руки - эквити против случайной руки (Монте-Карло)
+    double equityPrecision = 0.02; // полуширина интервала, на которой оценка останавливается
+    SamplingMethod sampling = SamplingMethod::QUASI_RANDOM;
+    double cbetFoldThreshold = 0.6; // контбет со слабой рукой, если соперники сбрасывают на него чаще
+
+    // "allin=0.6,freq=0.7,raise=0.1,pot=0.75,min=30,equity=1,precision=0.02,cbet=0.6,
+    // sampling=random|stratified|quasi" (любой поднабор ключей);
+    // false при неизвестном ключе или ошибке формата
+    static bool parse(const std::string& text, BotConfig& config);
 };
 
 class BotPlayer : public Player {
 private:
+    static constexpr uint32_t MIN_CBET_SAMPLES = 5;  // меньше ответов на контбет - не доверяем доле
+
     int bankroll;
     int currentBet;
     std::mt19937 rng;
+    BotConfig config;
+    MonteCarloResult lastEquity;
+    std::shared_ptr<const HudStats> hudStats;
     
-    BotDecision makeDecision(const std::vector<Card>& communityCards, 
+    BotDecision makeDecision(CardSpan communityCards, 
                              int potAmount, int currentBet, int maxBet);
-    double evaluateHandStrength(const std::vector<Card>& hand, 
-                               const std::vector<Card>& communityCards);
+    double evaluateHandStrength(CardSpan hand, 
+                               CardSpan communityCards);
     int calculateRaiseAmount(double handStrength, int potAmount);
+    bool shouldContinuationBet(CardSpan communityCards, int currentBet) const;
     int getRandomAmount(int min, int max);
     double getRandomDouble(double min, double max);
     std::string getActionString(BotAction action) const;
@@ -39,11 +66,19 @@ public:
     BotPlayer(const std::string& name);
     BotPlayer(const std::string& name, int initialBankroll);
     
+    void setSeed(unsigned seed);
+    void setConfig(const BotConfig& botConfig);
+    const BotConfig& getConfig() const;
+    // Последняя оценка эквити (при useEquity) с достигнутой точностью
+    const MonteCarloResult& getLastEquity() const;
+    // Статистика соперников за столом; без неё бот играет только от силы руки
+    void setHudStats(std::shared_ptr<const HudStats> stats);
+    const std::shared_ptr<const HudStats>& getHudStats() const;
     void setBankroll(int amount);
     int getBankroll() const;
     void setCurrentBet(int bet);
     int getCurrentBet() const;
-    BotDecision getAction(const std::vector<Card>& communityCards, 
+    BotDecision getAction(CardSpan communityCards, 
                          int potAmount, int currentBet, int maxBet);
     void displayDecision(const BotDecision& decision) const;
     bool canAffordBet(int amount) const;
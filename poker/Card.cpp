@@ -1,15 +1,36 @@
 #include "Card.h"
 
-#include <utility>
+namespace {
+    const char* const RANK_NAMES[] = { "2", "3", "4", "5", "6", "7", "8", "9", "10", "Валет", "Дама", "Король", "Туз" };
+    const char* const SUIT_NAMES[] = { "Пики", "Червы", "Бубны", "Трефы" };
+
+    int rankFromName(const std::string& rank) {
+        for (int i = 0; i < 13; i++) {
+            if (rank == RANK_NAMES[i]) return i + 2;
+        }
+        if (rank == "J") return 11;
+        if (rank == "Q") return 12;
+        if (rank == "K") return 13;
+        if (rank == "A") return 14;
+        return 2;
+    }
+
+    int suitFromName(const std::string& suit) {
+        for (int i = 0; i < 4; i++) {
+            if (suit == SUIT_NAMES[i]) return i;
+        }
+        return 0;
+    }
+}
 
 Card::Card(std::string cardRank, std::string cardSuit)
-        : rank(std::move(cardRank)), suit(std::move(cardSuit)) {
+        : Card(rankFromName(cardRank), suitFromName(cardSuit)) {
 }
 
 std::string Card::getRank() const {
-    return rank;
+    return RANK_NAMES[code / 4];
 }
 
 std::string Card::getSuit() const {
-    return suit;
+    return SUIT_NAMES[code % 4];
 }
@@ -2,15 +2,35 @@
 #define POKER_CARD_H
 
 #include <string>
+#include <cstdint>
+#include "StaticVector.h"
 
+// Карта хранится в одном байте: code = (rankValue - 2) * 4 + suitIndex.
+// rankValue: 2..14 (Туз = 14), suitIndex: 0 - Пики, 1 - Червы, 2 - Бубны, 3 - Трефы.
 class Card {
 private:
-     std::string rank;
-     std::string suit;
+    uint8_t code;
 public:
+    static constexpr int DECK_SIZE = 52;
+
+    Card() : code(0) {}
     Card(std::string cardRank, std::string cardSuit);
+    Card(int rankValue, int suitIndex)
+        : code(static_cast<uint8_t>((rankValue - 2) * 4 + suitIndex)) {}
     [[nodiscard]] std::string getRank() const;
     [[nodiscard]] std::string getSuit() const;
+    [[nodiscard]] int getRankValue() const { return code / 4 + 2; }
+    [[nodiscard]] int getSuitIndex() const { return code % 4; }
+    [[nodiscard]] uint8_t getCode() const { return code; }
+    static Card fromCode(uint8_t cardCode) { return Card(cardCode / 4 + 2, cardCode % 4); }
+
+    bool operator==(const Card& other) const { return code == other.code; }
+    bool operator!=(const Card& other) const { return code != other.code; }
 };
 
+using CardSpan = Span<const Card>;
+using HoleCards = StaticVector<Card, 4>;   // карманные карты, до 4 (Омаха)
+using BoardCards = StaticVector<Card, 5>;  // общие карты стола
+using HandCards = StaticVector<Card, 9>;   // карманные + общие, для оценки руки
+
 #endif
@@ -0,0 +1,233 @@
+#include "CardNotation.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    constexpr uint8_t INVALID = 0xFF;
+    constexpr char RANK_CHARS[] = "23456789TJQKA";
+    constexpr char SUIT_CHARS[] = "shdc";
+
+    constexpr std::array<uint8_t, 256> makeRankTable() {
+        std::array<uint8_t, 256> table{};
+        for (auto& entry : table) entry = INVALID;
+        for (uint8_t i = 0; i < 13; i++) {
+            char c = RANK_CHARS[i];
+            table[static_cast<unsigned char>(c)] = i;
+            if (c >= 'A' && c <= 'Z') {
+                table[static_cast<unsigned char>(c - 'A' + 'a')] = i;
+            }
+        }
+        return table;
+    }
+
+    constexpr std::array<uint8_t, 256> makeSuitTable() {
+        std::array<uint8_t, 256> table{};
+        for (auto& entry : table) entry = INVALID;
+        for (uint8_t i = 0; i < 4; i++) {
+            char c = SUIT_CHARS[i];
+            table[static_cast<unsigned char>(c)] = i;
+            table[static_cast<unsigned char>(c - 'a' + 'A')] = i;
+        }
+        return table;
+    }
+
+    constexpr std::array<uint8_t, 256> RANK_TABLE = makeRankTable();
+    constexpr std::array<uint8_t, 256> SUIT_TABLE = makeSuitTable();
+
+    // Код карты по двум символам или INVALID. Без ветвлений: ошибка любой из
+    // половин выставляет старший бит результата.
+    inline uint8_t decode(const char* p) {
+        uint8_t rank = RANK_TABLE[static_cast<unsigned char>(p[0])];
+        uint8_t suit = SUIT_TABLE[static_cast<unsigned char>(p[1])];
+        uint8_t code = static_cast<uint8_t>(rank * 4 + suit);
+        return ((rank | suit) & 0x80) ? INVALID : code;
+    }
+
+    inline bool isSeparator(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == ',';
+    }
+
+    const size_t CHUNK_SIZE = 1 << 20;
+}
+
+void HandBatch::clear() {
+    codes.clear();
+    offsets.assign(1, 0);
+}
+
+std::from_chars_result CardNotation::parseCard(const char* first, const char* last, Card& card) {
+    if (last - first < 2) {
+        return { first, std::errc::invalid_argument };
+    }
+    uint8_t code = decode(first);
+    if (code == INVALID) {
+        return { first, std::errc::invalid_argument };
+    }
+    card = Card::fromCode(code);
+    return { first + 2, std::errc() };
+}
+
+std::from_chars_result CardNotation::parseCards(const char* first, const char* last, Span<Card> cards, size_t& count) {
+    count = 0;
+    const char* p = first;
+    while (p < last) {
+        if (isSeparator(*p)) {
+            p++;
+            continue;
+        }
+        Card card = Card::fromCode(0);
+        auto result = parseCard(p, last, card);
+        if (result.ec != std::errc()) {
+            return result;
+        }
+        if (count == cards.size()) {
+            return { p, std::errc::value_too_large };
+        }
+        cards[count++] = card;
+        p = result.ptr;
+    }
+    return { p, std::errc() };
+}
+
+std::to_chars_result CardNotation::formatCard(char* first, char* last, const Card& card) {
+    if (last - first < 2) {
+        return { last, std::errc::value_too_large };
+    }
+    first[0] = RANK_CHARS[card.getCode() / 4];
+    first[1] = SUIT_CHARS[card.getCode() % 4];
+    return { first + 2, std::errc() };
+}
+
+std::to_chars_result CardNotation::formatCards(char* first, char* last, const Card* cards, size_t count) {
+    if (static_cast<size_t>(last - first) < count * 2) {
+        return { last, std::errc::value_too_large };
+    }
+    for (size_t i = 0; i < count; i++) {
+        first[2 * i] = RANK_CHARS[cards[i].getCode() / 4];
+        first[2 * i + 1] = SUIT_CHARS[cards[i].getCode() % 4];
+    }
+    return { first + count * 2, std::errc() };
+}
+
+std::vector<Card> CardNotation::fromString(const std::string& text) {
+    // Карт не больше половины символов
+    std::vector<Card> cards(text.size() / 2);
+    size_t count = 0;
+    auto result = parseCards(text.data(), text.data() + text.size(), cards, count);
+    cards.resize(result.ec == std::errc() ? count : 0);
+    return cards;
+}
+
+std::string CardNotation::toString(const Card& card) {
+    std::string text(2, ' ');
+    formatCard(&text[0], &text[0] + text.size(), card);
+    return text;
+}
+
+std::string CardNotation::toString(CardSpan cards) {
+    std::string text(cards.size() * 2, ' ');
+    formatCards(&text[0], &text[0] + text.size(), cards.data(), cards.size());
+    return text;
+}
+
+std::from_chars_result CardNotation::parseBatch(const char* first, const char* last, HandBatch& batch) {
+    // Карт не может быть больше половины входа: размечаем буфер один раз
+    // и пишем в него напрямую, без push_back на каждую карту.
+    size_t start = batch.codes.size();
+    batch.codes.resize(start + static_cast<size_t>(last - first) / 2);
+    uint8_t* out = batch.codes.data() + start;
+    uint8_t* handBegin = out;
+
+    const char* p = first;
+    while (p < last) {
+        if (p + 1 < last) {
+            uint8_t code = decode(p);
+            if (code != INVALID) {
+                *out++ = code;
+                p += 2;
+                continue;
+            }
+        }
+        char c = *p;
+        if (c == '\n') {
+            if (out != handBegin) {
+                batch.offsets.push_back(static_cast<uint32_t>(out - batch.codes.data()));
+                handBegin = out;
+            }
+        } else if (!isSeparator(c)) {
+            batch.codes.resize(handBegin - batch.codes.data());
+            return { p, std::errc::invalid_argument };
+        }
+        p++;
+    }
+    if (out != handBegin) {
+        batch.offsets.push_back(static_cast<uint32_t>(out - batch.codes.data()));
+    }
+    batch.codes.resize(out - batch.codes.data());
+    return { p, std::errc() };
+}
+
+std::string CardNotation::formatBatch(const HandBatch& batch) {
+    std::string text(batch.codes.size() * 2 + batch.getHandCount(), '\n');
+    char* out = &text[0];
+    for (size_t hand = 0; hand < batch.getHandCount(); hand++) {
+        const uint8_t* codes = batch.getHand(hand);
+        size_t count = batch.getCardCount(hand);
+        for (size_t i = 0; i < count; i++) {
+            *out++ = RANK_CHARS[codes[i] / 4];
+            *out++ = SUIT_CHARS[codes[i] % 4];
+        }
+        out++;
+    }
+    return text;
+}
+
+bool CardNotation::loadBatch(const std::string& filename, HandBatch& batch) {
+    std::ifstream inFile(filename, std::ios::binary);
+    if (!inFile.is_open()) {
+        std::cout << "Ошибка: Не удалось открыть файл " << filename << " для чтения" << std::endl;
+        return false;
+    }
+
+    // Читаем файл блоками и разбираем до последнего перевода строки,
+    // хвост неполной строки переносим в начало следующего блока.
+    std::vector<char> buffer(CHUNK_SIZE);
+    size_t carry = 0;
+    while (true) {
+        if (carry == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        inFile.read(buffer.data() + carry, static_cast<std::streamsize>(buffer.size() - carry));
+        size_t filled = carry + static_cast<size_t>(inFile.gcount());
+        bool atEnd = !inFile;
+
+        size_t parseEnd = filled;
+        if (!atEnd) {
+            while (parseEnd > 0 && buffer[parseEnd - 1] != '\n') parseEnd--;
+        }
+
+        auto result = parseBatch(buffer.data(), buffer.data() + parseEnd, batch);
+        if (result.ec != std::errc()) {
+            std::cout << "Ошибка: Некорректная запись карт в файле " << filename << std::endl;
+            return false;
+        }
+
+        if (atEnd) break;
+        carry = filled - parseEnd;
+        std::copy(buffer.begin() + parseEnd, buffer.begin() + filled, buffer.begin());
+    }
+    return true;
+}
+
+bool CardNotation::saveBatch(const std::string& filename, const HandBatch& batch) {
+    std::ofstream outFile(filename, std::ios::binary);
+    if (!outFile.is_open()) {
+        std::cout << "Ошибка: Не удалось открыть файл " << filename << " для записи" << std::endl;
+        return false;
+    }
+    std::string text = formatBatch(batch);
+    outFile.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return true;
+}
@@ -0,0 +1,46 @@
+#ifndef POKER_CARDNOTATION_H
+#define POKER_CARDNOTATION_H
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Card.h"
+
+// Пакет раздач в компактной нотации: коды карт всех рук подряд,
+// offsets[i]..offsets[i + 1] - карты i-й руки.
+struct HandBatch {
+    std::vector<uint8_t> codes;
+    std::vector<uint32_t> offsets;
+
+    HandBatch() : offsets(1, 0) {}
+    size_t getHandCount() const { return offsets.size() - 1; }
+    size_t getCardCount(size_t hand) const { return offsets[hand + 1] - offsets[hand]; }
+    const uint8_t* getHand(size_t hand) const { return codes.data() + offsets[hand]; }
+    void clear();
+};
+
+// Стандартная нотация карт: ранг "23456789TJQKA" + масть "shdc" ("AsKh", "Td9d8c").
+// parse/format в стиле std::from_chars / std::to_chars: без исключений и аллокаций,
+// результат пишется в буфер вызывающего. fromString/toString и пакетный режим выделяют память.
+class CardNotation {
+public:
+    static std::from_chars_result parseCard(const char* first, const char* last, Card& card);
+    // Карты (разделители - пробелы и запятые) в cards, count - сколько записано.
+    // Карта, не поместившаяся в cards, - value_too_large, ptr указывает на неё.
+    static std::from_chars_result parseCards(const char* first, const char* last, Span<Card> cards, size_t& count);
+    static std::to_chars_result formatCard(char* first, char* last, const Card& card);
+    static std::to_chars_result formatCards(char* first, char* last, const Card* cards, size_t count);
+
+    static std::vector<Card> fromString(const std::string& text);
+    static std::string toString(const Card& card);
+    static std::string toString(CardSpan cards);
+
+    // Пакетный режим: одна рука на строку, карты внутри строки могут разделяться пробелами.
+    static std::from_chars_result parseBatch(const char* first, const char* last, HandBatch& batch);
+    static std::string formatBatch(const HandBatch& batch);
+    static bool loadBatch(const std::string& filename, HandBatch& batch);
+    static bool saveBatch(const std::string& filename, const HandBatch& batch);
+};
+
+#endif
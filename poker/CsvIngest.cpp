@@ -0,0 +1,89 @@
+#include "CsvIngest.h"
+#include <ctime>
+#include <thread>
+
+TimestampParser::TimestampParser() : cachedHourKey(-1), cachedHourMs(0) {
+}
+
+bool TimestampParser::parse(std::string_view text, int64_t& timeMs) {
+    // ГГГГ-ММ-ДД ЧЧ:ММ:СС или ГГГГ-ММ-ДД ЧЧ:ММ:СС.ммм
+    int milliseconds = 0;
+    if (text.size() == 23) {
+        if (text[19] != '.' || !CsvIngest::parseNumber(text.substr(20, 3), milliseconds) || milliseconds < 0) {
+            return false;
+        }
+        text.remove_suffix(4);
+    }
+    if (text.size() != 19 || text[4] != '-' || text[7] != '-' || text[10] != ' ' ||
+        text[13] != ':' || text[16] != ':') {
+        return false;
+    }
+    int year, month, day, hour, minute, second;
+    if (!CsvIngest::parseNumber(text.substr(0, 4), year) || !CsvIngest::parseNumber(text.substr(5, 2), month) ||
+        !CsvIngest::parseNumber(text.substr(8, 2), day) || !CsvIngest::parseNumber(text.substr(11, 2), hour) ||
+        !CsvIngest::parseNumber(text.substr(14, 2), minute) || !CsvIngest::parseNumber(text.substr(17, 2), second)) {
+        return false;
+    }
+
+    int64_t hourKey = ((int64_t(year) * 12 + month) * 31 + day) * 24 + hour;
+    if (hourKey != cachedHourKey) {
+        std::tm time = {};
+        time.tm_year = year - 1900;
+        time.tm_mon = month - 1;
+        time.tm_mday = day;
+        time.tm_hour = hour;
+        time.tm_isdst = -1;
+        std::time_t seconds = std::mktime(&time);
+        if (seconds == static_cast<std::time_t>(-1)) {
+            return false;
+        }
+        cachedHourKey = hourKey;
+        cachedHourMs = int64_t(seconds) * 1000;
+    }
+    timeMs = cachedHourMs + (int64_t(minute) * 60 + second) * 1000 + milliseconds;
+    return true;
+}
+
+bool CsvIngest::splitFields(std::string_view line, std::string_view* fields, size_t count,
+                            size_t stretchField, std::vector<uint32_t>& commas) {
+    commas.clear();
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        if (line[i] == '"') {
+            quoted = !quoted;
+        } else if (line[i] == ',' && !quoted) {
+            commas.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    if (commas.size() + 1 < count) {
+        return false;
+    }
+
+    size_t extra = commas.size() + 1 - count;
+    for (size_t k = 0; k < count; k++) {
+        size_t begin = k == 0 ? 0 : commas[k - 1 + (k > stretchField ? extra : 0)] + 1;
+        size_t end = k + 1 == count ? line.size() : commas[k + (k >= stretchField ? extra : 0)];
+        std::string_view field = line.substr(begin, end - begin);
+        if (field.size() >= 2 && field.front() == '"' && field.back() == '"') {
+            field = field.substr(1, field.size() - 2);
+        }
+        fields[k] = field;
+    }
+    return true;
+}
+
+std::string CsvIngest::unescape(std::string_view field) {
+    std::string value;
+    value.reserve(field.size());
+    for (size_t i = 0; i < field.size(); i++) {
+        value += field[i];
+        if (field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"') {
+            i++;
+        }
+    }
+    return value;
+}
+
+unsigned CsvIngest::getSlotCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
@@ -0,0 +1,127 @@
+#ifndef POKER_CSVINGEST_H
+#define POKER_CSVINGEST_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ThreadPool.h"
+
+// Перевод "ГГГГ-ММ-ДД ЧЧ:ММ:СС" (местное время) в мс от эпохи. mktime вызывается
+// раз на час, остальное - арифметика. Свой экземпляр на каждый поток.
+class TimestampParser {
+private:
+    int64_t cachedHourKey;
+    int64_t cachedHourMs;
+
+public:
+    TimestampParser();
+    bool parse(std::string_view text, int64_t& timeMs);
+};
+
+// Потоковое чтение CSV: файл идёт окнами по chunkSize байт на поток, окно режется
+// на куски по границам строк, куски разбираются параллельно и сливаются по порядку.
+// В памяти только текущее окно, сколько бы ни весил файл.
+// Поля в кавычках могут содержать запятые и "" (кавычку), но не переводы строк.
+class CsvIngest {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+    // Делит строку на count полей. Лишние запятые вне кавычек достаются полю stretchField:
+    // старые файлы писали заметки и описания без экранирования. fields - без внешних кавычек;
+    // commas - рабочий буфер вызывающего. false, если полей меньше count.
+    static bool splitFields(std::string_view line, std::string_view* fields, size_t count,
+                            size_t stretchField, std::vector<uint32_t>& commas);
+    // Значение поля: "" внутри кавычек превращается в "
+    static std::string unescape(std::string_view field);
+
+    template <typename T>
+    static bool parseNumber(std::string_view text, T& value) {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    // f(line) для каждой строки текста, без '\r' в конце
+    template <typename F>
+    static void forEachLine(std::string_view text, F f) {
+        while (!text.empty()) {
+            size_t end = text.find('\n');
+            std::string_view line = text.substr(0, end);
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            f(line);
+            if (end == std::string_view::npos) break;
+            text.remove_prefix(end + 1);
+        }
+    }
+
+    // Читает file с позиции offset. parse(slot, text) разбирает кусок целых строк в
+    // состояние slot (0..getSlotCount()-1) и может идти параллельно с другими кусками;
+    // merge(slot) забирает результат в хранилище в порядке файла.
+    template <typename Parse, typename Merge>
+    static bool ingest(const std::string& file, std::streamoff offset, unsigned slots,
+                       Parse parse, Merge merge, size_t chunkSize = DEFAULT_CHUNK_SIZE) {
+        std::ifstream inFile(file, std::ios::binary);
+        if (!inFile.is_open()) return false;
+        inFile.seekg(offset);
+        slots = std::max(1u, slots);
+        chunkSize = std::max<size_t>(1, chunkSize);
+
+        std::unique_ptr<ThreadPool> pool;
+        std::string window;
+        std::vector<std::string_view> chunks;
+        bool finished = false;
+        while (!finished) {
+            // Окно продолжает недочитанную строку прошлого
+            size_t carried = window.size();
+            size_t readSize = std::max(slots * chunkSize, carried);
+            window.resize(carried + readSize);
+            inFile.read(&window[carried], static_cast<std::streamsize>(readSize));
+            window.resize(carried + static_cast<size_t>(inFile.gcount()));
+            finished = inFile.eof() || !inFile;
+
+            size_t end = window.size();
+            if (!finished) {
+                size_t lastNewline = window.rfind('\n');
+                if (lastNewline == std::string::npos) continue;  // строка длиннее окна
+                end = lastNewline + 1;
+            }
+
+            std::string_view text(window.data(), end);
+            chunks.clear();
+            size_t target = std::max<size_t>(1, text.size() / slots);
+            while (!text.empty()) {
+                size_t cut = chunks.size() + 1 == slots ? std::string_view::npos : text.find('\n', target);
+                cut = cut == std::string_view::npos ? text.size() : cut + 1;
+                chunks.push_back(text.substr(0, cut));
+                text.remove_prefix(cut);
+            }
+
+            if (chunks.size() == 1) {
+                parse(size_t(0), chunks[0]);
+            } else {
+                if (!pool) pool = std::make_unique<ThreadPool>(slots);
+                for (size_t i = 0; i < chunks.size(); i++) {
+                    std::string_view chunk = chunks[i];
+                    pool->submit([&parse, i, chunk](unsigned) { parse(i, chunk); });
+                }
+                pool->wait();
+            }
+            for (size_t i = 0; i < chunks.size(); i++) {
+                merge(i);
+            }
+            window.erase(0, end);
+        }
+        return true;
+    }
+
+    // Число кусков окна: по потоку на кусок
+    static unsigned getSlotCount();
+};
+
+#endif
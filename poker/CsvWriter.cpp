@@ -0,0 +1,144 @@
+#include "CsvWriter.h"
+#include <charconv>
+#include <ctime>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+void putTwoDigits(char* out, int value) {
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+}
+
+int64_t floorDiv(int64_t value, int64_t divisor) {
+    int64_t quotient = value / divisor;
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+}
+
+TimestampFormatter::TimestampFormatter()
+    : hourStart(std::numeric_limits<int64_t>::min()), lastSecond(std::numeric_limits<int64_t>::min()), text() {
+}
+
+std::string_view TimestampFormatter::format(int64_t timeMs) {
+    int64_t second = floorDiv(timeMs, 1000);
+    if (second == lastSecond) {
+        return std::string_view(text, 19);
+    }
+    if (second < hourStart || second >= hourStart + 3600) {
+        std::time_t seconds = static_cast<std::time_t>(second);
+        std::tm local = {};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+        hourStart = second - (local.tm_min * 60 + local.tm_sec);
+    }
+    int64_t inHour = second - hourStart;
+    putTwoDigits(text + 14, static_cast<int>(inHour / 60));
+    putTwoDigits(text + 17, static_cast<int>(inHour % 60));
+    lastSecond = second;
+    return std::string_view(text, 19);
+}
+
+std::string_view TimestampFormatter::formatMs(int64_t timeMs) {
+    format(timeMs);
+    int milliseconds = static_cast<int>(timeMs - floorDiv(timeMs, 1000) * 1000);
+    text[19] = '.';
+    text[20] = static_cast<char>('0' + milliseconds / 100);
+    putTwoDigits(text + 21, milliseconds % 100);
+    return std::string_view(text, 23);
+}
+
+CsvWriter::CsvWriter(size_t size) : bufferSize(size), rowStarted(false), startedEmpty(true) {
+}
+
+CsvWriter::~CsvWriter() {
+    close();
+}
+
+bool CsvWriter::open(const std::string& file, bool append) {
+    close();
+    out.open(file, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+    if (!out.is_open()) {
+        std::cout << "Ошибка: Не удалось открыть файл " << file << " для записи" << std::endl;
+        return false;
+    }
+    out.seekp(0, std::ios::end);
+    startedEmpty = out.tellp() <= 0;
+    buffer.clear();
+    buffer.reserve(bufferSize + 256);
+    rowStarted = false;
+    return true;
+}
+
+bool CsvWriter::startedEmptyFile() const {
+    return startedEmpty;
+}
+
+void CsvWriter::beginField() {
+    if (rowStarted) {
+        buffer += ',';
+    }
+    rowStarted = true;
+}
+
+void CsvWriter::addField(std::string_view text) {
+    beginField();
+    if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+        buffer.append(text.data(), text.size());
+        return;
+    }
+    bool quote = text.find_first_of(",\"") != std::string_view::npos;
+    if (quote) buffer += '"';
+    for (char c : text) {
+        if (c == '"') {
+            buffer += "\"\"";
+        } else {
+            buffer += (c == '\r' || c == '\n') ? ' ' : c;
+        }
+    }
+    if (quote) buffer += '"';
+}
+
+void CsvWriter::addField(int64_t value) {
+    beginField();
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+void CsvWriter::addTimestamp(int64_t timeMs, bool milliseconds) {
+    beginField();
+    std::string_view text = milliseconds ? timestamps.formatMs(timeMs) : timestamps.format(timeMs);
+    buffer.append(text.data(), text.size());
+}
+
+void CsvWriter::endRow() {
+    buffer += '\n';
+    rowStarted = false;
+    if (buffer.size() >= bufferSize) {
+        flush();
+    }
+}
+
+void CsvWriter::addLine(std::string_view line) {
+    buffer.append(line.data(), line.size());
+    endRow();
+}
+
+void CsvWriter::flush() {
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+bool CsvWriter::close() {
+    if (!out.is_open()) return true;
+    flush();
+    out.close();
+    return !out.fail();
+}
@@ -0,0 +1,68 @@
+#ifndef POKER_CSVWRITER_H
+#define POKER_CSVWRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+// "ГГГГ-ММ-ДД ЧЧ:ММ:СС" в местном времени. localtime вызывается при смене часа,
+// внутри часа меняются только цифры минут и секунд.
+class TimestampFormatter {
+private:
+    int64_t hourStart;   // секунды от эпохи
+    int64_t lastSecond;
+    char text[24];
+
+public:
+    TimestampFormatter();
+    std::string_view format(int64_t timeMs);
+    // "ГГГГ-ММ-ДД ЧЧ:ММ:СС.ммм"
+    std::string_view formatMs(int64_t timeMs);
+};
+
+// Место, до которого история (ставок, транзакций) уже выгружена: номер следующей
+// записи. Номера только растут, поэтому курсор переживает удаление и перезагрузку.
+struct ExportCursor {
+    uint64_t sequence = 0;
+};
+
+// Запись CSV через большой буфер: строки копятся в памяти и уходят в файл блоками.
+// Поля с запятой или кавычкой берутся в кавычки ("" внутри); переводы строк в поле
+// заменяются пробелом, чтобы запись оставалась одной строкой файла (см. CsvIngest).
+class CsvWriter {
+private:
+    std::ofstream out;
+    std::string buffer;
+    size_t bufferSize;
+    bool rowStarted;
+    bool startedEmpty;
+    TimestampFormatter timestamps;
+
+    void beginField();
+    void flush();
+
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    explicit CsvWriter(size_t size = DEFAULT_BUFFER_SIZE);
+    ~CsvWriter();
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+
+    // append - дописывать в конец файла вместо перезаписи
+    bool open(const std::string& file, bool append = false);
+    // Файл был пуст при открытии: пора писать заголовок
+    bool startedEmptyFile() const;
+
+    void addField(std::string_view text);
+    void addField(int64_t value);
+    // milliseconds - дописать ".ммм", чтобы файл хранил время без потерь
+    void addTimestamp(int64_t timeMs, bool milliseconds = false);
+    void endRow();
+    // Строка как есть, без экранирования
+    void addLine(std::string_view line);
+    bool close();
+};
+
+#endif
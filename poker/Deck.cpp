@@ -1,43 +1,47 @@
 #include "Deck.h"
+#include <cstdlib>
 #include <ctime>
+#include <utility>
 
 Deck::Deck() {
-    std::string ranks[] = { "2", "3", "4", "5", "6", "7", "8", "9", "10", "Валет", "Дама", "Король", "Туз" };
-    std::string suits[] = { "Пики", "Червы", "Бубны", "Трефы" };
+    fillDeck();
+}
 
-    for (const auto & suit : suits) {
-        for (const auto & rank : ranks) {
-            Card card(rank, suit);
-            cards.push_back(card);
+void Deck::fillDeck() {
+    remaining = 0;
+    for (int suit = 0; suit < 4; suit++) {
+        for (int rank = 2; rank <= 14; rank++) {
+            cards[remaining++] = Card(rank, suit);
         }
     }
 }
 
 void Deck::resetDeck() {
-    cards.clear();
-    std::string ranks[] = { "2", "3", "4", "5", "6", "7", "8", "9", "10", "Валет", "Дама", "Король", "Туз" };
-    std::string suits[] = { "Пики", "Червы", "Бубны", "Трефы" };
-
-    for (const auto & suit : suits) {
-        for (const auto & rank : ranks) {
-            Card card(rank, suit);
-            cards.push_back(card);
-        }
-    }
+    fillDeck();
     shuffle();
 }
 
+void Deck::resetDeck(std::mt19937& rng) {
+    fillDeck();
+    shuffle(rng);
+}
+
 void Deck::shuffle() {
     srand(time(nullptr));
-    for (auto & card : cards) {
-        unsigned long long j = rand() % cards.size();
-        std::swap(card, cards[j]);
+    for (int i = 0; i < remaining; i++) {
+        int j = rand() % remaining;
+        std::swap(cards[i], cards[j]);
     }
 
 }
 
+void Deck::shuffle(std::mt19937& rng) {
+    for (int i = remaining - 1; i > 0; i--) {
+        std::uniform_int_distribution<int> dist(0, i);
+        std::swap(cards[i], cards[dist(rng)]);
+    }
+}
+
 Card Deck::dealCard() {
-    Card card = cards.back();
-    cards.pop_back();
-    return card;
-}
\ No newline at end of file
+    return cards[--remaining];
+}
@@ -1,22 +1,28 @@
 #ifndef POKER_DECK_H
 #define POKER_DECK_H
 
-#include <vector>
+#include <array>
+#include <random>
 #include "Card.h"
 
 class Deck {
 private:
-    std::vector<Card> cards;
+    std::array<Card, Card::DECK_SIZE> cards;
+    int remaining;
+
+    void fillDeck();
 
 public:
 
     Deck();
     void resetDeck();
+    void resetDeck(std::mt19937& rng);
     void shuffle();
+    void shuffle(std::mt19937& rng);
     Card dealCard();
-    int getRemainingCards() const { return cards.size(); }
-    bool isEmpty() const { return cards.empty(); }
+    int getRemainingCards() const { return remaining; }
+    bool isEmpty() const { return remaining == 0; }
 
 };
 
-#endif
\ No newline at end of file
+#endif
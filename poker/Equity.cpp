@@ -0,0 +1,377 @@
+#include "Equity.h"
+#include "RulesEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    // За столом не больше MAX_SEATS мест: герой и до MAX_OPPONENTS соперников
+    constexpr int MAX_OPPONENTS = MAX_SEATS - 1;
+    constexpr int MAX_DRAW = 5 + 2 * MAX_OPPONENTS;
+
+    // Раздача, эквити которой оцениваем: известные карты и то, что осталось досдать
+    struct Spot {
+        CardMask hero;
+        CardMask villain;          // 0 - соперники случайные
+        CardMask board;
+        int missing;               // сколько карт борда досдать
+        int opponents;             // случайных соперников
+        int live[Card::DECK_SIZE];
+        int liveCount;
+        unsigned heroRanks;        // ранги карманных карт (для страт)
+        unsigned villainRanks;
+        int boardSuits[4];
+
+        int getDrawCount() const {
+            return missing + 2 * opponents;
+        }
+    };
+
+    // Колода без мёртвых карт в виде массива кодов
+    int collectLive(CardMask dead, int* live) {
+        int count = 0;
+        for (int code = 0; code < Card::DECK_SIZE; code++) {
+            if (!(dead & (CardMask(1) << code))) {
+                live[count++] = code;
+            }
+        }
+        return count;
+    }
+
+    unsigned rankBits(CardMask cards) {
+        unsigned bits = 0;
+        for (int code = 0; code < Card::DECK_SIZE; code++) {
+            if (cards & (CardMask(1) << code)) bits |= 1u << (code / 4);
+        }
+        return bits;
+    }
+
+    Spot makeSpot(CardMask hero, CardMask villain, CardMask board, int opponents) {
+        Spot spot;
+        spot.hero = hero;
+        spot.villain = villain;
+        spot.board = board;
+        spot.missing = 5 - Equity::countCards(board);
+        spot.liveCount = collectLive(hero | villain | board, spot.live);
+        int maxOpponents = std::min(MAX_OPPONENTS, (spot.liveCount - spot.missing) / 2);
+        spot.opponents = villain ? 0 : std::max(1, std::min(opponents, maxOpponents));
+        spot.heroRanks = rankBits(hero);
+        spot.villainRanks = rankBits(villain);
+        for (int suit = 0; suit < 4; suit++) {
+            spot.boardSuits[suit] = 0;
+        }
+        for (int code = 0; code < Card::DECK_SIZE; code++) {
+            if (board & (CardMask(1) << code)) spot.boardSuits[code % 4]++;
+        }
+        return spot;
+    }
+
+    // Исход одной досдачи: первые missing карт - борд, дальше по две на соперника
+    double playout(const Spot& spot, const int* cards) {
+        CardMask runout = spot.board;
+        for (int i = 0; i < spot.missing; i++) {
+            runout |= CardMask(1) << cards[i];
+        }
+        int heroScore = HandEvaluator::evaluateMask(spot.hero | runout);
+        if (spot.villain) {
+            int villainScore = HandEvaluator::evaluateMask(spot.villain | runout);
+            return heroScore > villainScore ? 1.0 : (heroScore == villainScore ? 0.5 : 0.0);
+        }
+
+        int best = 0;
+        int tied = 0;
+        for (int opponent = 0; opponent < spot.opponents; opponent++) {
+            const int* hole = cards + spot.missing + 2 * opponent;
+            int score = HandEvaluator::evaluateMask((CardMask(1) << hole[0]) | (CardMask(1) << hole[1]) | runout);
+            if (score > best) {
+                best = score;
+                tied = 0;
+            }
+            if (score == best) tied++;
+        }
+        if (heroScore > best) return 1.0;
+        if (heroScore == best) return 1.0 / (tied + 1);
+        return 0.0;
+    }
+
+    // Частичное тасование: первые count карт массива становятся случайной выборкой
+    void drawCards(int* live, int liveCount, int count, std::mt19937& rng) {
+        for (int i = 0; i < count; i++) {
+            int j = i + static_cast<int>(rng() % static_cast<unsigned>(liveCount - i));
+            std::swap(live[i], live[j]);
+        }
+    }
+
+    double uniform(std::mt19937& rng) {
+        return (rng() >> 5) * (1.0 / 134217728.0);
+    }
+
+    MonteCarloResult estimateRandom(Spot& spot, std::mt19937& rng, const MonteCarloConfig& config) {
+        int draw = spot.getDrawCount();
+        return MonteCarlo::run([&]() {
+            drawCards(spot.live, spot.liveCount, draw, rng);
+            return playout(spot, spot.live);
+        }, config);
+    }
+
+    // Рандомизированный квази-Монте-Карло: точки Холтона в пространстве индексов
+    // оставшихся карт (координата j выбирает карту среди liveCount - j ещё не
+    // сданных), несколько копий со случайным сдвигом по модулю 1. Разброс средних
+    // по копиям даёт честную оценку погрешности.
+    MonteCarloResult estimateQuasiRandom(Spot& spot, std::mt19937& rng, const MonteCarloConfig& config) {
+        static const int PRIMES[MAX_DRAW] = {
+            2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83
+        };
+        constexpr int REPLICATES = 16;
+        // Квантиль Стьюдента для 15 степеней свободы относительно нормального (95%)
+        constexpr double STUDENT_FACTOR = 2.131 / 1.96;
+
+        int draw = spot.getDrawCount();
+        double shifts[REPLICATES][MAX_DRAW];
+        for (auto& replicate : shifts) {
+            for (int j = 0; j < draw; j++) {
+                replicate[j] = uniform(rng);
+            }
+        }
+
+        double sums[REPLICATES] = {};
+        long long points = 0;
+        long long batch = std::max(1LL, config.batchSize / REPLICATES);
+        MonteCarloResult result;
+        while (points * REPLICATES < config.maxSamples) {
+            for (long long step = 0; step < batch && points * REPLICATES < config.maxSamples; step++) {
+                points++;
+                double base[MAX_DRAW];
+                for (int j = 0; j < draw; j++) {
+                    // Обратное основанию b разложение номера точки
+                    double value = 0.0;
+                    double factor = 1.0 / PRIMES[j];
+                    for (long long n = points; n > 0; n /= PRIMES[j]) {
+                        value += factor * static_cast<double>(n % PRIMES[j]);
+                        factor /= PRIMES[j];
+                    }
+                    base[j] = value;
+                }
+                for (int r = 0; r < REPLICATES; r++) {
+                    int swapped[MAX_DRAW];
+                    for (int j = 0; j < draw; j++) {
+                        double u = base[j] + shifts[r][j];
+                        u -= std::floor(u);
+                        int index = j + std::min(static_cast<int>(u * (spot.liveCount - j)), spot.liveCount - j - 1);
+                        swapped[j] = index;
+                        std::swap(spot.live[j], spot.live[index]);
+                    }
+                    sums[r] += playout(spot, spot.live);
+                    // Откат перестановок: массив снова в исходном порядке для следующей копии
+                    for (int j = draw - 1; j >= 0; j--) {
+                        std::swap(spot.live[j], spot.live[swapped[j]]);
+                    }
+                }
+            }
+
+            RunningStats means;
+            for (double sum : sums) {
+                means.add(sum / static_cast<double>(points));
+            }
+            result.mean = means.getMean();
+            result.halfWidth = means.getHalfWidth(config.z * STUDENT_FACTOR);
+            result.samples = points * REPLICATES;
+            if (result.samples >= config.minSamples && result.halfWidth <= config.targetHalfWidth) {
+                result.converged = true;
+                break;
+            }
+        }
+        return result;
+    }
+
+    // Страта набора первых карт досдачи: сколько из них совпадает по рангу с картами
+    // героя и с картами соперника (0, 1, 2+) и сколько карт одной масти на борде (1, 2, 3+).
+    int stratumKey(const Spot& spot, const int* codes, int count) {
+        int heroHits = 0;
+        int villainHits = 0;
+        int suits[4] = { spot.boardSuits[0], spot.boardSuits[1], spot.boardSuits[2], spot.boardSuits[3] };
+        for (int i = 0; i < count; i++) {
+            unsigned rank = 1u << (codes[i] / 4);
+            heroHits += (spot.heroRanks & rank) != 0;
+            villainHits += (spot.villainRanks & rank) != 0;
+            suits[codes[i] % 4]++;
+        }
+        int flush = std::max(0, std::min(3, *std::max_element(suits, suits + 4)) - 1);
+        return std::min(heroHits, 2) * 9 + std::min(villainHits, 2) * 3 + flush;
+    }
+
+    // Стратифицированная выборка: все сочетания первых k карт борда (флоп или тёрн)
+    // раскладываются по стратам, вес страты - её доля сочетаний. Выборки делятся
+    // между стратами пропорционально весам, оценка - взвешенное среднее, дисперсия -
+    // сумма w^2 * s^2 / n по стратам.
+    MonteCarloResult estimateStratified(Spot& spot, std::mt19937& rng, const MonteCarloConfig& config) {
+        constexpr int STRATA = 27;
+        int prefix = std::min(3, spot.missing);
+        int draw = spot.getDrawCount();
+
+        std::vector<uint32_t> buckets[STRATA];
+        for (auto& bucket : buckets) {
+            bucket.reserve(1024);
+        }
+        long long total = 0;
+        int index[3] = { 0, 1, 2 };
+        while (true) {
+            int codes[3];
+            uint32_t packed = 0;
+            for (int i = 0; i < prefix; i++) {
+                codes[i] = spot.live[index[i]];
+                packed |= static_cast<uint32_t>(codes[i]) << (6 * i);
+            }
+            buckets[stratumKey(spot, codes, prefix)].push_back(packed);
+            total++;
+
+            int position = prefix - 1;
+            while (position >= 0 && index[position] == spot.liveCount - prefix + position) {
+                position--;
+            }
+            if (position < 0) break;
+            index[position]++;
+            for (int i = position + 1; i < prefix; i++) {
+                index[i] = index[i - 1] + 1;
+            }
+        }
+
+        double weights[STRATA];
+        double credit[STRATA] = {};
+        RunningStats stats[STRATA];
+        for (int h = 0; h < STRATA; h++) {
+            weights[h] = static_cast<double>(buckets[h].size()) / static_cast<double>(total);
+        }
+
+        auto sampleStratum = [&](int h) {
+            uint32_t packed = buckets[h][rng() % buckets[h].size()];
+            int cards[MAX_DRAW];
+            CardMask used = 0;
+            for (int i = 0; i < prefix; i++) {
+                cards[i] = static_cast<int>((packed >> (6 * i)) & 0x3F);
+                used |= CardMask(1) << cards[i];
+            }
+            // Остальные карты - случайно из колоды без уже выбранных
+            int rest[Card::DECK_SIZE];
+            int restCount = 0;
+            for (int i = 0; i < spot.liveCount; i++) {
+                if (!(used & (CardMask(1) << spot.live[i]))) rest[restCount++] = spot.live[i];
+            }
+            drawCards(rest, restCount, draw - prefix, rng);
+            std::copy(rest, rest + (draw - prefix), cards + prefix);
+            stats[h].add(playout(spot, cards));
+        };
+
+        MonteCarloResult result;
+        long long batch = std::max(1LL, config.batchSize);
+        long long samples = 0;
+        while (samples < config.maxSamples) {
+            for (int h = 0; h < STRATA; h++) {
+                if (buckets[h].empty()) continue;
+                credit[h] += static_cast<double>(batch) * weights[h];
+                long long take = static_cast<long long>(credit[h]);
+                // Для оценки дисперсии в страте нужно хотя бы две выборки
+                take = std::max(take, 2 - stats[h].getCount());
+                credit[h] -= static_cast<double>(take);
+                for (long long i = 0; i < take; i++) {
+                    sampleStratum(h);
+                }
+                samples += std::max(0LL, take);
+            }
+
+            double mean = 0.0;
+            double variance = 0.0;
+            for (int h = 0; h < STRATA; h++) {
+                if (stats[h].getCount() == 0) continue;
+                mean += weights[h] * stats[h].getMean();
+                variance += weights[h] * weights[h] * stats[h].getVariance() / static_cast<double>(stats[h].getCount());
+            }
+            result.mean = mean;
+            result.halfWidth = config.z * std::sqrt(variance);
+            result.samples = samples;
+            if (samples >= config.minSamples && result.halfWidth <= config.targetHalfWidth) {
+                result.converged = true;
+                break;
+            }
+        }
+        return result;
+    }
+
+    MonteCarloResult estimate(Spot& spot, std::mt19937& rng, const MonteCarloConfig& config) {
+        if (spot.missing == 0 && spot.villain) {
+            MonteCarloResult result;
+            result.mean = playout(spot, spot.live);
+            result.converged = true;
+            return result;
+        }
+        switch (config.method) {
+            case SamplingMethod::STRATIFIED:
+                if (spot.missing > 0) return estimateStratified(spot, rng, config);
+                break;
+            case SamplingMethod::QUASI_RANDOM:
+                return estimateQuasiRandom(spot, rng, config);
+            case SamplingMethod::RANDOM:
+                break;
+        }
+        return estimateRandom(spot, rng, config);
+    }
+}
+
+int Equity::countCards(CardMask cards) {
+    int count = 0;
+    while (cards) {
+        cards &= cards - 1;
+        count++;
+    }
+    return count;
+}
+
+double Equity::exactHeadsUp(CardMask hole0, CardMask hole1, CardMask board) {
+    Spot spot = makeSpot(hole0, hole1, board, 0);
+    int missing = spot.missing;
+
+    double share = 0.0;
+    long long boards = 0;
+    // Перебор сочетаний по индексам в порядке возрастания
+    int index[5];
+    for (int i = 0; i < missing; i++) {
+        index[i] = i;
+    }
+    int cards[5] = {};
+    while (true) {
+        for (int i = 0; i < missing; i++) {
+            cards[i] = spot.live[index[i]];
+        }
+        share += playout(spot, cards);
+        boards++;
+
+        int position = missing - 1;
+        while (position >= 0 && index[position] == spot.liveCount - missing + position) {
+            position--;
+        }
+        if (position < 0) break;
+        index[position]++;
+        for (int i = position + 1; i < missing; i++) {
+            index[i] = index[i - 1] + 1;
+        }
+    }
+    return share / static_cast<double>(boards);
+}
+
+MonteCarloResult Equity::headsUp(CardMask hole0, CardMask hole1, CardMask board,
+                                 std::mt19937& rng, const MonteCarloConfig& config) {
+    if (5 - countCards(board) <= 2) {
+        MonteCarloResult result;
+        result.mean = exactHeadsUp(hole0, hole1, board);
+        result.converged = true;
+        return result;
+    }
+    Spot spot = makeSpot(hole0, hole1, board, 0);
+    return estimate(spot, rng, config);
+}
+
+MonteCarloResult Equity::vsRandom(CardMask hole, CardMask board, int opponents,
+                                  std::mt19937& rng, const MonteCarloConfig& config) {
+    Spot spot = makeSpot(hole, 0, board, opponents);
+    return estimate(spot, rng, config);
+}
@@ -0,0 +1,24 @@
+#ifndef POKER_EQUITY_H
+#define POKER_EQUITY_H
+
+#include <random>
+#include "HandEvaluator.h"
+#include "MonteCarlo.h"
+
+// Эквити - доля банка, которую рука выигрывает в среднем (ничья - половина).
+class Equity {
+public:
+    // Точный перебор всех досдач борда; разумен, когда не хватает 1-2 карт
+    static double exactHeadsUp(CardMask hole0, CardMask hole1, CardMask board);
+    // Эквити первой руки против второй: перебор, если борду не хватает не больше
+    // двух карт, иначе Монте-Карло с последовательной остановкой
+    static MonteCarloResult headsUp(CardMask hole0, CardMask hole1, CardMask board,
+                                    std::mt19937& rng, const MonteCarloConfig& config);
+    // Эквити руки против opponents случайных рук (не больше MAX_SEATS - 1)
+    static MonteCarloResult vsRandom(CardMask hole, CardMask board, int opponents,
+                                     std::mt19937& rng, const MonteCarloConfig& config);
+
+    static int countCards(CardMask cards);
+};
+
+#endif
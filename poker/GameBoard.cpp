@@ -72,11 +72,15 @@ std::string GameBoard::getPhaseString() const {
 }
 
 void GameBoard::addCommunityCard(const Card& card) {
+    if (communityCards.full()) {
+        std::cout << "Ошибка: На столе уже " << communityCards.size() << " общих карт" << std::endl;
+        return;
+    }
     communityCards.push_back(card);
 }
 
-void GameBoard::addFlopCards(const std::vector<Card>& cards) {
-    if (cards.size() >= 3) {
+void GameBoard::addFlopCards(CardSpan cards) {
+    if (cards.size() >= 3 && communityCards.empty()) {
         for (int i = 0; i < 3; i++) {
             communityCards.push_back(cards[i]);
         }
@@ -95,7 +99,7 @@ void GameBoard::addRiverCard(const Card& card) {
     }
 }
 
-std::vector<Card> GameBoard::getCommunityCards() const {
+CardSpan GameBoard::getCommunityCards() const {
     return communityCards;
 }
 
@@ -153,7 +157,7 @@ void GameBoard::removePlayer(Player* player) {
     }
 }
 
-std::vector<Player*> GameBoard::getPlayers() const {
+const std::vector<Player*>& GameBoard::getPlayers() const {
     return players;
 }
 
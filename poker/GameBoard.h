@@ -15,7 +15,7 @@ enum class GamePhase {
 
 class GameBoard {
 private:
-    std::vector<Card> communityCards;
+    BoardCards communityCards;
     GamePhase currentPhase;
     int potAmount;
     int currentBet;
@@ -35,10 +35,10 @@ public:
     std::string getPhaseString() const;
     
     void addCommunityCard(const Card& card);
-    void addFlopCards(const std::vector<Card>& cards);
+    void addFlopCards(CardSpan cards);
     void addTurnCard(const Card& card);
     void addRiverCard(const Card& card);
-    std::vector<Card> getCommunityCards() const;
+    CardSpan getCommunityCards() const;
     void clearCommunityCards();
     
     void addToPot(int amount);
@@ -54,7 +54,7 @@ public:
     
     void addPlayer(Player* player);
     void removePlayer(Player* player);
-    std::vector<Player*> getPlayers() const;
+    const std::vector<Player*>& getPlayers() const;
     Player* getCurrentPlayer() const;
     void setCurrentPlayer(int index);
     void nextPlayer();
@@ -0,0 +1,18 @@
+#include "HandArena.h"
+
+HandArena::HandArena(size_t initialSize)
+    : buffer(std::make_unique<std::byte[]>(initialSize)), bufferSize(initialSize),
+      resource(buffer.get(), bufferSize, std::pmr::new_delete_resource()) {
+}
+
+std::pmr::memory_resource* HandArena::getResource() {
+    return &resource;
+}
+
+void HandArena::reset() {
+    resource.release();
+}
+
+size_t HandArena::getInitialSize() const {
+    return bufferSize;
+}
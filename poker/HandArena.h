@@ -0,0 +1,31 @@
+#ifndef POKER_HANDARENA_H
+#define POKER_HANDARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// Память одной раздачи: Bank, Result и другие объекты раздачи берут её из арены,
+// а в конце раздачи всё освобождается одним reset(), без возврата блоков в общую кучу.
+// Первый блок принадлежит арене и переиспользуется; сверх него память берётся из кучи.
+// Арена однопоточная: своя на каждый стол или поток.
+class HandArena {
+private:
+    std::unique_ptr<std::byte[]> buffer;
+    size_t bufferSize;
+    std::pmr::monotonic_buffer_resource resource;
+
+public:
+    static constexpr size_t DEFAULT_SIZE = 64 * 1024;
+
+    explicit HandArena(size_t initialSize = DEFAULT_SIZE);
+    HandArena(const HandArena&) = delete;
+    HandArena& operator=(const HandArena&) = delete;
+
+    std::pmr::memory_resource* getResource();
+    // Освобождает всё выделенное; объекты на арене к этому моменту должны быть уничтожены
+    void reset();
+    size_t getInitialSize() const;
+};
+
+#endif
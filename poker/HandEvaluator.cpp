@@ -1,9 +1,54 @@
 #include "HandEvaluator.h"
 #include <algorithm>
-#include <map>
+#include <functional>
 #include <iostream>
 
-const std::vector<std::string> HandEvaluator::HAND_NAMES = {
+namespace {
+    // Индексы рангов 0..12 (двойка..туз) в битовых масках рангов
+    int countBits(unsigned bits) {
+        int count = 0;
+        while (bits) {
+            bits &= bits - 1;
+            count++;
+        }
+        return count;
+    }
+
+    int highestBit(unsigned bits) {
+        int index = -1;
+        while (bits) {
+            bits >>= 1;
+            index++;
+        }
+        return index;
+    }
+
+    // Старшая карта стрита или -1; туз может быть и младшей картой
+    int straightHigh(unsigned rankBits) {
+        unsigned extended = (rankBits << 1) | ((rankBits >> 12) & 1);
+        for (int low = 9; low >= 0; low--) {
+            if (((extended >> low) & 0x1F) == 0x1F) return low + 3;
+        }
+        return -1;
+    }
+
+    // Ранги count старших карт из набора, по 4 бита начиная со старших позиций
+    int packTop(unsigned rankBits, int count) {
+        int packed = 0;
+        for (int i = 0; i < count; i++) {
+            int top = highestBit(rankBits);
+            packed = (packed << 4) | (top < 0 ? 0 : top);
+            if (top >= 0) rankBits &= ~(1u << top);
+        }
+        return packed << (4 * (5 - count));
+    }
+
+    int makeScore(HandRank rank, int packedRanks) {
+        return (static_cast<int>(rank) << 20) | packedRanks;
+    }
+}
+
+const char* const HandEvaluator::HAND_NAMES[] = {
     "Старшая карта",
     "Пара",
     "Две пары",
@@ -16,9 +61,9 @@ const std::vector<std::string> HandEvaluator::HAND_NAMES = {
     "Роял-флэш"
 };
 
-HandEvaluation HandEvaluator::evaluateHand(const std::vector<Card>& hand) {
+HandEvaluation HandEvaluator::evaluateHand(CardSpan hand) {
     HandEvaluation evaluation;
-    
+
     if (isRoyalFlush(hand)) {
         evaluation.rank = HandRank::ROYAL_FLUSH;
         evaluation.rankValue = 9;
@@ -50,83 +95,73 @@ HandEvaluation HandEvaluator::evaluateHand(const std::vector<Card>& hand) {
         evaluation.rank = HandRank::HIGH_CARD;
         evaluation.rankValue = 0;
     }
-    
-    evaluation.handName = getHandName(evaluation.rank);
+
+    evaluation.handName = HAND_NAMES[evaluation.rankValue];
     evaluation.kickers = getKickers(hand, evaluation.rank);
-    
+
     return evaluation;
 }
 
-bool HandEvaluator::isRoyalFlush(const std::vector<Card>& hand) {
+bool HandEvaluator::isRoyalFlush(CardSpan hand) {
     if (!isFlush(hand)) return false;
-    
-    std::vector<int> ranks = getSortedRanks(hand);
-    
+
+    RankCounts rankCounts = getRankCounts(hand);
+
     // Check for 10, J, Q, K, A (rank values: 10, 11, 12, 13, 14)
-    std::vector<int> requiredRanks = {10, 11, 12, 13, 14};
-    bool hasAllRanks = true;
-    
-    for (int rank : requiredRanks) {
-        if (std::find(ranks.begin(), ranks.end(), rank) == ranks.end()) {
-            hasAllRanks = false;
-            break;
+    for (int rank = 10; rank <= 14; rank++) {
+        if (rankCounts[rank] == 0) {
+            return false;
         }
     }
-    
-    return hasAllRanks;
+
+    return true;
 }
 
-bool HandEvaluator::isStraightFlush(const std::vector<Card>& hand) {
+bool HandEvaluator::isStraightFlush(CardSpan hand) {
     return isFlush(hand) && isStraight(hand);
 }
 
-bool HandEvaluator::isFourOfAKind(const std::vector<Card>& hand) {
-    std::vector<int> rankCounts = getRankCounts(hand);
+bool HandEvaluator::isFourOfAKind(CardSpan hand) {
+    RankCounts rankCounts = getRankCounts(hand);
     return std::find(rankCounts.begin(), rankCounts.end(), 4) != rankCounts.end();
 }
 
-bool HandEvaluator::isFullHouse(const std::vector<Card>& hand) {
-    std::vector<int> rankCounts = getRankCounts(hand);
+bool HandEvaluator::isFullHouse(CardSpan hand) {
+    RankCounts rankCounts = getRankCounts(hand);
     bool hasThree = std::find(rankCounts.begin(), rankCounts.end(), 3) != rankCounts.end();
     bool hasPair = std::find(rankCounts.begin(), rankCounts.end(), 2) != rankCounts.end();
     return hasThree && hasPair;
 }
 
-bool HandEvaluator::isFlush(const std::vector<Card>& hand) {
-    std::vector<int> suitCounts = getSuitCounts(hand);
-    return std::find(suitCounts.begin(), suitCounts.end(), 5) != suitCounts.end();
+bool HandEvaluator::isFlush(CardSpan hand) {
+    SuitCounts suitCounts = getSuitCounts(hand);
+    return std::any_of(suitCounts.begin(), suitCounts.end(), [](int count) { return count >= 5; });
 }
 
-bool HandEvaluator::isStraight(const std::vector<Card>& hand) {
-    std::vector<int> ranks = getSortedRanks(hand);
-    
+bool HandEvaluator::isStraight(CardSpan hand) {
+    RankCounts rankCounts = getRankCounts(hand);
+
     // Check for A-2-3-4-5 straight
-    std::vector<int> lowStraight = {2, 3, 4, 5, 14};
-    bool hasLowStraight = true;
-    for (int rank : lowStraight) {
-        if (std::find(ranks.begin(), ranks.end(), rank) == ranks.end()) {
-            hasLowStraight = false;
-            break;
-        }
+    if (rankCounts[14] && rankCounts[2] && rankCounts[3] && rankCounts[4] && rankCounts[5]) {
+        return true;
     }
-    if (hasLowStraight) return true;
-    
-    return hasConsecutiveRanks(ranks);
+
+    return hasConsecutiveRanks(getSortedRanks(hand));
 }
 
-bool HandEvaluator::isThreeOfAKind(const std::vector<Card>& hand) {
-    std::vector<int> rankCounts = getRankCounts(hand);
+bool HandEvaluator::isThreeOfAKind(CardSpan hand) {
+    RankCounts rankCounts = getRankCounts(hand);
     return std::find(rankCounts.begin(), rankCounts.end(), 3) != rankCounts.end();
 }
 
-bool HandEvaluator::isTwoPair(const std::vector<Card>& hand) {
-    std::vector<int> rankCounts = getRankCounts(hand);
+bool HandEvaluator::isTwoPair(CardSpan hand) {
+    RankCounts rankCounts = getRankCounts(hand);
     int pairCount = std::count(rankCounts.begin(), rankCounts.end(), 2);
-    return pairCount == 2;
+    return pairCount >= 2;
 }
 
-bool HandEvaluator::isOnePair(const std::vector<Card>& hand) {
-    std::vector<int> rankCounts = getRankCounts(hand);
+bool HandEvaluator::isOnePair(CardSpan hand) {
+    RankCounts rankCounts = getRankCounts(hand);
     return std::find(rankCounts.begin(), rankCounts.end(), 2) != rankCounts.end();
 }
 
@@ -140,132 +175,215 @@ int HandEvaluator::getRankValue(const std::string& rank) {
     if (rank == "8") return 8;
     if (rank == "9") return 9;
     if (rank == "10") return 10;
-    if (rank == "J") return 11;
-    if (rank == "Q") return 12;
-    if (rank == "K") return 13;
-    if (rank == "A") return 14;
+    if (rank == "J" || rank == "Валет") return 11;
+    if (rank == "Q" || rank == "Дама") return 12;
+    if (rank == "K" || rank == "Король") return 13;
+    if (rank == "A" || rank == "Туз") return 14;
     return 0;
 }
 
 std::string HandEvaluator::getHandName(HandRank rank) {
     int index = static_cast<int>(rank);
-    if (index >= 0 && index < HAND_NAMES.size()) {
+    if (index >= 0 && index <= static_cast<int>(HandRank::ROYAL_FLUSH)) {
         return HAND_NAMES[index];
     }
     return "Unknown Hand";
 }
 
-std::vector<int> HandEvaluator::getKickers(const std::vector<Card>& hand, HandRank rank) {
-    std::vector<int> kickers;
-    std::vector<int> ranks = getSortedRanks(hand);
-    
+RankList HandEvaluator::getKickers(CardSpan hand, HandRank rank) {
+    RankList kickers;
+
     switch (rank) {
-        case HandRank::HIGH_CARD:
-            kickers = ranks;
-            break;
         case HandRank::ONE_PAIR:
             // Find pair rank and remaining cards
             {
-                std::map<int, int> rankCounts;
-                for (int rank : ranks) {
-                    rankCounts[rank]++;
-                }
-                for (auto& pair : rankCounts) {
-                    if (pair.second == 2) {
-                        kickers.push_back(pair.first);
-                        kickers.push_back(pair.first);
+                RankCounts rankCounts = getRankCounts(hand);
+                for (int value = 14; value >= 2; value--) {
+                    if (rankCounts[value] == 2) {
+                        kickers.push_back(value);
+                        kickers.push_back(value);
                     }
                 }
-                for (auto& pair : rankCounts) {
-                    if (pair.second == 1) {
-                        kickers.push_back(pair.first);
+                for (int value = 14; value >= 2; value--) {
+                    if (rankCounts[value] == 1) {
+                        kickers.push_back(value);
                     }
                 }
             }
             break;
+        case HandRank::HIGH_CARD:
         case HandRank::TWO_PAIR:
         case HandRank::THREE_OF_A_KIND:
         case HandRank::FOUR_OF_A_KIND:
         case HandRank::FULL_HOUSE:
             // Similar logic for other hand types
-            kickers = ranks;
-            break;
         default:
-            kickers = ranks;
+            kickers = getSortedRanks(hand);
             break;
     }
-    
+
     return kickers;
 }
 
-int HandEvaluator::compareHands(const std::vector<Card>& hand1, const std::vector<Card>& hand2) {
-    HandEvaluation eval1 = evaluateHand(hand1);
-    HandEvaluation eval2 = evaluateHand(hand2);
-    
+int HandEvaluator::compareHands(CardSpan hand1, CardSpan hand2) {
+    return compareEvaluations(evaluateHand(hand1), evaluateHand(hand2));
+}
+
+int HandEvaluator::compareEvaluations(const HandEvaluation& eval1, const HandEvaluation& eval2) {
     if (eval1.rankValue > eval2.rankValue) return 1;
     if (eval1.rankValue < eval2.rankValue) return -1;
-    
+
     // Same hand rank, compare kickers
     for (size_t i = 0; i < std::min(eval1.kickers.size(), eval2.kickers.size()); i++) {
         if (eval1.kickers[i] > eval2.kickers[i]) return 1;
         if (eval1.kickers[i] < eval2.kickers[i]) return -1;
     }
-    
+
     return 0; // Tie
 }
 
-bool HandEvaluator::isHandBetter(const std::vector<Card>& hand1, const std::vector<Card>& hand2) {
+bool HandEvaluator::isHandBetter(CardSpan hand1, CardSpan hand2) {
     return compareHands(hand1, hand2) > 0;
 }
 
-std::vector<int> HandEvaluator::getRankCounts(const std::vector<Card>& hand) {
-    std::map<int, int> rankCounts;
+RankCounts HandEvaluator::getRankCounts(CardSpan hand) {
+    RankCounts rankCounts{};
     for (const Card& card : hand) {
-        int rank = getRankValue(card.getRank());
-        rankCounts[rank]++;
+        rankCounts[card.getRankValue()]++;
     }
-    
-    std::vector<int> counts;
-    for (auto& pair : rankCounts) {
-        counts.push_back(pair.second);
-    }
-    return counts;
+    return rankCounts;
 }
 
-std::vector<int> HandEvaluator::getSuitCounts(const std::vector<Card>& hand) {
-    std::map<std::string, int> suitCounts;
+SuitCounts HandEvaluator::getSuitCounts(CardSpan hand) {
+    SuitCounts suitCounts{};
     for (const Card& card : hand) {
-        suitCounts[card.getSuit()]++;
-    }
-    
-    std::vector<int> counts;
-    for (auto& pair : suitCounts) {
-        counts.push_back(pair.second);
+        suitCounts[card.getSuitIndex()]++;
     }
-    return counts;
+    return suitCounts;
 }
 
-std::vector<int> HandEvaluator::getSortedRanks(const std::vector<Card>& hand) {
-    std::vector<int> ranks;
+RankList HandEvaluator::getSortedRanks(CardSpan hand) {
+    RankList ranks;
     for (const Card& card : hand) {
-        ranks.push_back(getRankValue(card.getRank()));
+        ranks.push_back(card.getRankValue());
     }
     std::sort(ranks.begin(), ranks.end(), std::greater<int>());
     return ranks;
 }
 
-bool HandEvaluator::hasConsecutiveRanks(const std::vector<int>& ranks) {
+bool HandEvaluator::hasConsecutiveRanks(const RankList& ranks) {
     if (ranks.size() < 5) return false;
-    
-    for (size_t i = 0; i <= ranks.size() - 5; i++) {
-        bool consecutive = true;
-        for (size_t j = 1; j < 5; j++) {
-            if (ranks[i + j] != ranks[i] - j) {
-                consecutive = false;
-                break;
-            }
-        }
-        if (consecutive) return true;
+
+    // Bit per distinct rank, so duplicates don't break the run
+    int rankMask = 0;
+    for (int rank : ranks) {
+        rankMask |= 1 << rank;
+    }
+    for (int high = 14; high >= 6; high--) {
+        if (((rankMask >> (high - 4)) & 0x1F) == 0x1F) return true;
     }
     return false;
 }
+
+CardMask HandEvaluator::toMask(CardSpan hand) {
+    CardMask mask = 0;
+    for (const Card& card : hand) {
+        mask |= CardMask(1) << card.getCode();
+    }
+    return mask;
+}
+
+int HandEvaluator::evaluateMask(CardMask cards) {
+    unsigned suitRanks[4] = { 0, 0, 0, 0 };
+    unsigned rankBits = 0, pairs = 0, trips = 0, quads = 0;
+    for (int rank = 0; rank < 13; rank++) {
+        unsigned nibble = static_cast<unsigned>(cards >> (rank * 4)) & 0xF;
+        for (int suit = 0; suit < 4; suit++) {
+            suitRanks[suit] |= ((nibble >> suit) & 1) << rank;
+        }
+        switch (countBits(nibble)) {
+            case 1: rankBits |= 1u << rank; break;
+            case 2: rankBits |= 1u << rank; pairs |= 1u << rank; break;
+            case 3: rankBits |= 1u << rank; trips |= 1u << rank; break;
+            case 4: rankBits |= 1u << rank; quads |= 1u << rank; break;
+            default: break;
+        }
+    }
+
+    int flushScore = -1;
+    for (int suit = 0; suit < 4; suit++) {
+        if (countBits(suitRanks[suit]) >= 5) {
+            int high = straightHigh(suitRanks[suit]);
+            if (high == 12) return makeScore(HandRank::ROYAL_FLUSH, high << 16);
+            if (high >= 0) return makeScore(HandRank::STRAIGHT_FLUSH, high << 16);
+            flushScore = makeScore(HandRank::FLUSH, packTop(suitRanks[suit], 5));
+        }
+    }
+
+    if (quads) {
+        int quad = highestBit(quads);
+        return makeScore(HandRank::FOUR_OF_A_KIND, (quad << 16) | (highestBit(rankBits & ~(1u << quad)) << 12));
+    }
+    if (trips) {
+        int trip = highestBit(trips);
+        unsigned rest = (pairs | trips) & ~(1u << trip);
+        if (rest) {
+            return makeScore(HandRank::FULL_HOUSE, (trip << 16) | (highestBit(rest) << 12));
+        }
+    }
+    if (flushScore >= 0) return flushScore;
+
+    int high = straightHigh(rankBits);
+    if (high >= 0) return makeScore(HandRank::STRAIGHT, high << 16);
+
+    if (trips) {
+        int trip = highestBit(trips);
+        return makeScore(HandRank::THREE_OF_A_KIND, (trip << 16) | (packTop(rankBits & ~(1u << trip), 2) >> 4));
+    }
+    if (countBits(pairs) >= 2) {
+        int top = highestBit(pairs);
+        int second = highestBit(pairs & ~(1u << top));
+        unsigned rest = rankBits & ~(1u << top) & ~(1u << second);
+        return makeScore(HandRank::TWO_PAIR, (top << 16) | (second << 12) | (highestBit(rest) << 8));
+    }
+    if (pairs) {
+        int pair = highestBit(pairs);
+        return makeScore(HandRank::ONE_PAIR, (pair << 16) | (packTop(rankBits & ~(1u << pair), 3) >> 4));
+    }
+    return makeScore(HandRank::HIGH_CARD, packTop(rankBits, 5));
+}
+
+HandRank HandEvaluator::getScoreRank(int score) {
+    return static_cast<HandRank>(score >> 20);
+}
+
+int HandEvaluator::getPreflopScore(Card first, Card second) {
+    int high = std::max(first.getRankValue(), second.getRankValue());
+    int low = std::min(first.getRankValue(), second.getRankValue());
+
+    // Очки считаются удвоенными, чтобы обойтись без половинок
+    auto cardPoints = [](int rank) {
+        switch (rank) {
+            case 14: return 20;
+            case 13: return 16;
+            case 12: return 14;
+            case 11: return 12;
+            default: return rank;
+        }
+    };
+
+    int points = cardPoints(high);
+    if (high == low) {
+        return std::max(10, points * 2) / 2;
+    }
+    if (first.getSuitIndex() == second.getSuitIndex()) {
+        points += 4;
+    }
+    int gap = high - low - 1;
+    static const int GAP_PENALTY[] = { 0, 2, 4, 8, 10 };
+    points -= GAP_PENALTY[std::min(gap, 4)];
+    if (gap <= 1 && high < 12) {
+        points += 2;
+    }
+    return points >= 0 ? (points + 1) / 2 : points / 2;
+}
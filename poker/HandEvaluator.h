@@ -1,7 +1,7 @@
 #ifndef POKER_HANDEVALUATOR_H
 #define POKER_HANDEVALUATOR_H
 
-#include <vector>
+#include <array>
 #include <string>
 #include "Card.h"
 
@@ -18,41 +18,56 @@ enum class HandRank {
     ROYAL_FLUSH = 9
 };
 
+using RankList = StaticVector<int, HandCards::capacity()>;
+using RankCounts = std::array<int, 15>;  // индекс - значение ранга 2..14
+using SuitCounts = std::array<int, 4>;
+// Набор карт битами: бит с номером Card::getCode() (4 бита на ранг, по биту на масть)
+using CardMask = uint64_t;
+
 struct HandEvaluation {
     HandRank rank;
-    std::string handName;
+    const char* handName;
     int rankValue;
-    std::vector<int> kickers;
+    RankList kickers;
 };
 
 class HandEvaluator {
 public:
-    static HandEvaluation evaluateHand(const std::vector<Card>& hand);
+    static HandEvaluation evaluateHand(CardSpan hand);
     
-    static bool isRoyalFlush(const std::vector<Card>& hand);
-    static bool isStraightFlush(const std::vector<Card>& hand);
-    static bool isFourOfAKind(const std::vector<Card>& hand);
-    static bool isFullHouse(const std::vector<Card>& hand);
-    static bool isFlush(const std::vector<Card>& hand);
-    static bool isStraight(const std::vector<Card>& hand);
-    static bool isThreeOfAKind(const std::vector<Card>& hand);
-    static bool isTwoPair(const std::vector<Card>& hand);
-    static bool isOnePair(const std::vector<Card>& hand);
+    static bool isRoyalFlush(CardSpan hand);
+    static bool isStraightFlush(CardSpan hand);
+    static bool isFourOfAKind(CardSpan hand);
+    static bool isFullHouse(CardSpan hand);
+    static bool isFlush(CardSpan hand);
+    static bool isStraight(CardSpan hand);
+    static bool isThreeOfAKind(CardSpan hand);
+    static bool isTwoPair(CardSpan hand);
+    static bool isOnePair(CardSpan hand);
     
     static int getRankValue(const std::string& rank);
     static std::string getHandName(HandRank rank);
-    static std::vector<int> getKickers(const std::vector<Card>& hand, HandRank rank);
+    static RankList getKickers(CardSpan hand, HandRank rank);
+    
+    static int compareHands(CardSpan hand1, CardSpan hand2);
+    static int compareEvaluations(const HandEvaluation& eval1, const HandEvaluation& eval2);
+    static bool isHandBetter(CardSpan hand1, CardSpan hand2);
     
-    static int compareHands(const std::vector<Card>& hand1, const std::vector<Card>& hand2);
-    static bool isHandBetter(const std::vector<Card>& hand1, const std::vector<Card>& hand2);
+    static RankCounts getRankCounts(CardSpan hand);
+    static SuitCounts getSuitCounts(CardSpan hand);
+    static RankList getSortedRanks(CardSpan hand);
+    static bool hasConsecutiveRanks(const RankList& ranks);
     
-    static std::vector<int> getRankCounts(const std::vector<Card>& hand);
-    static std::vector<int> getSuitCounts(const std::vector<Card>& hand);
-    static std::vector<int> getSortedRanks(const std::vector<Card>& hand);
-    static bool hasConsecutiveRanks(const std::vector<int>& ranks);
+    // Оценка набора из 5-7 карт одним числом: чем больше, тем сильнее рука.
+    // Старшие биты - HandRank, ниже - ранги решающих карт по 4 бита.
+    static CardMask toMask(CardSpan hand);
+    static int evaluateMask(CardMask cards);
+    static HandRank getScoreRank(int score);
+    // Сила стартовой руки по формуле Чена, округлённая вверх (от -1 до 20)
+    static int getPreflopScore(Card first, Card second);
     
 private:
-    static const std::vector<std::string> HAND_NAMES;
+    static const char* const HAND_NAMES[];
 };
 
 #endif
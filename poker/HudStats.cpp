@@ -0,0 +1,222 @@
+#include "HudStats.h"
+#include <algorithm>
+
+namespace {
+
+bool isAggressive(BetAction action) {
+    return action == BetAction::RAISE || action == BetAction::ALL_IN;
+}
+
+uint16_t bit(HudStat stat) {
+    return static_cast<uint16_t>(1u << static_cast<unsigned>(stat));
+}
+
+}
+
+HudStats::HudStats(size_t window)
+    : windowHands(std::max<size_t>(1, window)), handOpen(false), street(GamePhase::PREFLOP),
+      preflopRaises(0), preflopAggressor(INVALID_PLAYER_ID), flopBetMade(false), cbetMade(false) {
+}
+
+void HudStats::mark(HandSeat& seat, HudStat stat, bool hit) {
+    seat.chances |= bit(stat);
+    if (hit) {
+        seat.hits |= bit(stat);
+    }
+}
+
+HudStats::HandSeat& HudStats::getSeat(PlayerId player) {
+    for (HandSeat& seat : seats) {
+        if (seat.player == player) {
+            return seat;
+        }
+    }
+    // Игрок, не объявленный при сдаче, считается сданным с начала раздачи
+    HandSeat seat = { player, 0, 0, 0, 0, false, false };
+    mark(seat, HudStat::VPIP, false);
+    mark(seat, HudStat::PFR, false);
+    seats.push_back(seat);
+    return seats.back();
+}
+
+void HudStats::beginHand(const std::vector<PlayerId>& dealt) {
+    if (handOpen) {
+        endHand();
+    }
+    handOpen = true;
+    street = GamePhase::PREFLOP;
+    preflopRaises = 0;
+    preflopAggressor = INVALID_PLAYER_ID;
+    flopBetMade = false;
+    cbetMade = false;
+    seats.clear();
+    for (PlayerId player : dealt) {
+        getSeat(player);
+    }
+}
+
+void HudStats::setStreet(GamePhase phase) {
+    if (!handOpen) return;
+    street = phase;
+    if (phase == GamePhase::FLOP) {
+        for (HandSeat& seat : seats) {
+            if (!seat.folded) {
+                mark(seat, HudStat::WTSD, false);
+            }
+        }
+    }
+}
+
+void HudStats::recordAction(PlayerId player, BetAction action) {
+    if (!handOpen) return;
+    HandSeat& seat = getSeat(player);
+    bool aggressive = isAggressive(action);
+
+    if (street == GamePhase::PREFLOP) {
+        if (action == BetAction::SMALL_BLIND || action == BetAction::BIG_BLIND) return;
+        if (action == BetAction::CALL || aggressive) {
+            seat.hits |= bit(HudStat::VPIP);
+        }
+        if (aggressive) {
+            seat.hits |= bit(HudStat::PFR);
+        }
+        if (preflopRaises == 1 && preflopAggressor != player) {
+            mark(seat, HudStat::THREE_BET, aggressive);
+        }
+        if (aggressive) {
+            preflopRaises++;
+            preflopAggressor = player;
+        }
+    } else {
+        if (aggressive) {
+            seat.aggressive++;
+        } else if (action == BetAction::CALL) {
+            seat.calls++;
+        }
+        if (street == GamePhase::FLOP) {
+            if (!flopBetMade && player == preflopAggressor) {
+                mark(seat, HudStat::CBET, aggressive);
+                cbetMade = aggressive;
+            } else if (cbetMade && player != preflopAggressor && !seat.answeredCbet) {
+                mark(seat, HudStat::FOLD_TO_CBET, action == BetAction::FOLD);
+                seat.answeredCbet = true;
+            }
+            flopBetMade = flopBetMade || aggressive;
+        }
+    }
+
+    if (action == BetAction::FOLD) {
+        seat.folded = true;
+    }
+}
+
+void HudStats::recordShowdown(const std::vector<PlayerId>& winners) {
+    if (!handOpen) return;
+    for (HandSeat& seat : seats) {
+        if (seat.folded) continue;
+        if (seat.chances & bit(HudStat::WTSD)) {
+            seat.hits |= bit(HudStat::WTSD);
+        }
+        bool won = std::find(winners.begin(), winners.end(), seat.player) != winners.end();
+        mark(seat, HudStat::WSD, won);
+    }
+}
+
+void HudStats::endHand() {
+    if (!handOpen) return;
+    handOpen = false;
+    for (const HandSeat& seat : seats) {
+        PlayerEntry& entry = entries[seat.player];
+        entry.hands++;
+        entry.postflopAggressive += seat.aggressive;
+        entry.postflopCalls += seat.calls;
+        if (entry.recentHands.empty()) {
+            entry.recentHands.assign(windowHands, 0);
+        }
+
+        // Раздача, выпадающая из окна, вычитается
+        uint32_t evicted = entry.recentHands[entry.nextSlot];
+        uint32_t current = seat.chances | (uint32_t(seat.hits) << 16);
+        entry.recentHands[entry.nextSlot] = current;
+        entry.nextSlot = (entry.nextSlot + 1) % windowHands;
+
+        for (size_t stat = 0; stat < HUD_STAT_COUNT; stat++) {
+            uint32_t chance = (current >> stat) & 1u;
+            uint32_t hit = (current >> (stat + 16)) & 1u;
+            entry.totals[stat].chances += chance;
+            entry.totals[stat].hits += hit;
+            entry.window[stat].chances += chance - ((evicted >> stat) & 1u);
+            entry.window[stat].hits += hit - ((evicted >> (stat + 16)) & 1u);
+        }
+    }
+    seats.clear();
+}
+
+HudCounter HudStats::getCounter(PlayerId player, HudStat stat) const {
+    const PlayerEntry* entry = entries.find(player);
+    return entry ? entry->totals[static_cast<size_t>(stat)] : HudCounter();
+}
+
+HudCounter HudStats::getWindowCounter(PlayerId player, HudStat stat) const {
+    const PlayerEntry* entry = entries.find(player);
+    return entry ? entry->window[static_cast<size_t>(stat)] : HudCounter();
+}
+
+double HudStats::getRate(PlayerId player, HudStat stat) const {
+    return getCounter(player, stat).getRate();
+}
+
+double HudStats::getWindowRate(PlayerId player, HudStat stat) const {
+    return getWindowCounter(player, stat).getRate();
+}
+
+uint32_t HudStats::getHandCount(PlayerId player) const {
+    const PlayerEntry* entry = entries.find(player);
+    return entry ? entry->hands : 0;
+}
+
+double HudStats::getAggressionFactor(PlayerId player) const {
+    const PlayerEntry* entry = entries.find(player);
+    if (!entry || entry->postflopCalls == 0) {
+        return entry ? static_cast<double>(entry->postflopAggressive) : 0.0;
+    }
+    return static_cast<double>(entry->postflopAggressive) / entry->postflopCalls;
+}
+
+size_t HudStats::getWindowSize() const {
+    return windowHands;
+}
+
+bool HudStats::isInHand(PlayerId player) const {
+    if (!handOpen) return false;
+    for (const HandSeat& seat : seats) {
+        if (seat.player == player) {
+            return !seat.folded;
+        }
+    }
+    return false;
+}
+
+PlayerId HudStats::getPreflopAggressor() const {
+    return handOpen ? preflopAggressor : INVALID_PLAYER_ID;
+}
+
+GamePhase HudStats::getStreet() const {
+    return street;
+}
+
+std::vector<PlayerId> HudStats::getHandPlayers() const {
+    std::vector<PlayerId> players;
+    for (const HandSeat& seat : seats) {
+        if (!seat.folded) {
+            players.push_back(seat.player);
+        }
+    }
+    return players;
+}
+
+void HudStats::clear() {
+    entries.clear();
+    seats.clear();
+    handOpen = false;
+}
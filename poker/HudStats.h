@@ -0,0 +1,104 @@
+#ifndef POKER_HUDSTATS_H
+#define POKER_HUDSTATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BetHistory.h"
+#include "GameBoard.h"
+#include "PlayerRegistry.h"
+
+// Показатели HUD: доля раз, когда игрок сделал действие, среди раз, когда мог
+enum class HudStat : uint8_t {
+    VPIP,           // добровольно вложился префлоп / раздач
+    PFR,            // рейз префлоп / раздач
+    THREE_BET,      // ре-рейз против единственного рейза / раз, когда был такой шанс
+    CBET,           // ставка на флопе агрессором префлопа / раз, когда он мог начать торги
+    FOLD_TO_CBET,   // сброс на контбет / раз, когда игрок отвечал на контбет
+    WTSD,           // дошёл до вскрытия / видел флоп
+    WSD,            // выиграл на вскрытии / вскрытий
+    COUNT
+};
+
+constexpr size_t HUD_STAT_COUNT = static_cast<size_t>(HudStat::COUNT);
+
+struct HudCounter {
+    uint32_t hits = 0;
+    uint32_t chances = 0;
+
+    double getRate() const {
+        return chances == 0 ? 0.0 : static_cast<double>(hits) / chances;
+    }
+};
+
+// Потоковый подсчёт HUD: раздача разбирается по мере действий, в конце раздачи её
+// флаги прибавляются к счётчикам игроков за всё время и за последние windowHands раздач.
+// Запрос - индексация массива и одно деление, без обхода истории.
+class HudStats {
+private:
+    // Флаги игрока в текущей раздаче: бит шанса и бит действия на каждый показатель
+    struct HandSeat {
+        PlayerId player;
+        uint16_t chances;
+        uint16_t hits;
+        uint16_t aggressive;
+        uint16_t calls;
+        bool folded;
+        bool answeredCbet;
+    };
+
+    struct PlayerEntry {
+        HudCounter totals[HUD_STAT_COUNT];
+        HudCounter window[HUD_STAT_COUNT];
+        uint32_t hands = 0;
+        uint32_t postflopAggressive = 0;
+        uint32_t postflopCalls = 0;
+        std::vector<uint32_t> recentHands;  // кольцо: chances в младших 16 битах, hits в старших
+        size_t nextSlot = 0;
+    };
+
+    size_t windowHands;
+    PlayerTable<PlayerEntry> entries;
+    std::vector<HandSeat> seats;
+    bool handOpen;
+    GamePhase street;
+    int preflopRaises;
+    PlayerId preflopAggressor;
+    bool flopBetMade;
+    bool cbetMade;
+
+    HandSeat& getSeat(PlayerId player);
+    static void mark(HandSeat& seat, HudStat stat, bool hit);
+
+public:
+    static constexpr size_t DEFAULT_WINDOW = 100;
+
+    explicit HudStats(size_t window = DEFAULT_WINDOW);
+
+    // Новая раздача; незакрытая прошлая закрывается. dealt - кому сданы карты
+    void beginHand(const std::vector<PlayerId>& dealt);
+    void setStreet(GamePhase phase);
+    void recordAction(PlayerId player, BetAction action);
+    // Вскрытие: все не сбросившие дошли до него, winners - кто выиграл
+    void recordShowdown(const std::vector<PlayerId>& winners);
+    void endHand();
+
+    double getRate(PlayerId player, HudStat stat) const;
+    double getWindowRate(PlayerId player, HudStat stat) const;
+    HudCounter getCounter(PlayerId player, HudStat stat) const;
+    HudCounter getWindowCounter(PlayerId player, HudStat stat) const;
+    uint32_t getHandCount(PlayerId player) const;
+    // Ставки и рейзы после флопа к коллам после флопа
+    double getAggressionFactor(PlayerId player) const;
+    size_t getWindowSize() const;
+
+    // Текущая раздача
+    bool isInHand(PlayerId player) const;
+    PlayerId getPreflopAggressor() const;
+    GamePhase getStreet() const;
+    std::vector<PlayerId> getHandPlayers() const;
+
+    void clear();
+};
+
+#endif
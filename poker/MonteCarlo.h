@@ -0,0 +1,58 @@
+#ifndef POKER_MONTECARLO_H
+#define POKER_MONTECARLO_H
+
+#include <algorithm>
+#include "Statistics.h"
+
+// Как выбираются досдачи для оценок эквити
+enum class SamplingMethod {
+    RANDOM,         // независимые случайные досдачи
+    STRATIFIED,     // по классам текстуры флопа с пропорциональным распределением
+    QUASI_RANDOM    // последовательность Холтона со случайными сдвигами
+};
+
+struct MonteCarloConfig {
+    double targetHalfWidth = 0.01;   // требуемая полуширина доверительного интервала
+    double z = 1.96;
+    long long minSamples = 200;      // защита от ранней остановки на малой выборке
+    long long maxSamples = 100000;
+    long long batchSize = 100;       // как часто проверять условие остановки
+    SamplingMethod method = SamplingMethod::RANDOM;
+};
+
+struct MonteCarloResult {
+    double mean = 0.0;
+    double halfWidth = 0.0;          // достигнутая точность
+    long long samples = 0;
+    bool converged = false;          // точность достигнута до исчерпания бюджета
+};
+
+// Оценка среднего с последовательной остановкой: выборки идут пачками, пока
+// доверительный интервал не станет уже заданного или не кончится бюджет.
+// Тузы против 7-2 при точности по умолчанию (±0.01) занимают около 4 тысяч выборок,
+// при ±0.03 - около 500; близкие споры (AKo против QQ) - примерно вдвое больше.
+class MonteCarlo {
+public:
+    template <typename Sampler>
+    static MonteCarloResult run(Sampler&& sample, const MonteCarloConfig& config) {
+        RunningStats stats;
+        MonteCarloResult result;
+        long long batch = std::max(1LL, config.batchSize);
+        while (stats.getCount() < config.maxSamples) {
+            long long batchEnd = std::min(stats.getCount() + batch, config.maxSamples);
+            while (stats.getCount() < batchEnd) {
+                stats.add(sample());
+            }
+            if (stats.getCount() >= config.minSamples && stats.getHalfWidth(config.z) <= config.targetHalfWidth) {
+                result.converged = true;
+                break;
+            }
+        }
+        result.mean = stats.getMean();
+        result.halfWidth = stats.getHalfWidth(config.z);
+        result.samples = stats.getCount();
+        return result;
+    }
+};
+
+#endif
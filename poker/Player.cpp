@@ -3,9 +3,14 @@
 
 Player::Player(std::string playerName) {
     name = std::move(playerName);
+    id = PlayerRegistry::getId(name);
 }
 
 void Player::addCard(Card const& card) {
+    if (hand.full()) {
+        std::cout << "Ошибка: У игрока " << name << " уже " << hand.size() << " карт" << std::endl;
+        return;
+    }
     hand.push_back(card);
 }
 
@@ -16,11 +21,15 @@ void Player::displayHand() {
     }
 }
 
-std::string Player::getName() const {
+const std::string& Player::getName() const {
     return name;
 }
 
-std::vector<Card> Player::getHand() {
+PlayerId Player::getId() const {
+    return id;
+}
+
+CardSpan Player::getHand() const {
     return hand;
 }
 
@@ -4,19 +4,22 @@
 #include <vector>
 #include <fstream>
 #include "Card.h"
+#include "PlayerRegistry.h"
 
 
 class Player {
 private:
     std::string name;
-    std::vector<Card> hand;
+    PlayerId id;
+    HoleCards hand;
     int win=0, loss=0, tie=0;
 public:
     explicit Player(std::string playerName);
     void addCard(Card const &card);
     void displayHand();
-    std::string getName() const;
-    std::vector<Card> getHand();
+    const std::string& getName() const;
+    PlayerId getId() const;
+    CardSpan getHand() const;
     void clearHand();
     void setWin();
     void setLoss();
@@ -0,0 +1,57 @@
+#include "PlayerRegistry.h"
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace {
+
+struct RegistryData {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string, PlayerId> ids;
+    std::deque<std::string> names;  // deque не перемещает строки при росте
+};
+
+RegistryData& getData() {
+    static RegistryData data;
+    return data;
+}
+
+}
+
+PlayerId PlayerRegistry::getId(const std::string& name) {
+    RegistryData& data = getData();
+    {
+        std::shared_lock<std::shared_mutex> lock(data.mutex);
+        auto it = data.ids.find(name);
+        if (it != data.ids.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(data.mutex);
+    auto inserted = data.ids.emplace(name, static_cast<PlayerId>(data.names.size()));
+    if (inserted.second) {
+        data.names.push_back(name);
+    }
+    return inserted.first->second;
+}
+
+PlayerId PlayerRegistry::findId(const std::string& name) {
+    RegistryData& data = getData();
+    std::shared_lock<std::shared_mutex> lock(data.mutex);
+    auto it = data.ids.find(name);
+    return it != data.ids.end() ? it->second : INVALID_PLAYER_ID;
+}
+
+const std::string& PlayerRegistry::getName(PlayerId id) {
+    static const std::string empty;
+    RegistryData& data = getData();
+    std::shared_lock<std::shared_mutex> lock(data.mutex);
+    return id < data.names.size() ? data.names[id] : empty;
+}
+
+size_t PlayerRegistry::getCount() {
+    RegistryData& data = getData();
+    std::shared_lock<std::shared_mutex> lock(data.mutex);
+    return data.names.size();
+}
@@ -0,0 +1,89 @@
+#ifndef POKER_PLAYERREGISTRY_H
+#define POKER_PLAYERREGISTRY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Плотный номер игрока: 0, 1, 2... в порядке регистрации имён.
+using PlayerId = uint32_t;
+constexpr PlayerId INVALID_PLAYER_ID = UINT32_MAX;
+
+// Общий для программы справочник имён игроков. Подсистемы хранят PlayerId,
+// а имя достают только для вывода и экспорта. Потокобезопасен; ссылки на имена
+// остаются действительными до конца программы.
+class PlayerRegistry {
+public:
+    // ID имени; новое имя регистрируется
+    static PlayerId getId(const std::string& name);
+    // ID уже зарегистрированного имени или INVALID_PLAYER_ID
+    static PlayerId findId(const std::string& name);
+    // Имя по ID; пустая строка для неизвестного ID
+    static const std::string& getName(PlayerId id);
+    static size_t getCount();
+};
+
+// Значения по ID игрока: поиск - индексация массива, без сравнения строк.
+template <typename T>
+class PlayerTable {
+private:
+    std::vector<T> values;
+    std::vector<bool> present;
+    size_t count = 0;
+
+public:
+    bool contains(PlayerId id) const {
+        return id < present.size() && present[id];
+    }
+
+    T* find(PlayerId id) {
+        return contains(id) ? &values[id] : nullptr;
+    }
+
+    const T* find(PlayerId id) const {
+        return contains(id) ? &values[id] : nullptr;
+    }
+
+    // Значение по ID; отсутствующее создаётся конструктором по умолчанию
+    T& operator[](PlayerId id) {
+        if (id >= values.size()) {
+            values.resize(id + 1);
+            present.resize(id + 1, false);
+        }
+        if (!present[id]) {
+            present[id] = true;
+            count++;
+        }
+        return values[id];
+    }
+
+    void erase(PlayerId id) {
+        if (contains(id)) {
+            present[id] = false;
+            values[id] = T();
+            count--;
+        }
+    }
+
+    void clear() {
+        values.clear();
+        present.clear();
+        count = 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    // f(PlayerId, const T&) для каждого значения в порядке ID
+    template <typename F>
+    void forEach(F f) const {
+        for (PlayerId id = 0; id < present.size(); id++) {
+            if (present[id]) {
+                f(id, values[id]);
+            }
+        }
+    }
+};
+
+#endif
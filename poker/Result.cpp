@@ -1,7 +1,11 @@
 #include "Result.h"
 #include <iostream>
 
-Result::Result() {
+Result::Result() : Result(std::pmr::get_default_resource()) {
+}
+
+Result::Result(std::pmr::memory_resource* resource)
+    : playerHandName(resource), dealerHandName(resource) {
     result = GameResult::IN_PROGRESS;
     playerHandName = "";
     dealerHandName = "";
@@ -17,13 +21,13 @@ void Result::setResult(GameResult gameResult) {
     result = gameResult;
 }
 
-void Result::setPlayerHand(const std::string& handName, int rank, const std::vector<Card>& hand) {
+void Result::setPlayerHand(const std::string& handName, int rank, CardSpan hand) {
     playerHandName = handName;
     playerHandRank = rank;
     playerFinalHand = hand;
 }
 
-void Result::setDealerHand(const std::string& handName, int rank, const std::vector<Card>& hand) {
+void Result::setDealerHand(const std::string& handName, int rank, CardSpan hand) {
     dealerHandName = handName;
     dealerHandRank = rank;
     dealerFinalHand = hand;
@@ -33,7 +37,7 @@ void Result::setPotAmount(int amount) {
     potAmount = amount;
 }
 
-void Result::setCommunityCards(const std::vector<Card>& cards) {
+void Result::setCommunityCards(CardSpan cards) {
     communityCards = cards;
 }
 
@@ -42,11 +46,11 @@ GameResult Result::getResult() const {
 }
 
 std::string Result::getPlayerHandName() const {
-    return playerHandName;
+    return std::string(playerHandName);
 }
 
 std::string Result::getDealerHandName() const {
-    return dealerHandName;
+    return std::string(dealerHandName);
 }
 
 int Result::getPlayerHandRank() const {
@@ -61,15 +65,15 @@ int Result::getPotAmount() const {
     return potAmount;
 }
 
-std::vector<Card> Result::getPlayerFinalHand() const {
+CardSpan Result::getPlayerFinalHand() const {
     return playerFinalHand;
 }
 
-std::vector<Card> Result::getDealerFinalHand() const {
+CardSpan Result::getDealerFinalHand() const {
     return dealerFinalHand;
 }
 
-std::vector<Card> Result::getCommunityCards() const {
+CardSpan Result::getCommunityCards() const {
     return communityCards;
 }
 
@@ -1,6 +1,7 @@
 #ifndef RESULT_H
 #define RESULT_H
 
+#include <memory_resource>
 #include <string>
 #include <vector>
 #include "Card.h"
@@ -15,22 +16,24 @@ enum class GameResult {
 class Result {
 private:
     GameResult result;
-    std::string playerHandName;
-    std::string dealerHandName;
+    std::pmr::string playerHandName;
+    std::pmr::string dealerHandName;
     int playerHandRank;
     int dealerHandRank;
     int potAmount;
-    std::vector<Card> playerFinalHand;
-    std::vector<Card> dealerFinalHand;
-    std::vector<Card> communityCards;
+    HandCards playerFinalHand;
+    HandCards dealerFinalHand;
+    BoardCards communityCards;
 
 public:
     Result();
+    // Строки результата размещаются в resource (например, в HandArena раздачи)
+    explicit Result(std::pmr::memory_resource* resource);
     void setResult(GameResult gameResult);
-    void setPlayerHand(const std::string& handName, int rank, const std::vector<Card>& hand);
-    void setDealerHand(const std::string& handName, int rank, const std::vector<Card>& hand);
+    void setPlayerHand(const std::string& handName, int rank, CardSpan hand);
+    void setDealerHand(const std::string& handName, int rank, CardSpan hand);
     void setPotAmount(int amount);
-    void setCommunityCards(const std::vector<Card>& cards);
+    void setCommunityCards(CardSpan cards);
 
     GameResult getResult() const;
     std::string getPlayerHandName() const;
@@ -38,9 +41,9 @@ public:
     int getPlayerHandRank() const;
     int getDealerHandRank() const;
     int getPotAmount() const;
-    std::vector<Card> getPlayerFinalHand() const;
-    std::vector<Card> getDealerFinalHand() const;
-    std::vector<Card> getCommunityCards() const;
+    CardSpan getPlayerFinalHand() const;
+    CardSpan getDealerFinalHand() const;
+    CardSpan getCommunityCards() const;
 
     std::string getResultString() const;
     void displayResult() const;
@@ -0,0 +1,295 @@
+#include "RulesEngine.h"
+#include "HandEvaluator.h"
+#include "SidePots.h"
+#include <algorithm>
+
+int RulesEngine::countSeats(uint16_t mask) {
+    int count = 0;
+    while (mask) {
+        mask &= mask - 1;
+        count++;
+    }
+    return count;
+}
+
+int RulesEngine::nextSeat(const TableState& state, int from, uint16_t mask) {
+    for (int step = 1; step <= state.seatCount; step++) {
+        int seat = (from + step) % state.seatCount;
+        if (mask & (1u << seat)) {
+            return seat;
+        }
+    }
+    return -1;
+}
+
+int RulesEngine::getToCall(const TableState& state, int seat) {
+    return std::min(state.currentBet - state.bets[seat], state.stacks[seat]);
+}
+
+int RulesEngine::getMinRaiseTo(const TableState& state) {
+    return state.currentBet + state.lastRaise;
+}
+
+int RulesEngine::getPotAmount(const TableState& state) {
+    int pot = 0;
+    for (int seat = 0; seat < state.seatCount; seat++) {
+        pot += state.committed[seat];
+    }
+    return pot;
+}
+
+bool RulesEngine::canRaise(const TableState& state, int seat) {
+    // Повышать есть смысл, только если остались фишки сверх колла и есть кому отвечать
+    uint16_t opponents = state.activeMask & ~state.allInMask & ~(1u << seat);
+    return (state.raiseMask & (1u << seat)) && opponents != 0 &&
+           state.stacks[seat] > state.currentBet - state.bets[seat];
+}
+
+void RulesEngine::putChips(TableState& state, int seat, int amount) {
+    amount = std::min(amount, state.stacks[seat]);
+    state.stacks[seat] -= amount;
+    state.bets[seat] += amount;
+    state.committed[seat] += amount;
+    if (state.stacks[seat] == 0) {
+        state.allInMask |= 1u << seat;
+        state.pendingMask &= ~(1u << seat);
+    }
+}
+
+void RulesEngine::postBlind(TableState& state, int seat, int amount) {
+    if (seat >= 0) {
+        putChips(state, seat, amount);
+    }
+}
+
+void RulesEngine::startHand(TableState& state, int button) {
+    state.button = static_cast<int8_t>(button);
+    state.activeMask = 0;
+    state.allInMask = 0;
+    for (int seat = 0; seat < state.seatCount; seat++) {
+        state.bets[seat] = 0;
+        state.committed[seat] = 0;
+        if (state.stacks[seat] > 0) {
+            state.activeMask |= 1u << seat;
+        }
+    }
+    state.phase = GamePhase::PREFLOP;
+    state.finished = false;
+    state.boardCount = 0;
+    state.lastRaise = state.bigBlind;
+    state.pendingMask = state.activeMask;
+    state.raiseMask = state.activeMask;
+
+    // Хедз-ап: кнопка ставит малый блайнд и ходит первой на префлопе
+    int smallBlindSeat;
+    if (countSeats(state.activeMask) == 2) {
+        smallBlindSeat = (state.activeMask & (1u << button)) ? button : nextSeat(state, button, state.activeMask);
+    } else {
+        smallBlindSeat = nextSeat(state, button, state.activeMask);
+    }
+    int bigBlindSeat = nextSeat(state, smallBlindSeat, state.activeMask);
+    postBlind(state, smallBlindSeat, state.smallBlind);
+    postBlind(state, bigBlindSeat, state.bigBlind);
+    state.currentBet = state.bigBlind;
+
+    state.toAct = -1;
+    advance(state, bigBlindSeat);
+}
+
+int RulesEngine::legalActions(const TableState& state, Action* actions) {
+    if (state.finished || state.toAct < 0) return 0;
+
+    int seat = state.toAct;
+    int count = 0;
+    int toCall = state.currentBet - state.bets[seat];
+    if (toCall > 0) {
+        actions[count++] = { ActionType::FOLD, 0 };
+        actions[count++] = { ActionType::CALL, 0 };
+    } else {
+        actions[count++] = { ActionType::CHECK, 0 };
+    }
+    if (canRaise(state, seat)) {
+        int allInTo = state.bets[seat] + state.stacks[seat];
+        int minRaiseTo = getMinRaiseTo(state);
+        if (minRaiseTo < allInTo) {
+            actions[count++] = { ActionType::RAISE, minRaiseTo };
+        }
+        actions[count++] = { ActionType::ALL_IN, allInTo };
+    }
+    return count;
+}
+
+bool RulesEngine::isLegal(const TableState& state, const Action& action) {
+    if (state.finished || state.toAct < 0) return false;
+
+    int seat = state.toAct;
+    int toCall = state.currentBet - state.bets[seat];
+    switch (action.type) {
+        case ActionType::FOLD:
+            return true;
+        case ActionType::CHECK:
+            return toCall == 0;
+        case ActionType::CALL:
+            return toCall > 0;
+        case ActionType::RAISE:
+            return canRaise(state, seat) && action.amount >= getMinRaiseTo(state) &&
+                   action.amount < state.bets[seat] + state.stacks[seat];
+        case ActionType::ALL_IN:
+            return canRaise(state, seat);
+    }
+    return false;
+}
+
+Action RulesEngine::normalize(const TableState& state, Action action) {
+    if (state.finished || state.toAct < 0) return action;
+
+    int seat = state.toAct;
+    int toCall = state.currentBet - state.bets[seat];
+    Action passive = { toCall > 0 ? ActionType::CALL : ActionType::CHECK, 0 };
+    switch (action.type) {
+        case ActionType::FOLD:
+            return action;
+        case ActionType::CHECK:
+        case ActionType::CALL:
+            return passive;
+        case ActionType::RAISE:
+            if (!canRaise(state, seat)) return passive;
+            action.amount = std::max(action.amount, getMinRaiseTo(state));
+            if (action.amount >= state.bets[seat] + state.stacks[seat]) {
+                return { ActionType::ALL_IN, state.bets[seat] + state.stacks[seat] };
+            }
+            return action;
+        case ActionType::ALL_IN:
+            if (!canRaise(state, seat)) return passive;
+            return { ActionType::ALL_IN, state.bets[seat] + state.stacks[seat] };
+    }
+    return passive;
+}
+
+bool RulesEngine::apply(TableState& state, const Action& action) {
+    if (!isLegal(state, action)) return false;
+
+    int seat = state.toAct;
+    uint16_t seatBit = static_cast<uint16_t>(1u << seat);
+    state.pendingMask &= ~seatBit;
+    state.raiseMask &= ~seatBit;
+
+    switch (action.type) {
+        case ActionType::FOLD:
+            state.activeMask &= ~seatBit;
+            break;
+        case ActionType::CHECK:
+            break;
+        case ActionType::CALL:
+            putChips(state, seat, state.currentBet - state.bets[seat]);
+            break;
+        case ActionType::RAISE:
+            putChips(state, seat, action.amount - state.bets[seat]);
+            break;
+        case ActionType::ALL_IN:
+            putChips(state, seat, state.stacks[seat]);
+            break;
+    }
+
+    if (state.bets[seat] > state.currentBet) {
+        int raiseSize = state.bets[seat] - state.currentBet;
+        // Неполный ва-банк не меняет минимальный шаг повышения и не открывает
+        // повышение уже сходившим: они отвечают на него только коллом или сбросом
+        if (raiseSize >= state.lastRaise) {
+            state.lastRaise = raiseSize;
+            state.raiseMask = state.activeMask & ~state.allInMask & ~seatBit;
+        }
+        state.currentBet = state.bets[seat];
+        state.pendingMask = state.activeMask & ~state.allInMask & ~seatBit;
+    }
+
+    advance(state, seat);
+    return true;
+}
+
+void RulesEngine::advance(TableState& state, int lastSeat) {
+    if (countSeats(state.activeMask) <= 1) {
+        state.finished = true;
+        state.toAct = -1;
+        return;
+    }
+
+    while (true) {
+        uint16_t canAct = state.activeMask & ~state.allInMask;
+        if (countSeats(canAct) <= 1) {
+            // Единственному игроку с фишками ходить нужно только если есть что уравнивать
+            int seat = nextSeat(state, -1, canAct);
+            if (seat >= 0 && state.bets[seat] >= state.currentBet) {
+                state.pendingMask &= ~(1u << seat);
+            }
+        }
+        state.pendingMask &= canAct;
+        if (state.pendingMask) {
+            state.toAct = static_cast<int8_t>(nextSeat(state, lastSeat, state.pendingMask));
+            return;
+        }
+
+        // Улица закончена: переходим к следующей, без торговли - открываем борд до конца
+        for (int seat = 0; seat < state.seatCount; seat++) {
+            state.bets[seat] = 0;
+        }
+        state.currentBet = 0;
+        state.lastRaise = state.bigBlind;
+        switch (state.phase) {
+            case GamePhase::PREFLOP:
+                state.phase = GamePhase::FLOP;
+                state.boardCount = 3;
+                break;
+            case GamePhase::FLOP:
+                state.phase = GamePhase::TURN;
+                state.boardCount = 4;
+                break;
+            case GamePhase::TURN:
+                state.phase = GamePhase::RIVER;
+                state.boardCount = 5;
+                break;
+            case GamePhase::RIVER:
+            case GamePhase::SHOWDOWN:
+                state.phase = GamePhase::SHOWDOWN;
+                state.finished = true;
+                state.toAct = -1;
+                return;
+        }
+        state.pendingMask = canAct;
+        state.raiseMask = canAct;
+        if (countSeats(canAct) < 2) {
+            state.pendingMask = 0;
+        }
+        lastSeat = state.button;
+    }
+}
+
+void RulesEngine::settle(const TableState& state, int32_t payouts[MAX_SEATS]) {
+    for (int seat = 0; seat < MAX_SEATS; seat++) {
+        payouts[seat] = 0;
+    }
+
+    PotLayer layers[MAX_SEATS];
+    int layerCount = SidePots::build(state.committed, state.seatCount, state.activeMask, layers);
+
+    int scores[MAX_SEATS] = {};
+    if (countSeats(state.activeMask) > 1) {
+        CardMask board = 0;
+        for (int i = 0; i < 5; i++) {
+            board |= CardMask(1) << state.board[i];
+        }
+        for (int seat = 0; seat < state.seatCount; seat++) {
+            if (state.activeMask & (1u << seat)) {
+                CardMask hole = (CardMask(1) << state.holeCards[seat][0]) | (CardMask(1) << state.holeCards[seat][1]);
+                scores[seat] = HandEvaluator::evaluateMask(hole | board);
+            }
+        }
+    }
+    SidePots::award(layers, layerCount, scores, state.seatCount, state.button, payouts);
+}
+
+void RulesEngine::applyPayouts(TableState& state, const int32_t payouts[MAX_SEATS]) {
+    for (int seat = 0; seat < state.seatCount; seat++) {
+        state.stacks[seat] += payouts[seat];
+    }
+}
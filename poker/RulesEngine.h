@@ -0,0 +1,81 @@
+#ifndef POKER_RULESENGINE_H
+#define POKER_RULESENGINE_H
+
+#include <cstdint>
+#include "GameBoard.h"
+
+constexpr int MAX_SEATS = 10;
+
+enum class ActionType : uint8_t {
+    FOLD,
+    CHECK,
+    CALL,
+    RAISE,
+    ALL_IN
+};
+
+// Для RAISE amount - итоговая ставка игрока на улице (raise-to), для остальных не используется.
+struct Action {
+    ActionType type;
+    int32_t amount;
+};
+
+// Состояние раздачи безлимитного холдема. POD без указателей: копируется memcpy,
+// подходит для перебора дерева. Битовые маски индексируются номером места.
+struct TableState {
+    int32_t stacks[MAX_SEATS];
+    int32_t bets[MAX_SEATS];       // ставки на текущей улице
+    int32_t committed[MAX_SEATS];  // всё, что внесено за раздачу
+    int32_t currentBet;
+    int32_t lastRaise;
+    int32_t smallBlind;
+    int32_t bigBlind;
+    uint16_t activeMask;           // не сбросившие карты
+    uint16_t allInMask;
+    uint16_t pendingMask;          // кто ещё должен сходить на этой улице
+    uint16_t raiseMask;            // кому открыто повышение: не ходил после последнего полного рейза
+    int8_t seatCount;
+    int8_t button;
+    int8_t toAct;                  // -1, если ходить некому
+    GamePhase phase;
+    bool finished;
+    uint8_t boardCount;            // сколько общих карт открыто
+    uint8_t holeCards[MAX_SEATS][2];
+    uint8_t board[5];              // заранее сданный борд, открывается по улицам
+};
+
+// Правила ставок без ввода-вывода и аллокаций: состояние -> допустимые действия -> apply().
+class RulesEngine {
+public:
+    static constexpr int MAX_LEGAL_ACTIONS = 5;
+
+    // Начинает раздачу: stacks, seatCount, блайнды и карты заполняет вызывающий.
+    // Места с нулевым стеком в раздаче не участвуют.
+    static void startHand(TableState& state, int button);
+
+    static int legalActions(const TableState& state, Action* actions);
+    static bool isLegal(const TableState& state, const Action& action);
+    // Приводит намерение агента к допустимому действию (чек при ставке - колл и т.п.)
+    static Action normalize(const TableState& state, Action action);
+    // Применяет действие игрока toAct; недопустимое действие не меняет состояние.
+    static bool apply(TableState& state, const Action& action);
+
+    // Выплаты по окончании раздачи (в т.ч. сайд-поты); стеки не меняет.
+    static void settle(const TableState& state, int32_t payouts[MAX_SEATS]);
+    static void applyPayouts(TableState& state, const int32_t payouts[MAX_SEATS]);
+
+    static int getToCall(const TableState& state, int seat);
+    static int getMinRaiseTo(const TableState& state);
+    static int getPotAmount(const TableState& state);
+    // Неполный ва-банк не открывает повышение тем, кто уже сходил: им только FOLD/CALL
+    static bool canRaise(const TableState& state, int seat);
+    static int countSeats(uint16_t mask);
+    static int nextSeat(const TableState& state, int from, uint16_t mask);
+
+private:
+    static void postBlind(TableState& state, int seat, int amount);
+    static void putChips(TableState& state, int seat, int amount);
+    static void advance(TableState& state, int lastSeat);
+};
+
+#endif
@@ -0,0 +1,77 @@
+#include "SidePots.h"
+#include <algorithm>
+
+int SidePots::build(const int32_t committed[MAX_SEATS], int seatCount, uint16_t liveMask,
+                    PotLayer layers[MAX_SEATS]) {
+    int8_t order[MAX_SEATS];
+    for (int seat = 0; seat < seatCount; seat++) {
+        order[seat] = static_cast<int8_t>(seat);
+    }
+    std::sort(order, order + seatCount, [committed](int8_t a, int8_t b) {
+        return committed[a] < committed[b];
+    });
+
+    // Проход по уровням снизу вверх: полоса между соседними уровнями собирается
+    // со всех мест, внёсших не меньше её верха, т.е. с текущего и последующих
+    int count = 0;
+    int32_t previousLevel = 0;
+    int32_t layerLevel = 0;
+    int32_t pending = 0;          // собрано с момента закрытия прошлого слоя
+    uint16_t eligible = liveMask; // оставшиеся в игре, кто внёс не меньше текущего уровня
+    for (int i = 0; i < seatCount; i++) {
+        int seat = order[i];
+        int32_t level = committed[seat];
+        pending += (seatCount - i) * (level - previousLevel);
+        previousLevel = level;
+
+        uint16_t seatBit = static_cast<uint16_t>(1u << seat);
+        if (!(liveMask & seatBit)) continue;
+        if (level > layerLevel) {
+            layers[count++] = { pending, eligible };
+            pending = 0;
+            layerLevel = level;
+        }
+        eligible &= ~seatBit;
+    }
+    if (pending > 0) {
+        if (count > 0) {
+            layers[count - 1].amount += pending;
+        } else if (liveMask) {
+            layers[count++] = { pending, liveMask };
+        }
+    }
+    return count;
+}
+
+void SidePots::award(const PotLayer* layers, int layerCount, const int scores[MAX_SEATS],
+                     int seatCount, int button, int32_t payouts[MAX_SEATS]) {
+    uint16_t seen = 0;
+    uint16_t winners = 0;
+    int best = 0;
+    for (int layer = layerCount - 1; layer >= 0; layer--) {
+        uint16_t added = layers[layer].eligible & ~seen;
+        for (int seat = 0; added; seat++) {
+            uint16_t seatBit = static_cast<uint16_t>(1u << seat);
+            if (!(added & seatBit)) continue;
+            added &= ~seatBit;
+            if (winners == 0 || scores[seat] > best) {
+                best = scores[seat];
+                winners = seatBit;
+            } else if (scores[seat] == best) {
+                winners |= seatBit;
+            }
+        }
+        seen = layers[layer].eligible;
+
+        int winnerCount = RulesEngine::countSeats(winners);
+        int32_t share = layers[layer].amount / winnerCount;
+        int32_t oddChips = layers[layer].amount - share * winnerCount;
+        for (int step = 1; step <= seatCount; step++) {
+            int seat = (button + step) % seatCount;
+            if (winners & (1u << seat)) {
+                payouts[seat] += share + (oddChips > 0 ? 1 : 0);
+                oddChips--;
+            }
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef POKER_SIDEPOTS_H
+#define POKER_SIDEPOTS_H
+
+#include <cstdint>
+#include "RulesEngine.h"
+
+// Слой банка: сумма и места, которые его разыгрывают.
+// Слои идут от основного банка к последнему сайд-поту, маски вложены друг в друга.
+struct PotLayer {
+    int32_t amount;
+    uint16_t eligible;
+};
+
+// Основной банк и сайд-поты при любом числе ва-банков.
+class SidePots {
+public:
+    // Слои по взносам за раздачу: одна сортировка мест, затем один проход.
+    // Новый слой начинается на каждом уровне взноса оставшихся в игре (liveMask);
+    // взносы сбросивших выше последнего уровня достаются последнему слою.
+    // Возвращает число слоёв (не больше MAX_SEATS).
+    static int build(const int32_t committed[MAX_SEATS], int seatCount, uint16_t liveMask,
+                     PotLayer layers[MAX_SEATS]);
+
+    // Выплаты по силе рук (больше - сильнее, значения важны только для мест в слоях).
+    // Слои разбираются от последнего к основному: круг претендентов только растёт,
+    // поэтому лучшая рука поддерживается одним проходом по местам.
+    // Нечётные фишки - первым победителям после кнопки. payouts добавляются.
+    static void award(const PotLayer* layers, int layerCount, const int scores[MAX_SEATS],
+                      int seatCount, int button, int32_t payouts[MAX_SEATS]);
+};
+
+#endif
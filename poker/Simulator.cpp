@@ -0,0 +1,120 @@
+#include "Simulator.h"
+#include <chrono>
+
+double SimulationStats::getHandsPerSecond() const {
+    return seconds > 0.0 ? static_cast<double>(hands) / seconds : 0.0;
+}
+
+void SimulationStats::merge(const SimulationStats& other) {
+    hands += other.hands;
+    showdowns += other.showdowns;
+    ties += other.ties;
+    for (int seat = 0; seat < 2; seat++) {
+        wins[seat] += other.wins[seat];
+        netChips[seat] += other.netChips[seat];
+    }
+    if (other.seconds > seconds) {
+        seconds = other.seconds;
+    }
+}
+
+Simulator::Simulator(Agent& first, Agent& second, unsigned seed,
+                     int stack, int smallBlindAmount, int bigBlindAmount)
+    : agents{ &first, &second }, rng(seed), startingStack(stack),
+      smallBlind(smallBlindAmount), bigBlind(bigBlindAmount) {
+}
+
+const SimulationStats& Simulator::run(long long hands) {
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < hands; i++) {
+        playHand(static_cast<int>(stats.hands % 2));
+        stats.hands++;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    stats.seconds += elapsed.count();
+    return stats;
+}
+
+const SimulationStats& Simulator::getStats() const {
+    return stats;
+}
+
+void Simulator::resetStats() {
+    stats = SimulationStats();
+}
+
+void Simulator::reseed(unsigned seed) {
+    rng.seed(seed);
+}
+
+void playTableHand(TableState& state, int button, Agent* const* seatAgents, Deck& deck, std::mt19937& rng,
+                   int* closedBoardCount) {
+    HoleCards holes[MAX_SEATS];
+    BoardCards board;
+    deck.resetDeck(rng);
+    for (int seat = 0; seat < state.seatCount; seat++) {
+        if (state.stacks[seat] <= 0) continue;
+        for (int i = 0; i < 2; i++) {
+            holes[seat].push_back(deck.dealCard());
+            state.holeCards[seat][i] = holes[seat][i].getCode();
+        }
+    }
+    for (int i = 0; i < 5; i++) {
+        board.push_back(deck.dealCard());
+        state.board[i] = board[i].getCode();
+    }
+
+    RulesEngine::startHand(state, button);
+    int lastBoardCount = state.boardCount;
+    while (!state.finished) {
+        lastBoardCount = state.boardCount;
+        int seat = state.toAct;
+        AgentView view;
+        view.table = &state;
+        view.seat = seat;
+        view.holeCards = holes[seat];
+        view.communityCards = CardSpan(board.data(), state.boardCount);
+        view.phase = state.phase;
+        view.potAmount = RulesEngine::getPotAmount(state);
+        view.toCall = RulesEngine::getToCall(state, seat);
+        view.minRaise = state.lastRaise;
+        view.stack = state.stacks[seat];
+
+        BotDecision decision = seatAgents[seat]->decide(view);
+        RulesEngine::apply(state, RulesEngine::normalize(state, Agent::toAction(decision, state)));
+    }
+
+    if (closedBoardCount) {
+        *closedBoardCount = lastBoardCount;
+    }
+
+    int32_t payouts[MAX_SEATS];
+    RulesEngine::settle(state, payouts);
+    RulesEngine::applyPayouts(state, payouts);
+}
+
+void Simulator::playHand(int button) {
+    TableState state;
+    state.seatCount = 2;
+    state.smallBlind = smallBlind;
+    state.bigBlind = bigBlind;
+    for (int seat = 0; seat < 2; seat++) {
+        state.stacks[seat] = startingStack;
+    }
+    playTableHand(state, button, agents, deck, rng);
+
+    if (state.phase == GamePhase::SHOWDOWN) {
+        stats.showdowns++;
+    }
+    int net0 = state.stacks[0] - startingStack;
+    if (net0 > 0) {
+        stats.wins[0]++;
+    } else if (net0 < 0) {
+        stats.wins[1]++;
+    } else {
+        stats.ties++;
+    }
+    for (int seat = 0; seat < 2; seat++) {
+        stats.netChips[seat] += state.stacks[seat] - startingStack;
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef POKER_SIMULATOR_H
+#define POKER_SIMULATOR_H
+
+#include <random>
+#include "Agent.h"
+#include "Deck.h"
+
+struct SimulationStats {
+    long long hands = 0;
+    long long showdowns = 0;
+    long long ties = 0;
+    long long wins[2] = { 0, 0 };
+    long long netChips[2] = { 0, 0 };
+    double seconds = 0.0;
+
+    double getHandsPerSecond() const;
+    // Суммирует счётчики; время берётся максимальное (столы идут параллельно)
+    void merge(const SimulationStats& other);
+};
+
+// Играет раздачу за столом до конца и применяет выплаты к стекам. stacks, seatCount
+// и блайнды заполняет вызывающий; карты сдаются из deck всем местам с фишками.
+// В closedBoardCount (если задан) - сколько карт борда было открыто к моменту
+// последнего действия: меньше 5 при шоудауне означает ва-банк до ривера.
+void playTableHand(TableState& state, int button, Agent* const* seatAgents, Deck& deck, std::mt19937& rng,
+                   int* closedBoardCount = nullptr);
+
+// Хедз-ап раздачи между двумя агентами без консольного ввода-вывода и пауз.
+// Стеки восстанавливаются к началу каждой раздачи, кнопка переходит по очереди.
+class Simulator {
+private:
+    Agent* agents[2];
+    std::mt19937 rng;
+    Deck deck;
+    int startingStack;
+    int smallBlind;
+    int bigBlind;
+    SimulationStats stats;
+
+    void playHand(int button);
+
+public:
+    Simulator(Agent& first, Agent& second, unsigned seed,
+              int stack = 1000, int smallBlindAmount = 5, int bigBlindAmount = 10);
+
+    const SimulationStats& run(long long hands);
+    const SimulationStats& getStats() const;
+    void resetStats();
+    void reseed(unsigned seed);
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef POKER_SPAN_H
+#define POKER_SPAN_H
+
+#include <cstddef>
+
+// Невладеющее представление непрерывного диапазона (аналог std::span из C++20).
+template <typename T>
+class Span {
+private:
+    T* items;
+    size_t count;
+
+public:
+    Span() : items(nullptr), count(0) {}
+    Span(T* first, size_t size) : items(first), count(size) {}
+
+    // Любой непрерывный контейнер с data()/size(): std::vector, StaticVector, std::array.
+    template <typename Container>
+    Span(Container& container) : items(container.data()), count(container.size()) {}
+    template <typename Container>
+    Span(const Container& container) : items(container.data()), count(container.size()) {}
+
+    T* begin() const { return items; }
+    T* end() const { return items + count; }
+    T* data() const { return items; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T& operator[](size_t index) const { return items[index]; }
+    T& front() const { return items[0]; }
+    T& back() const { return items[count - 1]; }
+
+    Span subspan(size_t offset, size_t length) const { return Span(items + offset, length); }
+    Span last(size_t length) const { return Span(items + count - length, length); }
+};
+
+#endif
@@ -39,13 +39,22 @@ std::string StateManager::generateSessionId() {
     return "SESSION_" + std::to_string(dis(gen));
 }
 
+// Объект раздачи на арене держит копию арены: пока кто-то снаружи хранит
+// банк или результат прошлой раздачи, арена не сбрасывается под ним
+template <typename T>
+static std::shared_ptr<T> makeOnArena(const std::shared_ptr<HandArena>& arena) {
+    return std::shared_ptr<T>(new T(arena->getResource()), [arena](T* object) { delete object; });
+}
+
 GameSession* StateManager::createNewSession() {
     GameSession session;
     session.sessionId = generateSessionId();
     session.gameBoard = std::make_shared<GameBoard>();
-    session.bank = std::make_shared<Bank>();
-    session.result = std::make_shared<Result>();
+    session.handArena = std::make_shared<HandArena>();
+    session.bank = makeOnArena<Bank>(session.handArena);
+    session.result = makeOnArena<Result>(session.handArena);
     session.betHistory = std::make_shared<BetHistory>();
+    session.hudStats = std::make_shared<HudStats>();
     
     gameSessions.push_back(session);
     return &gameSessions.back();
@@ -88,11 +97,15 @@ bool StateManager::canTransitionTo(GameState from, GameState to) const {
 
 void StateManager::executeStateTransition(GameState newState) {
     if (currentSession && canTransitionTo(currentSession->currentState, newState)) {
+        GameState previousState = currentSession->currentState;
         currentSession->currentState = newState;
         
         // Execute state-specific actions
         switch (newState) {
             case GameState::PREFLOP:
+                if (previousState != GameState::PAUSED) {
+                    beginHand();
+                }
                 if (currentSession->gameBoard) {
                     currentSession->gameBoard->setPhase(GamePhase::PREFLOP);
                 }
@@ -101,22 +114,37 @@ void StateManager::executeStateTransition(GameState newState) {
                 if (currentSession->gameBoard) {
                     currentSession->gameBoard->setPhase(GamePhase::FLOP);
                 }
+                setHudStreet(GamePhase::FLOP);
                 break;
             case GameState::TURN:
                 if (currentSession->gameBoard) {
                     currentSession->gameBoard->setPhase(GamePhase::TURN);
                 }
+                setHudStreet(GamePhase::TURN);
                 break;
             case GameState::RIVER:
                 if (currentSession->gameBoard) {
                     currentSession->gameBoard->setPhase(GamePhase::RIVER);
                 }
+                setHudStreet(GamePhase::RIVER);
                 break;
             case GameState::SHOWDOWN:
                 if (currentSession->gameBoard) {
                     currentSession->gameBoard->setPhase(GamePhase::SHOWDOWN);
                 }
-                determineWinner();
+                if (currentSession->showdownWinners.empty()) {
+                    determineWinner();
+                    currentSession->showdownWinners.push_back(PlayerRegistry::findId(currentSession->winner));
+                }
+                if (currentSession->hudStats) {
+                    currentSession->hudStats->recordShowdown(currentSession->showdownWinners);
+                    currentSession->hudStats->endHand();
+                }
+                break;
+            case GameState::GAME_OVER:
+                if (currentSession->hudStats) {
+                    currentSession->hudStats->endHand();
+                }
                 break;
             default:
                 break;
@@ -132,14 +160,12 @@ void StateManager::updatePlayerStates() {
     for (const auto& player : currentSession->players) {
         if (player) {
             // Update player states based on game conditions
-            auto it = playerStates.find(player->getName());
-            if (it != playerStates.end() && it->second == PlayerState::ACTIVE) {
+            PlayerState* state = playerStates.find(player->getId());
+            if (state && *state == PlayerState::ACTIVE) {
                 // Check if player can still play
-                auto walletIt = currentSession->playerWallets.find(player->getName());
-                if (walletIt != currentSession->playerWallets.end()) {
-                    if (walletIt->second.getBalance() <= 0) {
-                        playerStates[player->getName()] = PlayerState::OUT_OF_MONEY;
-                    }
+                const Wallet* wallet = currentSession->playerWallets.find(player->getId());
+                if (wallet && wallet->getBalance() <= 0) {
+                    *state = PlayerState::OUT_OF_MONEY;
                 }
             }
         }
@@ -152,8 +178,8 @@ bool StateManager::allPlayersReady() const {
     int activePlayers = 0;
     for (const auto& player : currentSession->players) {
         if (player) {
-            auto it = playerStates.find(player->getName());
-            if (it != playerStates.end() && it->second == PlayerState::ACTIVE) {
+            const PlayerState* state = playerStates.find(player->getId());
+            if (state && *state == PlayerState::ACTIVE) {
                 activePlayers++;
             }
         }
@@ -167,8 +193,8 @@ bool StateManager::hasActivePlayers() const {
     
     for (const auto& player : currentSession->players) {
         if (player) {
-            auto it = playerStates.find(player->getName());
-            if (it != playerStates.end() && it->second == PlayerState::ACTIVE) {
+            const PlayerState* state = playerStates.find(player->getId());
+            if (state && *state == PlayerState::ACTIVE) {
                 return true;
             }
         }
@@ -177,6 +203,40 @@ bool StateManager::hasActivePlayers() const {
     return false;
 }
 
+void StateManager::beginHand() {
+    if (!currentSession || !currentSession->handArena) return;
+
+    // Банк и результат прошлой раздачи уходят вместе с ареной одним сбросом.
+    // Если арену ещё держит снимок сессии или чужой указатель на банк/результат,
+    // новая раздача получает свою арену.
+    currentSession->bank.reset();
+    currentSession->result.reset();
+    if (currentSession->handArena.use_count() == 1) {
+        currentSession->handArena->reset();
+    } else {
+        currentSession->handArena = std::make_shared<HandArena>();
+    }
+    currentSession->bank = makeOnArena<Bank>(currentSession->handArena);
+    currentSession->result = makeOnArena<Result>(currentSession->handArena);
+    currentSession->currentRound = 0;
+    currentSession->winner.clear();
+    currentSession->showdownWinners.clear();
+
+    if (currentSession->hudStats) {
+        std::vector<PlayerId> dealt;
+        for (const auto& player : currentSession->players) {
+            if (player) dealt.push_back(player->getId());
+        }
+        currentSession->hudStats->beginHand(dealt);
+    }
+}
+
+void StateManager::setHudStreet(GamePhase phase) {
+    if (currentSession && currentSession->hudStats) {
+        currentSession->hudStats->setStreet(phase);
+    }
+}
+
 void StateManager::advanceGamePhase() {
     if (!currentSession) return;
     
@@ -215,6 +275,21 @@ void StateManager::handlePlayerAction(const std::string& playerName, const std::
             currentSession->betHistory->addAllIn(playerName, amount, currentSession->currentRound);
         }
     }
+
+    if (currentSession->hudStats) {
+        PlayerId playerId = PlayerRegistry::getId(playerName);
+        if (action == "fold") {
+            currentSession->hudStats->recordAction(playerId, BetAction::FOLD);
+        } else if (action == "check") {
+            currentSession->hudStats->recordAction(playerId, BetAction::CHECK);
+        } else if (action == "call") {
+            currentSession->hudStats->recordAction(playerId, BetAction::CALL);
+        } else if (action == "raise") {
+            currentSession->hudStats->recordAction(playerId, BetAction::RAISE);
+        } else if (action == "all_in") {
+            currentSession->hudStats->recordAction(playerId, BetAction::ALL_IN);
+        }
+    }
     
     // Update player state
     if (action == "fold") {
@@ -255,9 +330,9 @@ void StateManager::distributeWinnings() {
         int potAmount = currentSession->bank->getPotAmount();
         
         // Update winner's wallet
-        auto walletIt = currentSession->playerWallets.find(currentSession->winner);
-        if (walletIt != currentSession->playerWallets.end()) {
-            walletIt->second.winBet(potAmount, currentSession->sessionId);
+        Wallet* wallet = currentSession->playerWallets.find(PlayerRegistry::findId(currentSession->winner));
+        if (wallet) {
+            wallet->winBet(potAmount, currentSession->sessionId);
         }
         
         // Distribute through bank
@@ -297,11 +372,10 @@ bool StateManager::joinGame(const std::string& sessionId, std::shared_ptr<Player
     for (auto& session : gameSessions) {
         if (session.sessionId == sessionId) {
             session.players.push_back(player);
-            playerStates[player->getName()] = PlayerState::WAITING;
+            playerStates[player->getId()] = PlayerState::WAITING;
             
             // Create wallet for player
-            Wallet wallet(player->getName(), 1000);
-            session.playerWallets[player->getName()] = wallet;
+            session.playerWallets[player->getId()] = Wallet(player->getName(), 1000);
             
             return true;
         }
@@ -309,6 +383,16 @@ bool StateManager::joinGame(const std::string& sessionId, std::shared_ptr<Player
     return false;
 }
 
+bool StateManager::joinGame(const std::string& sessionId, std::shared_ptr<BotPlayer> bot) {
+    if (!bot || !joinGame(sessionId, std::static_pointer_cast<Player>(bot))) return false;
+    for (const auto& session : gameSessions) {
+        if (session.sessionId == sessionId) {
+            bot->setHudStats(session.hudStats);
+        }
+    }
+    return true;
+}
+
 bool StateManager::leaveGame(const std::string& sessionId, const std::string& playerName) {
     for (auto& session : gameSessions) {
         if (session.sessionId == sessionId) {
@@ -322,10 +406,11 @@ bool StateManager::leaveGame(const std::string& sessionId, const std::string& pl
             );
             
             // Remove player state
-            playerStates.erase(playerName);
+            PlayerId playerId = PlayerRegistry::findId(playerName);
+            playerStates.erase(playerId);
             
             // Remove player wallet
-            session.playerWallets.erase(playerName);
+            session.playerWallets.erase(playerId);
             
             return true;
         }
@@ -337,7 +422,12 @@ GameSession* StateManager::getCurrentSession() {
     return currentSession;
 }
 
-std::vector<GameSession> StateManager::getAllSessions() const {
+const std::vector<GameSession>& StateManager::getAllSessions() const {
+    return gameSessions;
+}
+
+std::vector<GameSession> StateManager::snapshotSessions() const {
+    // Explicit deep copy (including wallets) for callers that need a stable snapshot
     return gameSessions;
 }
 
@@ -424,6 +514,15 @@ std::string StateManager::getStateString() const {
     }
 }
 
+void StateManager::setShowdownWinners(const std::vector<std::string>& winners) {
+    if (!currentSession) return;
+    currentSession->showdownWinners.clear();
+    for (const auto& name : winners) {
+        currentSession->showdownWinners.push_back(PlayerRegistry::getId(name));
+    }
+    currentSession->winner = winners.empty() ? "" : winners.front();
+}
+
 bool StateManager::isGameActive() const {
     return currentSession && currentSession->gameActive;
 }
@@ -449,9 +548,10 @@ bool StateManager::playerRaise(const std::string& playerName, int amount) {
 }
 
 bool StateManager::playerAllIn(const std::string& playerName) {
-    auto walletIt = currentSession->playerWallets.find(playerName);
-    if (walletIt != currentSession->playerWallets.end()) {
-        int amount = walletIt->second.getBalance();
+    if (!currentSession) return false;
+    const Wallet* wallet = currentSession->playerWallets.find(PlayerRegistry::findId(playerName));
+    if (wallet) {
+        int amount = wallet->getBalance();
         handlePlayerAction(playerName, "all_in", amount);
         return true;
     }
@@ -461,11 +561,17 @@ bool StateManager::playerAllIn(const std::string& playerName) {
 void StateManager::addPlayer(std::shared_ptr<Player> player) {
     if (currentSession && player) {
         currentSession->players.push_back(player);
-        playerStates[player->getName()] = PlayerState::WAITING;
+        playerStates[player->getId()] = PlayerState::WAITING;
         
         // Create wallet for player
-        Wallet wallet(player->getName(), 1000);
-        currentSession->playerWallets[player->getName()] = wallet;
+        currentSession->playerWallets[player->getId()] = Wallet(player->getName(), 1000);
+    }
+}
+
+void StateManager::addPlayer(std::shared_ptr<BotPlayer> bot) {
+    if (currentSession && bot) {
+        addPlayer(std::static_pointer_cast<Player>(bot));
+        bot->setHudStats(currentSession->hudStats);
     }
 }
 
@@ -481,15 +587,17 @@ void StateManager::removePlayer(const std::string& playerName) {
         );
         
         // Remove player state
-        playerStates.erase(playerName);
+        PlayerId playerId = PlayerRegistry::findId(playerName);
+        playerStates.erase(playerId);
         
         // Remove player wallet
-        currentSession->playerWallets.erase(playerName);
+        currentSession->playerWallets.erase(playerId);
     }
 }
 
-std::vector<std::shared_ptr<Player>> StateManager::getPlayers() const {
-    return currentSession ? currentSession->players : std::vector<std::shared_ptr<Player>>();
+const std::vector<std::shared_ptr<Player>>& StateManager::getPlayers() const {
+    static const std::vector<std::shared_ptr<Player>> noPlayers;
+    return currentSession ? currentSession->players : noPlayers;
 }
 
 std::shared_ptr<Player> StateManager::getPlayer(const std::string& playerName) const {
@@ -504,12 +612,12 @@ std::shared_ptr<Player> StateManager::getPlayer(const std::string& playerName) c
 }
 
 PlayerState StateManager::getPlayerState(const std::string& playerName) const {
-    auto it = playerStates.find(playerName);
-    return it != playerStates.end() ? it->second : PlayerState::WAITING;
+    const PlayerState* state = playerStates.find(PlayerRegistry::findId(playerName));
+    return state ? *state : PlayerState::WAITING;
 }
 
 void StateManager::setPlayerState(const std::string& playerName, PlayerState state) {
-    playerStates[playerName] = state;
+    playerStates[PlayerRegistry::getId(playerName)] = state;
 }
 
 int StateManager::getCurrentRound() const {
@@ -600,17 +708,22 @@ void StateManager::displayGameStatus() const {
 
 void StateManager::displayPlayerStatus() const {
     std::cout << "\n=== СТАТУС ИГРОКОВ ===" << std::endl;
-    for (const auto& playerState : playerStates) {
-        std::cout << playerState.first << ": ";
-        switch (playerState.second) {
+    playerStates.forEach([this](PlayerId playerId, PlayerState state) {
+        std::cout << PlayerRegistry::getName(playerId) << ": ";
+        switch (state) {
             case PlayerState::WAITING: std::cout << "Ожидание"; break;
             case PlayerState::ACTIVE: std::cout << "Активен"; break;
             case PlayerState::FOLDED: std::cout << "Сбросил карты"; break;
             case PlayerState::ALL_IN: std::cout << "Ва-банк"; break;
             case PlayerState::OUT_OF_MONEY: std::cout << "Без денег"; break;
         }
+        if (currentSession && currentSession->hudStats && currentSession->hudStats->getHandCount(playerId) > 0) {
+            const HudStats& hud = *currentSession->hudStats;
+            std::cout << " (VPIP " << static_cast<int>(hud.getRate(playerId, HudStat::VPIP) * 100)
+                      << "%, PFR " << static_cast<int>(hud.getRate(playerId, HudStat::PFR) * 100) << "%)";
+        }
         std::cout << std::endl;
-    }
+    });
     std::cout << "====================" << std::endl;
 }
 
@@ -12,6 +12,8 @@
 #include "Result.h"
 #include "BetHistory.h"
 #include "Wallet.h"
+#include "HandArena.h"
+#include "HudStats.h"
 
 enum class GameState {
     MENU,
@@ -37,15 +39,18 @@ struct GameSession {
     std::string sessionId;
     std::vector<std::shared_ptr<Player>> players;
     std::shared_ptr<GameBoard> gameBoard;
+    std::shared_ptr<HandArena> handArena;  // память bank и result текущей раздачи
     std::shared_ptr<Bank> bank;
     std::shared_ptr<Result> result;
     std::shared_ptr<BetHistory> betHistory;
-    std::map<std::string, Wallet> playerWallets;
+    std::shared_ptr<HudStats> hudStats;
+    PlayerTable<Wallet> playerWallets;
     GameState currentState;
     int currentRound;
     int dealerPosition;
     int currentPlayerIndex;
     std::string winner;
+    std::vector<PlayerId> showdownWinners;  // задаёт setShowdownWinners до SHOWDOWN
     bool gameActive;
     
     GameSession() : currentState(GameState::MENU), currentRound(0), 
@@ -56,7 +61,7 @@ class StateManager {
 private:
     std::vector<GameSession> gameSessions;
     GameSession* currentSession;
-    std::map<std::string, PlayerState> playerStates;
+    PlayerTable<PlayerState> playerStates;
     std::map<std::string, std::string> gameSettings;
     bool autoSave;
     std::string saveDirectory;
@@ -72,11 +77,13 @@ private:
     bool allPlayersReady() const;
     bool hasActivePlayers() const;
     
+    void beginHand();
     void advanceGamePhase();
     void handlePlayerAction(const std::string& playerName, const std::string& action, int amount = 0);
     void processBettingRound();
     void determineWinner();
     void distributeWinnings();
+    void setHudStreet(GamePhase phase);
     
     void saveGameState();
     void loadGameState(const std::string& sessionId);
@@ -88,9 +95,12 @@ public:
     
     std::string createNewGame();
     bool joinGame(const std::string& sessionId, std::shared_ptr<Player> player);
+    // Бот за столом получает HUD сессии (setHudStats)
+    bool joinGame(const std::string& sessionId, std::shared_ptr<BotPlayer> bot);
     bool leaveGame(const std::string& sessionId, const std::string& playerName);
     GameSession* getCurrentSession();
-    std::vector<GameSession> getAllSessions() const;
+    const std::vector<GameSession>& getAllSessions() const;
+    std::vector<GameSession> snapshotSessions() const;
     
     bool startGame(const std::string& sessionId);
     bool pauseGame(const std::string& sessionId);
@@ -102,6 +112,8 @@ public:
     void setState(GameState newState);
     std::string getStateString() const;
     bool isGameActive() const;
+    // Победители вскрытия текущей раздачи для HUD; без них победитель - первый игрок
+    void setShowdownWinners(const std::vector<std::string>& winners);
     
     bool playerFold(const std::string& playerName);
     bool playerCheck(const std::string& playerName);
@@ -110,8 +122,9 @@ public:
     bool playerAllIn(const std::string& playerName);
     
     void addPlayer(std::shared_ptr<Player> player);
+    void addPlayer(std::shared_ptr<BotPlayer> bot);
     void removePlayer(const std::string& playerName);
-    std::vector<std::shared_ptr<Player>> getPlayers() const;
+    const std::vector<std::shared_ptr<Player>>& getPlayers() const;
     std::shared_ptr<Player> getPlayer(const std::string& playerName) const;
     PlayerState getPlayerState(const std::string& playerName) const;
     void setPlayerState(const std::string& playerName, PlayerState state);
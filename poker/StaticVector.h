@@ -0,0 +1,65 @@
+#ifndef POKER_STATICVECTOR_H
+#define POKER_STATICVECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include "Span.h"
+
+// Вектор фиксированной ёмкости с хранением внутри объекта: не обращается к куче.
+// Добавление сверх ёмкости - ошибка вызывающего кода (assert), проверок в сборке
+// без assert нет: внешний ввод проверяется до push_back (см. full()).
+template <typename T, size_t N>
+class StaticVector {
+private:
+    std::array<T, N> items;
+    size_t count = 0;
+
+public:
+    StaticVector() = default;
+    StaticVector(Span<const T> values) { append(values); }
+
+    void push_back(const T& value) {
+        assert(count < N && "StaticVector: превышена ёмкость");
+        items[count++] = value;
+    }
+    void pop_back() {
+        if (count > 0) {
+            count--;
+        }
+    }
+    void append(Span<const T> values) {
+        for (const T& value : values) {
+            push_back(value);
+        }
+    }
+    void clear() { count = 0; }
+
+    size_t size() const { return count; }
+    static constexpr size_t capacity() { return N; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == N; }
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+    T& back() { return items[count - 1]; }
+    const T& back() const { return items[count - 1]; }
+    T* data() { return items.data(); }
+    const T* data() const { return items.data(); }
+    T* begin() { return items.data(); }
+    T* end() { return items.data() + count; }
+    const T* begin() const { return items.data(); }
+    const T* end() const { return items.data() + count; }
+
+    bool operator==(const StaticVector& other) const {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+    bool operator!=(const StaticVector& other) const { return !(*this == other); }
+    bool operator<(const StaticVector& other) const {
+        return std::lexicographical_compare(begin(), end(), other.begin(), other.end());
+    }
+    bool operator>(const StaticVector& other) const { return other < *this; }
+};
+
+#endif
@@ -0,0 +1,55 @@
+#include "Statistics.h"
+#include <cmath>
+
+RunningStats::RunningStats() : count(0), mean(0.0), m2(0.0) {
+}
+
+void RunningStats::add(double value) {
+    count++;
+    double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+}
+
+void RunningStats::merge(const RunningStats& other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    long long total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * static_cast<double>(other.count) / static_cast<double>(total);
+    m2 += other.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / static_cast<double>(total);
+    count = total;
+}
+
+void RunningStats::reset() {
+    count = 0;
+    mean = 0.0;
+    m2 = 0.0;
+}
+
+long long RunningStats::getCount() const {
+    return count;
+}
+
+double RunningStats::getMean() const {
+    return mean;
+}
+
+double RunningStats::getVariance() const {
+    return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0;
+}
+
+double RunningStats::getStandardDeviation() const {
+    return std::sqrt(getVariance());
+}
+
+double RunningStats::getStandardError() const {
+    return count > 0 ? std::sqrt(getVariance() / static_cast<double>(count)) : 0.0;
+}
+
+double RunningStats::getHalfWidth(double z) const {
+    return z * getStandardError();
+}
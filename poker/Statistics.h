@@ -0,0 +1,27 @@
+#ifndef POKER_STATISTICS_H
+#define POKER_STATISTICS_H
+
+// Среднее и дисперсия выборки за один проход (алгоритм Уэлфорда) без хранения значений.
+class RunningStats {
+private:
+    long long count;
+    double mean;
+    double m2;   // сумма квадратов отклонений от текущего среднего
+
+public:
+    RunningStats();
+
+    void add(double value);
+    void merge(const RunningStats& other);
+    void reset();
+
+    long long getCount() const;
+    double getMean() const;
+    double getVariance() const;          // несмещённая
+    double getStandardDeviation() const;
+    double getStandardError() const;
+    // Полуширина доверительного интервала для среднего: z * стандартная ошибка
+    double getHalfWidth(double z) const;
+};
+
+#endif
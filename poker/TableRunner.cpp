@@ -0,0 +1,63 @@
+#include "TableRunner.h"
+#include <algorithm>
+#include <chrono>
+
+TableRunner::TableRunner(AgentFactory agentFactory, const RunnerConfig& runnerConfig)
+    : factory(std::move(agentFactory)), config(runnerConfig) {
+}
+
+unsigned TableRunner::getTableSeed(unsigned seed, int table) {
+    // splitmix-перемешивание, чтобы соседние столы не получали похожие зёрна
+    unsigned long long x = (static_cast<unsigned long long>(seed) << 32) + static_cast<unsigned>(table);
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<unsigned>(x ^ (x >> 31));
+}
+
+void TableRunner::runTables(unsigned worker, int firstTable, int lastTable) {
+    std::unique_ptr<WorkerArena>& slot = arenas[worker];
+    if (!slot) {
+        // Арена создаётся самим потоком: память оказывается рядом с его ядром
+        slot = std::make_unique<WorkerArena>();
+        slot->agents[0] = factory(0);
+        slot->agents[1] = factory(1);
+        slot->simulator = std::make_unique<Simulator>(*slot->agents[0], *slot->agents[1], 0,
+                                                      config.stack, config.smallBlind, config.bigBlind);
+    }
+    WorkerArena& arena = *slot;
+
+    for (int table = firstTable; table < lastTable; table++) {
+        unsigned tableSeed = getTableSeed(config.seed, table);
+        arena.simulator->reseed(tableSeed);
+        arena.agents[0]->reseed(tableSeed * 2 + 1);
+        arena.agents[1]->reseed(tableSeed * 2 + 2);
+        arena.simulator->resetStats();
+        arena.stats.merge(arena.simulator->run(config.handsPerTable));
+    }
+}
+
+SimulationStats TableRunner::run(ThreadPool& pool) {
+    arenas.clear();
+    arenas.resize(pool.getThreadCount());
+
+    auto start = std::chrono::steady_clock::now();
+    int step = std::max(1, config.tablesPerTask);
+    for (int first = 0; first < config.tables; first += step) {
+        int last = std::min(config.tables, first + step);
+        pool.submit([this, first, last](unsigned worker) {
+            runTables(worker, first, last);
+        });
+    }
+    pool.wait();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    SimulationStats total;
+    for (const auto& arena : arenas) {
+        if (arena) {
+            total.merge(arena->stats);
+        }
+    }
+    total.seconds = elapsed.count();
+    return total;
+}
@@ -0,0 +1,51 @@
+#ifndef POKER_TABLERUNNER_H
+#define POKER_TABLERUNNER_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Agent.h"
+#include "Simulator.h"
+#include "ThreadPool.h"
+
+struct RunnerConfig {
+    int tables = 1000;
+    long long handsPerTable = 1000;
+    unsigned seed = 1;
+    int tablesPerTask = 8;      // столов в одной задаче пула
+    int stack = 1000;
+    int smallBlind = 5;
+    int bigBlind = 10;
+};
+
+// Создаёт агента для места 0 или 1; вызывается один раз на поток пула.
+using AgentFactory = std::function<std::unique_ptr<Agent>(int seat)>;
+
+// Прогоняет много независимых хедз-ап столов на пуле потоков. У каждого потока
+// своя арена (агенты, симулятор, счётчики), которую он переиспользует для всех
+// своих столов; итоги сливаются после завершения всех задач. Стол с номером i
+// всегда играется с одним и тем же зерном, поэтому результат не зависит от
+// числа потоков и порядка кражи задач.
+class TableRunner {
+private:
+    struct alignas(64) WorkerArena {
+        std::unique_ptr<Agent> agents[2];
+        std::unique_ptr<Simulator> simulator;
+        SimulationStats stats;
+    };
+
+    AgentFactory factory;
+    RunnerConfig config;
+    std::vector<std::unique_ptr<WorkerArena>> arenas;
+
+    void runTables(unsigned worker, int firstTable, int lastTable);
+
+public:
+    TableRunner(AgentFactory agentFactory, const RunnerConfig& runnerConfig);
+
+    SimulationStats run(ThreadPool& pool);
+
+    static unsigned getTableSeed(unsigned seed, int table);
+};
+
+#endif
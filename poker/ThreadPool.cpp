@@ -0,0 +1,115 @@
+#include "ThreadPool.h"
+
+namespace {
+    // Пул и номер потока, если код выполняется внутри пула
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local unsigned currentWorker = 0;
+}
+
+ThreadPool::ThreadPool(unsigned threadCount) : pending(0), nextQueue(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    for (unsigned i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; i++) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+unsigned ThreadPool::getThreadCount() const {
+    return static_cast<unsigned>(queues.size());
+}
+
+void ThreadPool::submit(Task task) {
+    unsigned index = currentPool == this
+        ? currentWorker
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % getThreadCount();
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Захват мьютекса не даёт уведомлению проскочить мимо засыпающего потока
+        std::lock_guard<std::mutex> lock(stateMutex);
+    }
+    wakeup.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    idle.wait(lock, [this] { return pending.load() == 0; });
+}
+
+bool ThreadPool::popLocal(unsigned index, Task& task) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(unsigned index, Task& task) {
+    unsigned count = getThreadCount();
+    for (unsigned step = 1; step < count; step++) {
+        WorkerQueue& victim = *queues[(index + step) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            task(index);
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex);
+        if (stopping) return;
+        // Очереди проверяются повторно под мьютексом: задача могла прийти между проверкой и сном
+        wakeup.wait(lock, [this] {
+            if (stopping) return true;
+            for (const auto& queue : queues) {
+                std::lock_guard<std::mutex> queueLock(queue->mutex);
+                if (!queue->tasks.empty()) return true;
+            }
+            return false;
+        });
+        if (stopping) return;
+    }
+}
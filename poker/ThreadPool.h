@@ -0,0 +1,54 @@
+#ifndef POKER_THREADPOOL_H
+#define POKER_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков с кражей работы: у каждого потока своя очередь, свои задачи он берёт
+// с конца (LIFO, горячий кэш), чужие крадёт с начала. Задача получает номер потока,
+// чтобы пользоваться его локальными данными без синхронизации.
+class ThreadPool {
+public:
+    using Task = std::function<void(unsigned worker)>;
+
+    // 0 - по числу аппаратных потоков
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned getThreadCount() const;
+
+    // Из потока пула задача кладётся в его очередь, снаружи - по кругу.
+    void submit(Task task);
+    // Ждёт, пока не будут выполнены все отправленные задачи.
+    void wait();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex stateMutex;
+    std::condition_variable wakeup;
+    std::condition_variable idle;
+    std::atomic<size_t> pending;
+    std::atomic<unsigned> nextQueue;
+    bool stopping;
+
+    void workerLoop(unsigned index);
+    bool popLocal(unsigned index, Task& task);
+    bool steal(unsigned index, Task& task);
+};
+
+#endif
@@ -0,0 +1,253 @@
+#include "Tournament.h"
+#include <algorithm>
+#include <sstream>
+#include "Simulator.h"
+
+Tournament::Tournament(const TournamentConfig& tournamentConfig, const AgentFactory& factory)
+    : config(tournamentConfig), rng(tournamentConfig.seed) {
+    config.players = std::max(2, config.players);
+    config.seatsPerTable = std::max(2, std::min(config.seatsPerTable, MAX_SEATS));
+    config.handsPerLevel = std::max(1, config.handsPerLevel);
+    config.startingStack = std::max(1, config.startingStack);
+    if (config.levels.empty()) {
+        config.levels = getDefaultSchedule();
+    }
+    totalChips = static_cast<int>(std::min<long long>(std::numeric_limits<int>::max(),
+                                                      static_cast<long long>(config.players) * config.startingStack));
+
+    for (int player = 0; player < config.players; player++) {
+        agents.push_back(factory(player));
+        agents.back()->reseed(rng());
+    }
+    stacks.assign(config.players, config.startingStack);
+}
+
+std::vector<BlindLevel> Tournament::getDefaultSchedule() {
+    return {
+        { 10, 20 }, { 15, 30 }, { 25, 50 }, { 50, 100 }, { 75, 150 },
+        { 100, 200 }, { 150, 300 }, { 200, 400 }, { 300, 600 }, { 400, 800 },
+        { 600, 1200 }, { 800, 1600 }, { 1000, 2000 }, { 1500, 3000 }, { 2000, 4000 }
+    };
+}
+
+std::vector<BlindLevel> Tournament::parseSchedule(const std::string& text) {
+    std::vector<BlindLevel> levels;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        size_t slash = item.find('/');
+        if (slash == std::string::npos) return {};
+        try {
+            BlindLevel level = { std::stoi(item.substr(0, slash)), std::stoi(item.substr(slash + 1)) };
+            if (level.smallBlind <= 0 || level.bigBlind < level.smallBlind) return {};
+            levels.push_back(level);
+        } catch (const std::exception&) {
+            return {};
+        }
+    }
+    return levels;
+}
+
+BlindLevel Tournament::getLevel(const std::vector<BlindLevel>& levels, int index, int maxBigBlind) {
+    if (levels.empty()) {
+        return getLevel(getDefaultSchedule(), index, maxBigBlind);
+    }
+    int last = static_cast<int>(levels.size()) - 1;
+    BlindLevel level = levels[std::max(0, std::min(index, last))];
+    // Удвоение останавливается раньше переполнения int: дальше блайнд больше всех фишек
+    for (int extra = last; extra < index && level.bigBlind <= maxBigBlind / 2; extra++) {
+        level.smallBlind *= 2;
+        level.bigBlind *= 2;
+    }
+    return level;
+}
+
+TournamentResult Tournament::run() {
+    std::vector<int> players(config.players);
+    for (int player = 0; player < config.players; player++) {
+        players[player] = player;
+    }
+    int tableCount = (config.players + config.seatsPerTable - 1) / config.seatsPerTable;
+    drawSeats(players, tableCount);
+
+    int remaining = config.players;
+    while (remaining > 1 && result.rounds < config.maxRounds) {
+        result.finalLevel = static_cast<int>(result.rounds / config.handsPerLevel);
+        playRound(getLevel(config.levels, result.finalLevel, totalChips));
+        result.rounds++;
+
+        remaining = config.players - static_cast<int>(bustOrder.size());
+        bool wasFinalTable = tables.size() == 1;
+        breakTables(remaining);
+        balanceTables();
+
+        // Финальный стол: новая жеребьёвка мест и кнопки
+        if (!wasFinalTable && tables.size() == 1) {
+            std::vector<int> finalists;
+            for (int seat = 0; seat < MAX_SEATS; seat++) {
+                if (tables[0].seats[seat] >= 0) finalists.push_back(tables[0].seats[seat]);
+            }
+            drawSeats(finalists, 1);
+        }
+    }
+
+    // Оставшиеся (обычно один победитель) ранжируются по стеку
+    std::vector<int> survivors;
+    for (const Table& table : tables) {
+        for (int seat = 0; seat < MAX_SEATS; seat++) {
+            if (table.seats[seat] >= 0) survivors.push_back(table.seats[seat]);
+        }
+    }
+    std::stable_sort(survivors.begin(), survivors.end(),
+                     [this](int a, int b) { return stacks[a] > stacks[b]; });
+    result.finishOrder = survivors;
+    result.finishOrder.insert(result.finishOrder.end(), bustOrder.rbegin(), bustOrder.rend());
+    return result;
+}
+
+void Tournament::drawSeats(const std::vector<int>& players, int tableCount) {
+    std::vector<int> order(players);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    tables.assign(tableCount, Table());
+    for (Table& table : tables) {
+        std::fill(std::begin(table.seats), std::end(table.seats), -1);
+        table.count = 0;
+    }
+    // Игроки раздаются по столам по кругу, места за столом - случайные
+    for (size_t i = 0; i < order.size(); i++) {
+        seatAtRandom(tables[i % tableCount], order[i]);
+    }
+    for (Table& table : tables) {
+        table.button = static_cast<int>(rng() % config.seatsPerTable);
+    }
+}
+
+void Tournament::seatAtRandom(Table& table, int player) {
+    int free = config.seatsPerTable - table.count;
+    int pick = static_cast<int>(rng() % free);
+    for (int seat = 0; seat < config.seatsPerTable; seat++) {
+        if (table.seats[seat] < 0 && pick-- == 0) {
+            table.seats[seat] = player;
+            table.count++;
+            return;
+        }
+    }
+}
+
+int Tournament::takeRandomPlayer(Table& table) {
+    int pick = static_cast<int>(rng() % table.count);
+    for (int seat = 0; seat < config.seatsPerTable; seat++) {
+        if (table.seats[seat] >= 0 && pick-- == 0) {
+            int player = table.seats[seat];
+            table.seats[seat] = -1;
+            table.count--;
+            return player;
+        }
+    }
+    return -1;
+}
+
+void Tournament::playRound(const BlindLevel& level) {
+    // Вылетевшие за раунд: (стек на начало раздачи, участник)
+    std::vector<std::pair<int, int>> busted;
+    for (Table& table : tables) {
+        if (table.count >= 2) {
+            playTable(table, level, busted);
+        }
+    }
+    // Одновременно вылетевшие: выше место у того, у кого было больше фишек
+    std::sort(busted.begin(), busted.end());
+    for (const auto& entry : busted) {
+        bustOrder.push_back(entry.second);
+    }
+}
+
+void Tournament::playTable(Table& table, const BlindLevel& level, std::vector<std::pair<int, int>>& busted) {
+    TableState state;
+    state.seatCount = static_cast<int8_t>(config.seatsPerTable);
+    state.smallBlind = level.smallBlind;
+    state.bigBlind = level.bigBlind;
+
+    Agent* seatAgents[MAX_SEATS] = {};
+    uint16_t occupied = 0;
+    for (int seat = 0; seat < config.seatsPerTable; seat++) {
+        int player = table.seats[seat];
+        state.stacks[seat] = player >= 0 ? stacks[player] : 0;
+        if (player >= 0) {
+            seatAgents[seat] = agents[player].get();
+            occupied |= 1u << seat;
+        }
+    }
+
+    table.button = RulesEngine::nextSeat(state, table.button, occupied);
+    int startStacks[MAX_SEATS];
+    std::copy(std::begin(state.stacks), std::end(state.stacks), startStacks);
+    playTableHand(state, table.button, seatAgents, deck, rng);
+    result.hands++;
+
+    for (int seat = 0; seat < config.seatsPerTable; seat++) {
+        int player = table.seats[seat];
+        if (player < 0) continue;
+        stacks[player] = state.stacks[seat];
+        if (stacks[player] == 0) {
+            busted.push_back({ startStacks[seat], player });
+            table.seats[seat] = -1;
+            table.count--;
+        }
+    }
+}
+
+size_t Tournament::findSmallestTable(size_t skip) const {
+    size_t best = tables.size();
+    for (size_t i = 0; i < tables.size(); i++) {
+        if (i != skip && (best == tables.size() || tables[i].count < tables[best].count)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void Tournament::breakTables(int remaining) {
+    size_t needed = static_cast<size_t>((remaining + config.seatsPerTable - 1) / config.seatsPerTable);
+    needed = std::max<size_t>(needed, 1);
+    while (tables.size() > needed) {
+        // Закрывается самый малочисленный стол, его игроки рассаживаются по свободным местам
+        size_t broken = findSmallestTable(tables.size());
+        Table closing = tables[broken];
+        tables.erase(tables.begin() + broken);
+        result.tableBreaks++;
+        while (closing.count > 0) {
+            int player = takeRandomPlayer(closing);
+            seatAtRandom(tables[findSmallestTable(tables.size())], player);
+            result.playerMoves++;
+        }
+    }
+}
+
+void Tournament::balanceTables() {
+    while (tables.size() > 1) {
+        size_t smallest = findSmallestTable(tables.size());
+        size_t largest = 0;
+        for (size_t i = 1; i < tables.size(); i++) {
+            if (tables[i].count > tables[largest].count) largest = i;
+        }
+        if (tables[largest].count - tables[smallest].count <= 1) return;
+        seatAtRandom(tables[smallest], takeRandomPlayer(tables[largest]));
+        result.playerMoves++;
+    }
+}
+
+std::vector<TournamentResult> Tournament::runMany(const TournamentConfig& tournamentConfig,
+                                                  const AgentFactory& factory, int count, ThreadPool& pool) {
+    std::vector<TournamentResult> results(std::max(0, count));
+    for (int i = 0; i < count; i++) {
+        pool.submit([&, i](unsigned) {
+            TournamentConfig config = tournamentConfig;
+            config.seed = TableRunner::getTableSeed(tournamentConfig.seed, i);
+            results[i] = Tournament(config, factory).run();
+        });
+    }
+    pool.wait();
+    return results;
+}
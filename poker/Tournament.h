@@ -0,0 +1,89 @@
+#ifndef POKER_TOURNAMENT_H
+#define POKER_TOURNAMENT_H
+
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Agent.h"
+#include "Deck.h"
+#include "RulesEngine.h"
+#include "TableRunner.h"
+#include "ThreadPool.h"
+
+struct BlindLevel {
+    int smallBlind;
+    int bigBlind;
+};
+
+struct TournamentConfig {
+    int players = 90;
+    int seatsPerTable = 9;
+    int startingStack = 3000;
+    int handsPerLevel = 10;          // раздач за каждым столом на уровень
+    std::vector<BlindLevel> levels;  // пусто - стандартная сетка
+    long long maxRounds = 100000;    // страховка от бесконечного турнира
+    unsigned seed = 1;
+};
+
+struct TournamentResult {
+    std::vector<int> finishOrder;    // номера участников: победитель первым
+    long long hands = 0;
+    long long rounds = 0;            // раунд - по одной раздаче за каждым столом
+    int finalLevel = 0;
+    int tableBreaks = 0;
+    int playerMoves = 0;
+};
+
+// Турнир на выбывание за несколькими столами поверх движка правил: уровни
+// блайндов, вылеты, закрытие столов с пересадкой, балансировка (разница в
+// числе игроков за столами не больше одного) и жеребьёвка мест за финальным
+// столом. Агентов создаёт фабрика по номеру участника.
+class Tournament {
+private:
+    struct Table {
+        int seats[MAX_SEATS];        // номер участника или -1
+        int button;
+        int count;
+    };
+
+    TournamentConfig config;
+    int totalChips;                  // не больше INT_MAX
+    std::vector<std::unique_ptr<Agent>> agents;
+    std::vector<int> stacks;
+    std::vector<Table> tables;
+    std::vector<int> bustOrder;      // от первого вылетевшего
+    std::mt19937 rng;
+    Deck deck;
+    TournamentResult result;
+
+    void drawSeats(const std::vector<int>& players, int tableCount);
+    void playRound(const BlindLevel& level);
+    void playTable(Table& table, const BlindLevel& level, std::vector<std::pair<int, int>>& busted);
+    void breakTables(int remaining);
+    void balanceTables();
+    void seatAtRandom(Table& table, int player);
+    int takeRandomPlayer(Table& table);
+    size_t findSmallestTable(size_t skip) const;
+
+public:
+    Tournament(const TournamentConfig& tournamentConfig, const AgentFactory& factory);
+
+    TournamentResult run();
+
+    static std::vector<BlindLevel> getDefaultSchedule();
+    // "10/20,15/30,25/50" -> уровни; пустой список при ошибке формата
+    static std::vector<BlindLevel> parseSchedule(const std::string& text);
+    // Уровни за пределами сетки удваивают последний, пока большой блайнд не дойдёт
+    // до maxBigBlind (все фишки турнира); пустая сетка - стандартная
+    static BlindLevel getLevel(const std::vector<BlindLevel>& levels, int index,
+                               int maxBigBlind = std::numeric_limits<int>::max());
+
+    // Независимые турниры на пуле потоков; турнир i получает своё зерно,
+    // так что результаты не зависят от числа потоков.
+    static std::vector<TournamentResult> runMany(const TournamentConfig& tournamentConfig,
+                                                 const AgentFactory& factory, int count, ThreadPool& pool);
+};
+
+#endif
@@ -4,21 +4,56 @@
 #include <algorithm>
 #include <map>
 #include <sstream>
+#include "CsvIngest.h"
 
-Wallet::Wallet() : balance(1000), ownerName("Unknown"), filename("wallet.txt"), 
+namespace {
+
+const char CSV_HEADER[] = "Type,Amount,Description,Timestamp,BalanceAfter";
+
+const char* const TYPE_NAMES[] = {
+    "DEPOSIT", "WITHDRAWAL", "BET", "WIN", "LOSS", "REFUND", "BONUS"
+};
+
+bool parseType(std::string_view text, TransactionType& type) {
+    for (size_t i = 0; i < sizeof(TYPE_NAMES) / sizeof(TYPE_NAMES[0]); i++) {
+        if (text == TYPE_NAMES[i]) {
+            type = static_cast<TransactionType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+struct CsvTransactionRow {
+    TransactionType type;
+    int amount;
+    std::string_view description;  // в окне чтения до слияния
+    int64_t timeMs;
+    int balanceAfter;
+};
+
+struct CsvTransactionChunk {
+    std::vector<CsvTransactionRow> rows;
+    std::vector<uint32_t> commas;
+    TimestampParser timestamps;
+};
+
+}
+
+Wallet::Wallet() : balance(1000), ownerId(INVALID_PLAYER_ID), nextSequence(0), filename("wallet.txt"), 
                    autoSave(false), maxBalance(100000), minBalance(0) {
     transactionHistory.clear();
 }
 
 Wallet::Wallet(const std::string& owner, int initialBalance) 
-    : balance(initialBalance), ownerName(owner), filename("wallet.txt"), 
+    : balance(initialBalance), ownerId(PlayerRegistry::getId(owner)), nextSequence(0), filename("wallet.txt"), 
       autoSave(false), maxBalance(100000), minBalance(0) {
     transactionHistory.clear();
     addTransaction(TransactionType::DEPOSIT, initialBalance, "Начальный баланс");
 }
 
 Wallet::Wallet(const std::string& owner, int initialBalance, const std::string& file) 
-    : balance(initialBalance), ownerName(owner), filename(file), 
+    : balance(initialBalance), ownerId(PlayerRegistry::getId(owner)), nextSequence(0), filename(file), 
       autoSave(false), maxBalance(100000), minBalance(0) {
     transactionHistory.clear();
     addTransaction(TransactionType::DEPOSIT, initialBalance, "Начальный баланс");
@@ -173,7 +208,7 @@ bool Wallet::isWithinLimits(int amount) const {
     return amount >= minBalance && amount <= maxBalance;
 }
 
-std::vector<Transaction> Wallet::getTransactionHistory() const {
+const std::vector<Transaction>& Wallet::getTransactionHistory() const {
     return transactionHistory;
 }
 
@@ -187,10 +222,10 @@ std::vector<Transaction> Wallet::getTransactionsByType(TransactionType type) con
     return filtered;
 }
 
-std::vector<Transaction> Wallet::getRecentTransactions(int count) const {
-    std::vector<Transaction> recent = transactionHistory;
-    if (recent.size() > count) {
-        recent.erase(recent.begin(), recent.end() - count);
+Span<const Transaction> Wallet::getRecentTransactions(int count) const {
+    Span<const Transaction> recent(transactionHistory);
+    if (count >= 0 && recent.size() > static_cast<size_t>(count)) {
+        return recent.last(count);
     }
     return recent;
 }
@@ -292,29 +327,24 @@ void Wallet::saveToFile() const {
 }
 
 void Wallet::saveToFile(const std::string& file) const {
-    std::ofstream outFile(file);
-    if (!outFile.is_open()) {
-        std::cout << "Ошибка: Не удалось открыть файл " << file << " для записи" << std::endl;
+    CsvWriter writer;
+    if (!writer.open(file)) {
         return;
     }
     
-    outFile << "Owner: " << ownerName << std::endl;
-    outFile << "Balance: " << balance << std::endl;
-    outFile << "MaxBalance: " << maxBalance << std::endl;
-    outFile << "MinBalance: " << minBalance << std::endl;
-    outFile << "AutoSave: " << (autoSave ? "true" : "false") << std::endl;
-    outFile << std::endl;
+    writer.addLine("Owner: " + getOwner());
+    writer.addLine("Balance: " + std::to_string(balance));
+    writer.addLine("MaxBalance: " + std::to_string(maxBalance));
+    writer.addLine("MinBalance: " + std::to_string(minBalance));
+    writer.addLine(autoSave ? "AutoSave: true" : "AutoSave: false");
+    writer.addLine("");
     
-    outFile << "Type,Amount,Description,Timestamp,BalanceAfter" << std::endl;
+    writer.addLine(CSV_HEADER);
     for (const auto& transaction : transactionHistory) {
-        outFile << getTransactionTypeString(transaction.type) << ","
-                << transaction.amount << ","
-                << transaction.description << ","
-                << getTimestampString(transaction.timestamp) << ","
-                << transaction.balanceAfter << std::endl;
+        writeTransaction(writer, transaction);
     }
     
-    outFile.close();
+    writer.close();
 }
 
 void Wallet::loadFromFile() {
@@ -331,7 +361,7 @@ void Wallet::loadFromFile(const std::string& file) {
     std::string line;
     std::getline(inFile, line); // Owner
     if (line.find("Owner: ") == 0) {
-        ownerName = line.substr(7);
+        ownerId = PlayerRegistry::getId(line.substr(7));
     }
     
     std::getline(inFile, line); // Balance
@@ -356,35 +386,42 @@ void Wallet::loadFromFile(const std::string& file) {
     
     std::getline(inFile, line); // Empty line
     std::getline(inFile, line); // Header
+    std::streamoff offset = inFile.good() ? static_cast<std::streamoff>(inFile.tellg()) : -1;
+    inFile.close();
     
     transactionHistory.clear();
-    while (std::getline(inFile, line)) {
-        std::istringstream iss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        while (std::getline(iss, token, ',')) {
-            tokens.push_back(token);
-        }
-        
-        if (tokens.size() >= 5) {
-            TransactionType type;
-            std::string typeStr = tokens[0];
-            if (typeStr == "DEPOSIT") type = TransactionType::DEPOSIT;
-            else if (typeStr == "WITHDRAWAL") type = TransactionType::WITHDRAWAL;
-            else if (typeStr == "BET") type = TransactionType::BET;
-            else if (typeStr == "WIN") type = TransactionType::WIN;
-            else if (typeStr == "LOSS") type = TransactionType::LOSS;
-            else if (typeStr == "REFUND") type = TransactionType::REFUND;
-            else if (typeStr == "BONUS") type = TransactionType::BONUS;
-            else continue;
-            
-            Transaction transaction(type, std::stoi(tokens[1]), tokens[2], std::stoi(tokens[4]));
-            transactionHistory.push_back(transaction);
+    if (offset < 0) return;
+    std::vector<CsvTransactionChunk> chunks(CsvIngest::getSlotCount());
+    
+    // Описание - среднее поле: лишние запятые старых файлов относятся к нему
+    auto parse = [&chunks](size_t slot, std::string_view text) {
+        CsvTransactionChunk& chunk = chunks[slot];
+        chunk.rows.clear();
+        std::string_view fields[5];
+        CsvIngest::forEachLine(text, [&chunk, &fields](std::string_view line) {
+            CsvTransactionRow row;
+            if (!CsvIngest::splitFields(line, fields, 5, 2, chunk.commas) || !parseType(fields[0], row.type) ||
+                !CsvIngest::parseNumber(fields[1], row.amount) || !CsvIngest::parseNumber(fields[4], row.balanceAfter)) {
+                return;
+            }
+            if (!chunk.timestamps.parse(fields[3], row.timeMs)) {
+                row.timeMs = -1;
+            }
+            row.description = fields[2];
+            chunk.rows.push_back(row);
+        });
+    };
+    auto merge = [this, &chunks](size_t slot) {
+        for (const CsvTransactionRow& row : chunks[slot].rows) {
+            transactionHistory.emplace_back(row.type, row.amount, CsvIngest::unescape(row.description), row.balanceAfter);
+            transactionHistory.back().sequence = nextSequence++;
+            if (row.timeMs >= 0) {
+                transactionHistory.back().timestamp = std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(row.timeMs)));
+            }
         }
-    }
-    
-    inFile.close();
+    };
+    CsvIngest::ingest(file, offset, static_cast<unsigned>(chunks.size()), parse, merge);
 }
 
 void Wallet::setAutoSave(bool enable) {
@@ -397,7 +434,7 @@ void Wallet::setFilename(const std::string& file) {
 
 void Wallet::displayBalance() const {
     std::cout << "\n=== БАЛАНС КОШЕЛЬКА ===" << std::endl;
-    std::cout << "Владелец: " << ownerName << std::endl;
+    std::cout << "Владелец: " << getOwner() << std::endl;
     std::cout << "Баланс: $" << balance << std::endl;
     std::cout << "Лимиты: $" << minBalance << " - $" << maxBalance << std::endl;
     std::cout << "=====================" << std::endl;
@@ -432,7 +469,7 @@ void Wallet::displayRecentTransactions(int count) const {
 
 void Wallet::displayStatistics() const {
     std::cout << "\n=== СТАТИСТИКА КОШЕЛЬКА ===" << std::endl;
-    std::cout << "Владелец: " << ownerName << std::endl;
+    std::cout << "Владелец: " << getOwner() << std::endl;
     std::cout << "Текущий баланс: $" << balance << std::endl;
     std::cout << "Всего пополнений: $" << getTotalDeposits() << std::endl;
     std::cout << "Всего снятий: $" << getTotalWithdrawals() << std::endl;
@@ -445,7 +482,7 @@ void Wallet::displayStatistics() const {
 }
 
 void Wallet::displaySummary() const {
-    std::cout << "Кошелек " << ownerName << ": $" << balance << std::endl;
+    std::cout << "Кошелек " << getOwner() << ": $" << balance << std::endl;
 }
 
 void Wallet::exportToCSV(const std::string& filename) const {
@@ -453,22 +490,49 @@ void Wallet::exportToCSV(const std::string& filename) const {
 }
 
 void Wallet::exportTransactionsToCSV(const std::string& filename) const {
-    std::ofstream outFile(filename);
-    if (!outFile.is_open()) {
-        std::cout << "Ошибка: Не удалось открыть файл " << filename << " для записи" << std::endl;
+    CsvWriter writer;
+    if (!writer.open(filename)) {
         return;
     }
-    
-    outFile << "Type,Amount,Description,Timestamp,BalanceAfter" << std::endl;
+    writer.addLine(CSV_HEADER);
     for (const auto& transaction : transactionHistory) {
-        outFile << getTransactionTypeString(transaction.type) << ","
-                << transaction.amount << ","
-                << transaction.description << ","
-                << getTimestampString(transaction.timestamp) << ","
-                << transaction.balanceAfter << std::endl;
+        writeTransaction(writer, transaction);
     }
-    
-    outFile.close();
+    writer.close();
+}
+
+size_t Wallet::exportTransactionsToCSV(const std::string& filename, ExportCursor& cursor) const {
+    CsvWriter writer;
+    if (!writer.open(filename, true)) {
+        return 0;
+    }
+    if (writer.startedEmptyFile()) {
+        writer.addLine(CSV_HEADER);
+    }
+    // Номера транзакций растут по порядку истории
+    auto begin = std::lower_bound(transactionHistory.begin(), transactionHistory.end(), cursor.sequence,
+                                  [](const Transaction& transaction, uint64_t sequence) {
+                                      return transaction.sequence < sequence;
+                                  });
+    for (auto it = begin; it != transactionHistory.end(); ++it) {
+        writeTransaction(writer, *it);
+    }
+    if (!writer.close()) {
+        std::cout << "Ошибка: Не удалось записать файл " << filename << std::endl;
+        return 0;
+    }
+    cursor.sequence = nextSequence;
+    return static_cast<size_t>(transactionHistory.end() - begin);
+}
+
+void Wallet::writeTransaction(CsvWriter& writer, const Transaction& transaction) const {
+    writer.addField(TYPE_NAMES[static_cast<size_t>(transaction.type)]);
+    writer.addField(int64_t(transaction.amount));
+    writer.addField(transaction.description);
+    writer.addTimestamp(std::chrono::duration_cast<std::chrono::milliseconds>(
+        transaction.timestamp.time_since_epoch()).count());
+    writer.addField(int64_t(transaction.balanceAfter));
+    writer.endRow();
 }
 
 void Wallet::clearHistory() {
@@ -490,15 +554,26 @@ void Wallet::reset() {
 }
 
 void Wallet::setOwner(const std::string& name) {
-    ownerName = name;
+    ownerId = PlayerRegistry::getId(name);
+}
+
+void Wallet::setOwner(PlayerId id) {
+    ownerId = id;
+}
+
+const std::string& Wallet::getOwner() const {
+    // Кошелёк без владельца не заносит имя в справочник
+    static const std::string unknown = "Unknown";
+    return ownerId == INVALID_PLAYER_ID ? unknown : PlayerRegistry::getName(ownerId);
 }
 
-std::string Wallet::getOwner() const {
-    return ownerName;
+PlayerId Wallet::getOwnerId() const {
+    return ownerId;
 }
 
 void Wallet::addTransaction(TransactionType type, int amount, const std::string& description) {
     Transaction transaction(type, amount, description, balance);
+    transaction.sequence = nextSequence++;
     transactionHistory.push_back(transaction);
 }
 
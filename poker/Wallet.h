@@ -6,6 +6,9 @@
 #include <chrono>
 #include <fstream>
 #include <map>
+#include "Span.h"
+#include "PlayerRegistry.h"
+#include "CsvWriter.h"
 
 enum class TransactionType {
     DEPOSIT,
@@ -23,17 +26,19 @@ struct Transaction {
     std::chrono::system_clock::time_point timestamp;
     std::string description;
     int balanceAfter;
+    uint64_t sequence;  // номер в кошельке, выдаётся при добавлении
     
     Transaction(TransactionType t, int amt, const std::string& desc, int balance)
         : type(t), amount(amt), timestamp(std::chrono::system_clock::now()), 
-          description(desc), balanceAfter(balance) {}
+          description(desc), balanceAfter(balance), sequence(0) {}
 };
 
 class Wallet {
 private:
     int balance;
-    std::string ownerName;
+    PlayerId ownerId;  // INVALID_PLAYER_ID - без владельца, getOwner() даёт "Unknown"
     std::vector<Transaction> transactionHistory;
+    uint64_t nextSequence;  // не сбрасывается при очистке и загрузке истории
     std::string filename;
     bool autoSave;
     int maxBalance;
@@ -42,6 +47,7 @@ private:
     std::string getTransactionTypeString(TransactionType type) const;
     std::string getTimestampString(const std::chrono::system_clock::time_point& time) const;
     void addTransaction(TransactionType type, int amount, const std::string& description);
+    void writeTransaction(CsvWriter& writer, const Transaction& transaction) const;
 
 public:
     Wallet();
@@ -67,9 +73,9 @@ public:
     int getMinBalance() const;
     bool isWithinLimits(int amount) const;
     
-    std::vector<Transaction> getTransactionHistory() const;
+    const std::vector<Transaction>& getTransactionHistory() const;
     std::vector<Transaction> getTransactionsByType(TransactionType type) const;
-    std::vector<Transaction> getRecentTransactions(int count = 10) const;
+    Span<const Transaction> getRecentTransactions(int count = 10) const;
     int getTotalDeposits() const;
     int getTotalWithdrawals() const;
     int getTotalWinnings() const;
@@ -95,6 +101,9 @@ public:
     
     void exportToCSV(const std::string& filename) const;
     void exportTransactionsToCSV(const std::string& filename) const;
+    // Дописывает транзакции после cursor (заголовок - в пустой файл)
+    // и переводит cursor на конец истории. Возвращает число выгруженных строк.
+    size_t exportTransactionsToCSV(const std::string& filename, ExportCursor& cursor) const;
     
     void clearHistory();
     size_t getTransactionCount() const;
@@ -102,7 +111,9 @@ public:
     void reset();
     
     void setOwner(const std::string& name);
-    std::string getOwner() const;
+    void setOwner(PlayerId id);
+    const std::string& getOwner() const;
+    PlayerId getOwnerId() const;
 };
 
 #endif
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+
+#include "Agent.h"
+#include "Arena.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    try {
+        string firstSpec = argc > 1 ? argv[1] : "bot";
+        string secondSpec = argc > 2 ? argv[2] : "bot:raise=0.3";
+        ArenaConfig config;
+        config.seed = argc > 3 ? static_cast<unsigned>(stoul(argv[3])) : 1;
+        config.maxDeals = argc > 4 ? stoll(argv[4]) : config.maxDeals;
+        config.targetHalfWidth = argc > 5 ? stod(argv[5]) : 0.0;
+        config.z = argc > 6 ? stod(argv[6]) : config.z;
+        string mode = argc > 7 ? argv[7] : "duplicate";
+        config.duplicate = mode != "plain";
+        config.allInAdjustment = mode != "plain";
+
+        unique_ptr<Agent> first = Agent::create(firstSpec, "Агент 1", 1);
+        unique_ptr<Agent> second = Agent::create(secondSpec, "Агент 2", 2);
+        if (!first || !second) {
+            cout << "Использование: poker_arena [агент1] [агент2] [seed] [макс. раздач] "
+                    "[точность mb/hand] [z] [duplicate|plain]" << endl;
+            cout << "Агенты: bot, bot:allin=0.6,freq=0.7,raise=0.1,pot=0.75,min=30, call, raise, allin, "
+                    "script:<FKCRA>, pushfold:<N>" << endl;
+            return 1;
+        }
+
+        Arena arena(*first, *second, config);
+        ArenaResult result = arena.run();
+
+        cout << firstSpec << " против " << secondSpec
+             << (config.duplicate ? " (дубликат, поправка на ва-банк)" : " (без уменьшения дисперсии)") << endl;
+        cout << "Сдач: " << result.deals << ", раздач: " << result.hands
+             << ", ва-банков с поправкой: " << result.allInAdjusted << endl;
+        cout << fixed << setprecision(1);
+        cout << "Результат агента 1: " << result.mbPerHand << " ± " << result.halfWidth
+             << " mb/hand (z = " << setprecision(2) << config.z << ")" << endl;
+        cout << setprecision(1) << "Разброс на сдачу: " << result.standardDeviation << " mb" << endl;
+        cout << "Остановка: " << result.stopReason << endl;
+        cout << "Вывод: " << (result.significant ? "различие значимо" : "различие не доказано") << endl;
+        cout << setprecision(3) << "Время: " << result.seconds << " с" << endl;
+    } catch (const exception& e) {
+        cout << "Ошибка: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CardNotation.h"
+#include "Equity.h"
+
+using namespace std;
+
+struct BenchSpot {
+    const char* hero;
+    const char* villain;   // пусто - против одной случайной руки
+    const char* board;
+};
+
+static CardMask toMask(const char* text) {
+    return HandEvaluator::toMask(CardNotation::fromString(text));
+}
+
+static const char* methodName(SamplingMethod method) {
+    switch (method) {
+        case SamplingMethod::RANDOM: return "случайная";
+        case SamplingMethod::STRATIFIED: return "стратифицированная";
+        case SamplingMethod::QUASI_RANDOM: return "квази-случайная";
+    }
+    return "";
+}
+
+// Сравнение методов выборки при одинаковом бюджете: для каждой раздачи эталон
+// считается полным перебором (хедз-ап) или длинной случайной серией, затем каждый
+// метод повторяется с разными зёрнами. Выводятся среднеквадратичная ошибка,
+// средняя заявленная погрешность, доля попаданий эталона в интервал и время.
+int main(int argc, char* argv[]) {
+    try {
+        long long budget = argc > 1 ? stoll(argv[1]) : 2000;
+        int repeats = argc > 2 ? stoi(argv[2]) : 200;
+        unsigned seed = argc > 3 ? static_cast<unsigned>(stoul(argv[3])) : 1;
+
+        const vector<BenchSpot> spots = {
+            { "AsAh", "KdKc", "" },
+            { "AsKh", "QdQc", "" },
+            { "8s7s", "AhKd", "" },
+            { "AhKh", "", "" },
+            { "JcTc", "", "" },
+            { "AhKh", "", "Qh7h2c" },
+        };
+        const SamplingMethod methods[] = {
+            SamplingMethod::RANDOM, SamplingMethod::STRATIFIED, SamplingMethod::QUASI_RANDOM
+        };
+
+        MonteCarloConfig config;
+        config.targetHalfWidth = 0.0;    // фиксированный бюджет: без ранней остановки
+        config.minSamples = budget;
+        config.maxSamples = budget;
+
+        cout << "Бюджет: " << budget << " досдач, повторов: " << repeats << endl;
+        double totalSquared[3] = { 0.0, 0.0, 0.0 };
+        double totalSeconds[3] = { 0.0, 0.0, 0.0 };
+        mt19937 rng(seed);
+        for (const BenchSpot& spot : spots) {
+            CardMask hero = toMask(spot.hero);
+            CardMask villain = *spot.villain ? toMask(spot.villain) : 0;
+            CardMask board = *spot.board ? toMask(spot.board) : 0;
+
+            double reference;
+            if (villain) {
+                reference = Equity::exactHeadsUp(hero, villain, board);
+            } else {
+                MonteCarloConfig longRun = config;
+                longRun.minSamples = longRun.maxSamples = budget * 1000;
+                reference = Equity::vsRandom(hero, board, 1, rng, longRun).mean;
+            }
+
+            cout << "\n" << spot.hero << " против " << (villain ? spot.villain : "случайной руки")
+                 << (*spot.board ? string(", борд ") + spot.board : string())
+                 << fixed << setprecision(4) << ": эталон " << reference << endl;
+
+            for (int m = 0; m < 3; m++) {
+                config.method = methods[m];
+                double squared = 0.0, bounds = 0.0;
+                int covered = 0;
+                auto start = chrono::steady_clock::now();
+                for (int r = 0; r < repeats; r++) {
+                    MonteCarloResult result = villain
+                        ? Equity::headsUp(hero, villain, board, rng, config)
+                        : Equity::vsRandom(hero, board, 1, rng, config);
+                    double error = result.mean - reference;
+                    squared += error * error;
+                    bounds += result.halfWidth;
+                    covered += fabs(error) <= result.halfWidth;
+                }
+                chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+                totalSquared[m] += squared / repeats;
+                totalSeconds[m] += elapsed.count();
+
+                cout << "  " << setw(20) << left << methodName(methods[m]) << right
+                     << " ошибка " << setprecision(4) << sqrt(squared / repeats)
+                     << ", граница " << bounds / repeats
+                     << ", покрытие " << setprecision(0) << 100.0 * covered / repeats << "%"
+                     << ", " << setprecision(1) << 1e6 * elapsed.count() / repeats << " мкс" << endl;
+            }
+        }
+
+        // Выигрыш: во сколько раз меньше времени нужно для той же ошибки, чем у случайной выборки
+        cout << "\nИтог (относительно случайной выборки при равной точности):" << endl;
+        for (int m = 1; m < 3; m++) {
+            double gain = (totalSquared[0] / totalSquared[m]) * (totalSeconds[0] / totalSeconds[m]);
+            cout << "  " << methodName(methods[m]) << ": дисперсия в "
+                 << setprecision(2) << totalSquared[0] / totalSquared[m] << " раз меньше, с учётом времени - в "
+                 << gain << " раз эффективнее" << endl;
+        }
+    } catch (const exception& e) {
+        cout << "Ошибка: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,14 +1,16 @@
+#ifdef _WIN32
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#endif
 #include <iostream>
 #include <string>
 #include <memory>
 #include <limits>
 #include <thread>
 #include <chrono>
-#include <io.h>
-#include <fcntl.h>
 
 #include "Player.h"
 #include "BotPlayer.h"
@@ -17,23 +19,27 @@
 #include "Wallet.h"
 #include "HandEvaluator.h"
 #include "GameBoard.h"
+#include "RulesEngine.h"
+#include "Agent.h"
 
 using namespace std;
 
 class PokerGameManager {
 private:
     StateManager stateManager;
+    string sessionId;   // одна сессия на все раздачи: HUD копится между ними
     shared_ptr<Player> humanPlayer;
     shared_ptr<BotPlayer> botPlayer;
     Wallet playerWallet;
     bool gameRunning;
     Deck gameDeck;
     GameBoard gameBoard;
-    int currentBetAmount;
-    int potSize;
+    TableState table;
     int botBalance;
-    int playerBetAmount;
-    int botBetAmount;
+    int playerPaid;     // сколько уже списано с кошелька в этой раздаче
+    
+    static constexpr int HUMAN_SEAT = 0;
+    static constexpr int BOT_SEAT = 1;
     
     void displayMainMenu();
     void displayGameMenu();
@@ -59,6 +65,8 @@ private:
     void handlePlayerCall();
     void handlePlayerRaise();
     void handlePlayerAllIn();
+    bool applyAction(Action action);
+    void revealBoard();
     bool canCheck();
     bool canCall();
     
@@ -67,7 +75,7 @@ public:
     void run();
 };
 
-PokerGameManager::PokerGameManager() : gameRunning(false), currentBetAmount(0), potSize(0), botBalance(1000), playerBetAmount(0), botBetAmount(0), gameDeck(), gameBoard() {
+PokerGameManager::PokerGameManager() : gameRunning(false), gameDeck(), gameBoard(), table(), botBalance(1000), playerPaid(0) {
     
     stateManager = StateManager();
     playerWallet = Wallet("Player", 1000);
@@ -210,40 +218,43 @@ void PokerGameManager::startNewGame() {
     }
     
     cout << "\n=== НАЧИНАЕМ НОВУЮ ИГРУ ===" << endl;
-    string sessionId = stateManager.createNewGame();
+    if (sessionId.empty()) {
+        sessionId = stateManager.createNewGame();
+        stateManager.addPlayer(humanPlayer);
+        stateManager.addPlayer(botPlayer);
+        stateManager.setState(GameState::WAITING_FOR_PLAYERS);
+    }
     botBalance = 1000;
     cout << "Баланс бота сброшен до $1000" << endl;
-    stateManager.addPlayer(humanPlayer);
-    stateManager.addPlayer(botPlayer);
     stateManager.setPlayerState(humanPlayer->getName(), PlayerState::ACTIVE);
     stateManager.setPlayerState(botPlayer->getName(), PlayerState::ACTIVE);
     
     if (stateManager.startGame(sessionId)) {
-        dealCardsToPlayers();
         gameBoard.resetBoard();
         gameBoard.setBlinds(5, 10);
+        dealCardsToPlayers();
         
-        int smallBlind = 5;
-        int bigBlind = 10;
+        int smallBlind = gameBoard.getSmallBlind();
+        int bigBlind = gameBoard.getBigBlind();
         cout << "\nБлайнды: малый блайнд $" << smallBlind << ", большой блайнд $" << bigBlind << endl;
         
-        botBalance -= smallBlind;
-        botBetAmount = smallBlind;
-        potSize = smallBlind;
-        cout << "Бот делает малый блайнд $" << smallBlind << endl;
-        cout << "Баланс бота: $" << botBalance << endl;
+        table.seatCount = 2;
+        table.smallBlind = smallBlind;
+        table.bigBlind = bigBlind;
+        table.stacks[HUMAN_SEAT] = playerWallet.getBalance();
+        table.stacks[BOT_SEAT] = botBalance;
+        playerPaid = 0;
+        // Бот на кнопке: в хедз-апе он ставит малый блайнд и ходит первым
+        RulesEngine::startHand(table, BOT_SEAT);
         
-        if (playerWallet.canAfford(bigBlind)) {
-            playerWallet.placeBet(bigBlind);
-            playerBetAmount = bigBlind;
-            potSize = smallBlind + bigBlind;
-            cout << "Вы делаете большой блайнд $" << bigBlind << endl;
-            cout << "Ваш баланс: $" << playerWallet.getBalance() << endl;
-        }
+        botBalance = table.stacks[BOT_SEAT];
+        cout << "Бот делает малый блайнд $" << table.committed[BOT_SEAT] << endl;
+        cout << "Баланс бота: $" << botBalance << endl;
         
-        playerBetAmount = 0;
-        botBetAmount = 0;
-        currentBetAmount = 0;
+        playerPaid = table.committed[HUMAN_SEAT];
+        playerWallet.placeBet(playerPaid);
+        cout << "Вы делаете большой блайнд $" << playerPaid << endl;
+        cout << "Ваш баланс: $" << playerWallet.getBalance() << endl;
         
         gameRunning = true;
         playGame();
@@ -253,45 +264,43 @@ void PokerGameManager::startNewGame() {
 }
 
 void PokerGameManager::playGame() {
-    int roundCount = 0;
-    
-    while (gameRunning) {
-        cout << "\n=== ХОД ===" << endl;
-        
-        displayGameState();
-        handlePlayerAction();
-        
-        if (gameRunning) {
+    while (gameRunning && !table.finished) {
+        if (table.toAct == HUMAN_SEAT) {
+            cout << "\n=== ХОД ===" << endl;
+            displayGameState();
+            handlePlayerAction();
+        } else {
             handleBotAction();
         }
         
-        if (roundCount == 0) {
+        if (table.boardCount > gameBoard.getCommunityCards().size() && RulesEngine::countSeats(table.activeMask) > 1) {
+            revealBoard();
+        }
+    }
+    
+    if (table.phase == GamePhase::SHOWDOWN) {
+        cout << "\n=== ШОУДАУН ===" << endl;
+    }
+    determineWinnerAndDistributeWinnings();
+    cout << "\n=== ИГРА ОКОНЧЕНА ===" << endl;
+    gameRunning = false;
+}
+
+void PokerGameManager::revealBoard() {
+    while (gameBoard.getCommunityCards().size() < table.boardCount) {
+        size_t shown = gameBoard.getCommunityCards().size();
+        if (shown == 0) {
             cout << "\n=== ФЛОП ===" << endl;
-            currentBetAmount = 0;
             dealFlop();
-        }
-        else if (roundCount == 1) {
+        } else if (shown == 3) {
             cout << "\n=== ТЕРН ===" << endl;
-            currentBetAmount = 0;
             dealTurn();
-        }
-        else if (roundCount == 2) {
+        } else {
             cout << "\n=== РИВЕР ===" << endl;
-            currentBetAmount = 0;
             dealRiver();
-            cout << "\n=== ШОУДАУН ===" << endl;
-            
-            determineWinnerAndDistributeWinnings();
-            
-            cout << "\n=== ИГРА ОКОНЧЕНА ===" << endl;
-            gameRunning = false;
-            break;
         }
-        
-        roundCount++;
+        stateManager.nextRound();
         this_thread::sleep_for(chrono::milliseconds(500));
-        
-        if (!gameRunning) break;
     }
 }
 
@@ -301,8 +310,8 @@ void PokerGameManager::displayGameState() {
     cout << "Текущий игрок: " << stateManager.getCurrentPlayerName() << endl;
     cout << "Ваш баланс: $" << playerWallet.getBalance() << endl;
     cout << "Баланс бота: $" << botBalance << endl;
-    cout << "Текущая ставка: $" << currentBetAmount << endl;
-    cout << "Банк: $" << potSize << endl;
+    cout << "Текущая ставка: $" << RulesEngine::getToCall(table, HUMAN_SEAT) << endl;
+    cout << "Банк: $" << RulesEngine::getPotAmount(table) << endl;
     
     if (humanPlayer) {
         cout << "\n--- Ваши карты ---" << endl;
@@ -327,10 +336,10 @@ void PokerGameManager::handlePlayerAction() {
     if (canCheck()) {
         cout << menuIndex << ". Чек (Check) - передать ход без ставки" << endl;
     } else if (canCall()) {
-        cout << menuIndex << ". Колл (Call) - принять ставку $" << currentBetAmount << endl;
+        cout << menuIndex << ". Колл (Call) - принять ставку $" << RulesEngine::getToCall(table, HUMAN_SEAT) << endl;
     }
     
-    if (playerWallet.getBalance() > 0) {
+    if (RulesEngine::canRaise(table, HUMAN_SEAT)) {
         cout << "3. Рейз (Raise) - повысить ставку" << endl;
         cout << "4. Ва-банк (All-In)" << endl;
     } else {
@@ -361,14 +370,14 @@ void PokerGameManager::handlePlayerAction() {
             }
             break;
         case 3:
-            if (playerWallet.getBalance() > 0) {
+            if (RulesEngine::canRaise(table, HUMAN_SEAT)) {
                 handlePlayerRaise();
             } else {
                 cout << "У вас нет средств для рейза!" << endl;
             }
             break;
         case 4:
-            if (playerWallet.getBalance() > 0) {
+            if (RulesEngine::canRaise(table, HUMAN_SEAT)) {
                 handlePlayerAllIn();
             } else {
                 cout << "У вас нет средств для ва-банка!" << endl;
@@ -386,66 +395,42 @@ void PokerGameManager::handleBotAction() {
     cout << "\n=== ХОД БОТА ===" << endl;
     
     if (botPlayer) {
-        std::vector<Card> communityCards = gameBoard.getCommunityCards();
-        BotDecision decision = botPlayer->getAction(communityCards, potSize, currentBetAmount, 1000);
+        CardSpan communityCards = gameBoard.getCommunityCards();
+        int toCall = RulesEngine::getToCall(table, BOT_SEAT);
+        botPlayer->setBankroll(botBalance);
+        BotDecision decision = botPlayer->getAction(communityCards, RulesEngine::getPotAmount(table), toCall, botBalance);
         botPlayer->displayDecision(decision);
         
-        int oldBalance = playerWallet.getBalance();
-        switch (decision.action) {
-            case BotAction::FOLD:
+        Action action = RulesEngine::normalize(table, Agent::toAction(decision, table));
+        int before = table.committed[BOT_SEAT];
+        applyAction(action);
+        int added = table.committed[BOT_SEAT] - before;
+        int potSize = RulesEngine::getPotAmount(table);
+        
+        switch (action.type) {
+            case ActionType::FOLD:
                 cout << "Бот сбрасывает карты." << endl;
                 stateManager.playerFold(botPlayer->getName());
                 cout << "\n=== БОТ СБРОСИЛ КАРТЫ ===" << endl;
-                cout << "=== ВЫ ПОБЕДИЛИ! ===" << endl;
-                cout << "Вы выиграли $" << potSize << endl;
-                cout << "Старый баланс: $" << oldBalance << endl;
-                playerWallet.addBonus(potSize, "Победа в покере (бот сбросил)");
-                cout << "Новый баланс: $" << playerWallet.getBalance() << endl;
-                gameRunning = false;
                 break;
-            case BotAction::CHECK:
+            case ActionType::CHECK:
                 cout << "Бот делает чек." << endl;
                 stateManager.playerCheck(botPlayer->getName());
                 break;
-            case BotAction::CALL:
-                {
-                    int callAmount = playerBetAmount - botBetAmount;
-                    if (callAmount > 0) {
-                        cout << "Бот делает колл на $" << callAmount << "." << endl;
-                        botBalance -= callAmount;
-                        botBetAmount += callAmount;
-                        potSize += callAmount;
-                        currentBetAmount = 0;
-                        cout << "Баланс бота после колла: $" << botBalance << ", банк: $" << potSize << endl;
-                        stateManager.playerCall(botPlayer->getName(), callAmount);
-                    } else {
-                        cout << "Ставки уже уравнены, бот делает чек." << endl;
-                        stateManager.playerCheck(botPlayer->getName());
-                    }
-                }
+            case ActionType::CALL:
+                cout << "Бот делает колл на $" << added << "." << endl;
+                cout << "Баланс бота после колла: $" << botBalance << ", банк: $" << potSize << endl;
+                stateManager.playerCall(botPlayer->getName(), added);
                 break;
-            case BotAction::RAISE:
-                {
-                    int raiseAmount = 30;
-                    int newBotBet = botBetAmount + raiseAmount;
-                    cout << "Бот повышает ставку до $" << newBotBet << " (дополнительно: $" << raiseAmount << ")." << endl;
-                    botBalance -= raiseAmount;
-                    botBetAmount = newBotBet;
-                    potSize += raiseAmount;
-                    currentBetAmount = newBotBet - playerBetAmount;
-                    cout << "Текущая ставка теперь: $" << currentBetAmount << ", банк: $" << potSize << ", баланс бота: $" << botBalance << endl;
-                    stateManager.playerRaise(botPlayer->getName(), newBotBet);
-                }
+            case ActionType::RAISE:
+                cout << "Бот повышает ставку до $" << action.amount << " (дополнительно: $" << added << ")." << endl;
+                cout << "Текущая ставка теперь: $" << RulesEngine::getToCall(table, HUMAN_SEAT) << ", банк: $" << potSize << ", баланс бота: $" << botBalance << endl;
+                stateManager.playerRaise(botPlayer->getName(), action.amount);
                 break;
-            case BotAction::ALL_IN:
-                {
-                    cout << "Бот идет ва-банк!" << endl;
-                    int allInAmount = botBalance;
-                    potSize += allInAmount;
-                    botBalance = 0;
-                    cout << "Бот ставит на кон $" << allInAmount << ". Банк: $" << potSize << ", баланс бота: $" << botBalance << endl;
-                    stateManager.playerAllIn(botPlayer->getName());
-                }
+            case ActionType::ALL_IN:
+                cout << "Бот идет ва-банк!" << endl;
+                cout << "Бот ставит на кон $" << added << ". Банк: $" << potSize << ", баланс бота: $" << botBalance << endl;
+                stateManager.playerAllIn(botPlayer->getName());
                 break;
         }
     }
@@ -461,9 +446,7 @@ void PokerGameManager::dealCardsToPlayers() {
         botPlayer->clearHand();
     }
     
-    playerBetAmount = 0;
-    botBetAmount = 0;
-    currentBetAmount = 0;
+    table = TableState();
     gameDeck.resetDeck();
     gameDeck.shuffle();
     if (humanPlayer) {
@@ -475,14 +458,27 @@ void PokerGameManager::dealCardsToPlayers() {
         botPlayer->addCard(gameDeck.dealCard());
         botPlayer->addCard(gameDeck.dealCard());
     }
+    
+    for (int i = 0; i < 2; i++) {
+        if (humanPlayer) table.holeCards[HUMAN_SEAT][i] = humanPlayer->getHand()[i].getCode();
+        if (botPlayer) table.holeCards[BOT_SEAT][i] = botPlayer->getHand()[i].getCode();
+    }
+    
+    // Борд сдаётся сразу (с прожигом перед каждой улицей) и открывается движком по улицам
+    int dealt = 0;
+    for (int street : { 3, 1, 1 }) {
+        gameDeck.dealCard();
+        for (int i = 0; i < street; i++) {
+            table.board[dealt++] = gameDeck.dealCard().getCode();
+        }
+    }
 }
-
 void PokerGameManager::displayCommunityCards() {
-    auto cards = gameBoard.getCommunityCards();
+    CardSpan cards = gameBoard.getCommunityCards();
     if (!cards.empty()) {
         cout << "\n--- Карты на столе ---" << endl;
         for (size_t i = 0; i < cards.size(); i++) {
-            Card card = cards[i];
+            const Card& card = cards[i];
             cout << "Карта " << (i + 1) << ": " << card.getRank() << " " << card.getSuit() << endl;
         }
         cout << "----------------------" << endl;
@@ -494,13 +490,13 @@ void PokerGameManager::displayCommunityCards() {
 void PokerGameManager::displayPlayerPossibleCombinations() {
     if (!humanPlayer) return;
     
-    std::vector<Card> playerHand = humanPlayer->getHand();
-    std::vector<Card> communityCards = gameBoard.getCommunityCards();
+    CardSpan playerHand = humanPlayer->getHand();
+    CardSpan communityCards = gameBoard.getCommunityCards();
     
     if (playerHand.size() < 2) return;
     
-    std::vector<Card> fullHand = playerHand;
-    fullHand.insert(fullHand.end(), communityCards.begin(), communityCards.end());
+    HandCards fullHand(playerHand);
+    fullHand.append(communityCards);
     
     if (fullHand.size() < 2) {
         cout << "\n--- Ваши карты: ";
@@ -529,103 +525,119 @@ void PokerGameManager::displayPlayerPossibleCombinations() {
 }
 
 void PokerGameManager::dealFlop() {
-    if (!gameDeck.isEmpty()) {
-        gameDeck.dealCard();
-    }
-    for (int i = 0; i < 3 && !gameDeck.isEmpty(); i++) {
-        Card card = gameDeck.dealCard();
-        gameBoard.addCommunityCard(card);
+    for (int i = 0; i < 3; i++) {
+        gameBoard.addCommunityCard(Card::fromCode(table.board[i]));
     }
     displayCommunityCards();
 }
 
 void PokerGameManager::dealTurn() {
-    if (!gameDeck.isEmpty()) {
-        gameDeck.dealCard();
-    }
-    if (!gameDeck.isEmpty()) {
-        Card card = gameDeck.dealCard();
-        gameBoard.addCommunityCard(card);
-    }
+    gameBoard.addCommunityCard(Card::fromCode(table.board[3]));
     displayCommunityCards();
 }
 
 void PokerGameManager::dealRiver() {
-    if (!gameDeck.isEmpty()) {
-        gameDeck.dealCard();
-    }
-    if (!gameDeck.isEmpty()) {
-        Card card = gameDeck.dealCard();
-        gameBoard.addCommunityCard(card);
-    }
+    gameBoard.addCommunityCard(Card::fromCode(table.board[4]));
     displayCommunityCards();
 }
 
 void PokerGameManager::determineWinnerAndDistributeWinnings() {
     if (!humanPlayer || !botPlayer) return;
-    std::vector<Card> playerHand = humanPlayer->getHand();
-    std::vector<Card> botHand = botPlayer->getHand();
-    
-    std::vector<Card> communityCards = gameBoard.getCommunityCards();
-    std::vector<Card> playerFullHand = playerHand;
-    playerFullHand.insert(playerFullHand.end(), communityCards.begin(), communityCards.end());
     
-    std::vector<Card> botFullHand = botHand;
-    botFullHand.insert(botFullHand.end(), communityCards.begin(), communityCards.end());
+    int32_t payouts[MAX_SEATS];
+    RulesEngine::settle(table, payouts);
+    RulesEngine::applyPayouts(table, payouts);
+    botBalance = table.stacks[BOT_SEAT];
+    int oldBalance = playerWallet.getBalance();
     
-    HandEvaluation playerEval = HandEvaluator::evaluateHand(playerFullHand);
-    HandEvaluation botEval = HandEvaluator::evaluateHand(botFullHand);
-    cout << "\n--- ОЦЕНКА РУК ---" << endl;
-    cout << "Ваша лучшая рука: " << playerEval.handName << endl;
-    cout << "Рука бота: " << botEval.handName << endl;
+    if (RulesEngine::countSeats(table.activeMask) == 1) {
+        stateManager.setState(GameState::GAME_OVER);
+        if (payouts[HUMAN_SEAT] > 0) {
+            cout << "=== ВЫ ПОБЕДИЛИ! ===" << endl;
+            cout << "Вы выиграли $" << payouts[HUMAN_SEAT] << endl;
+            cout << "Старый баланс: $" << oldBalance << endl;
+            playerWallet.addBonus(payouts[HUMAN_SEAT], "Победа в покере (бот сбросил)");
+            cout << "Новый баланс: $" << playerWallet.getBalance() << endl;
+        }
+        return;
+    }
     
-    bool playerWins = playerEval.rankValue > botEval.rankValue ||
-                     (playerEval.rankValue == botEval.rankValue && 
-                      playerEval.kickers > botEval.kickers);
+    CardSpan communityCards = gameBoard.getCommunityCards();
+    HandCards playerFullHand(humanPlayer->getHand());
+    playerFullHand.append(communityCards);
     
-    int oldBalance = playerWallet.getBalance();
+    HandCards botFullHand(botPlayer->getHand());
+    botFullHand.append(communityCards);
     
-    if (playerWins) {
+    // Победителя и названия рук определяет та же оценка, что и выплаты движка
+    int playerScore = HandEvaluator::evaluateMask(HandEvaluator::toMask(playerFullHand));
+    int botScore = HandEvaluator::evaluateMask(HandEvaluator::toMask(botFullHand));
+    cout << "\n--- ОЦЕНКА РУК ---" << endl;
+    cout << "Ваша лучшая рука: " << HandEvaluator::getHandName(HandEvaluator::getScoreRank(playerScore)) << endl;
+    cout << "Рука бота: " << HandEvaluator::getHandName(HandEvaluator::getScoreRank(botScore)) << endl;
+    
+    int comparison = (playerScore > botScore) - (playerScore < botScore);
+    vector<string> winners;
+    if (comparison >= 0) winners.push_back(humanPlayer->getName());
+    if (comparison <= 0) winners.push_back(botPlayer->getName());
+    stateManager.setShowdownWinners(winners);
+    stateManager.setState(GameState::SHOWDOWN);
+    if (comparison > 0) {
         cout << "\n=== ВЫ ПОБЕДИЛИ! ===" << endl;
-        cout << "Вы выиграли $" << potSize << endl;
+        cout << "Вы выиграли $" << payouts[HUMAN_SEAT] << endl;
         cout << "Старый баланс: $" << oldBalance << endl;
-        playerWallet.addBonus(potSize, "Победа в покере");
+        playerWallet.addBonus(payouts[HUMAN_SEAT], "Победа в покере");
         cout << "Новый баланс: $" << playerWallet.getBalance() << endl;
-    } else if (playerEval.rankValue < botEval.rankValue ||
-               (playerEval.rankValue == botEval.rankValue && 
-                playerEval.kickers < botEval.kickers)) {
+    } else if (comparison < 0) {
         cout << "\n=== БОТ ПОБЕДИЛ! ===" << endl;
-        cout << "Вы проиграли $" << potSize << endl;
+        cout << "Вы проиграли $" << (playerPaid - payouts[HUMAN_SEAT]) << endl;
+        if (payouts[HUMAN_SEAT] > 0) {
+            playerWallet.addBonus(payouts[HUMAN_SEAT], "Возврат неуравненной ставки");
+        }
     } else {
         cout << "\n=== НИЧЬЯ! ===" << endl;
-        cout << "Возврат $" << (potSize / 2) << endl;
-        playerWallet.addBonus(potSize / 2, "Ничья");
+        cout << "Возврат $" << payouts[HUMAN_SEAT] << endl;
+        playerWallet.addBonus(payouts[HUMAN_SEAT], "Ничья");
         cout << "Новый баланс: $" << playerWallet.getBalance() << endl;
     }
-    potSize = 0;
+}
+
+bool PokerGameManager::applyAction(Action action) {
+    if (!RulesEngine::apply(table, action)) {
+        return false;
+    }
+    // Кошелёк игрока синхронизируется с его взносом в банк
+    int owed = table.committed[HUMAN_SEAT] - playerPaid;
+    if (owed > 0) {
+        playerWallet.placeBet(owed);
+        playerPaid += owed;
+    }
+    botBalance = table.stacks[BOT_SEAT];
+    return true;
 }
 
 bool PokerGameManager::canCheck() {
-    return currentBetAmount == 0;
+    return RulesEngine::getToCall(table, HUMAN_SEAT) == 0;
 }
 
 bool PokerGameManager::canCall() {
-    return currentBetAmount > 0;
+    return RulesEngine::getToCall(table, HUMAN_SEAT) > 0;
 }
 
 void PokerGameManager::handlePlayerFold() {
     if (!humanPlayer) return;
     
+    applyAction({ ActionType::FOLD, 0 });
     cout << "\nВы сбросили карты. Вы выбыли из раздачи." << endl;
     stateManager.playerFold(humanPlayer->getName());
-    gameRunning = false;
 }
 
 void PokerGameManager::handlePlayerCheck() {
     if (!canCheck()) {
-        cout << "Невозможно сделать чек! Есть текущая ставка $" << currentBetAmount << ". Используйте Колл вместо Чека." << endl;
+        cout << "Невозможно сделать чек! Есть текущая ставка $" << RulesEngine::getToCall(table, HUMAN_SEAT) << ". Используйте Колл вместо Чека." << endl;
         return;
     }
+    applyAction({ ActionType::CHECK, 0 });
     stateManager.playerCheck(humanPlayer->getName());
     cout << "Вы сделали чек." << endl;
 }
@@ -637,35 +649,18 @@ void PokerGameManager::handlePlayerCall() {
         cout << "Невозможно сделать колл! Нет текущей ставки. Используйте Чек." << endl;
         return;
     }
-    int callAmount = botBetAmount - playerBetAmount;
-    
-    if (callAmount <= 0) {
-        cout << "Ставки уже уравнены!" << endl;
-        return;
-    }
-    
-    if (playerWallet.canAfford(callAmount)) {
-        playerWallet.placeBet(callAmount);
-        playerBetAmount += callAmount;
-        stateManager.playerCall(humanPlayer->getName(), callAmount);
-        potSize += callAmount;
-        currentBetAmount = 0;
-        cout << "Вы сделали колл на $" << callAmount << "." << endl;
-        cout << "Ваш баланс: $" << playerWallet.getBalance() << endl;
-        cout << "Банк: $" << potSize << endl;
-    } else {
-        cout << "Недостаточно средств для колла! Ваш баланс: $" << playerWallet.getBalance() << endl;
-    }
+    int callAmount = RulesEngine::getToCall(table, HUMAN_SEAT);
+    applyAction({ ActionType::CALL, 0 });
+    stateManager.playerCall(humanPlayer->getName(), callAmount);
+    cout << "Вы сделали колл на $" << callAmount << "." << endl;
+    cout << "Ваш баланс: $" << playerWallet.getBalance() << endl;
+    cout << "Банк: $" << RulesEngine::getPotAmount(table) << endl;
 }
 
 void PokerGameManager::handlePlayerRaise() {
-    if (playerWallet.getBalance() <= 0) {
-        cout << "У вас нет средств для рейза!" << endl;
-        return;
-    }
-    
+    int minRaise = table.lastRaise;
     int raiseAmount;
-    cout << "Введите сумму повышения (минимум $20): ";
+    cout << "Введите сумму повышения (минимум $" << minRaise << "): ";
     if (!(cin >> raiseAmount)) {
         cout << "Неверный ввод!" << endl;
         cin.clear();
@@ -673,35 +668,30 @@ void PokerGameManager::handlePlayerRaise() {
         return;
     }
     
-    if (raiseAmount < 20) {
-        cout << "Минимальный рейз $20!" << endl;
+    if (raiseAmount < minRaise) {
+        cout << "Минимальный рейз $" << minRaise << "!" << endl;
         return;
     }
     
-    int newBetAmount = playerBetAmount + raiseAmount;
-    
-    if (playerWallet.canAfford(newBetAmount)) {
-        playerWallet.placeBet(newBetAmount);
-        playerBetAmount = newBetAmount;
-        stateManager.playerRaise(humanPlayer->getName(), newBetAmount);
-        potSize += newBetAmount;
-        currentBetAmount = playerBetAmount - botBetAmount; // Разница для бота
-        cout << "Вы повысили ставку до $" << playerBetAmount << " (дополнительно: $" << raiseAmount << ")." << endl;
-        cout << "Бот должен уравнять ставку!" << endl;
-    } else {
+    int newBetAmount = table.currentBet + raiseAmount;
+    if (newBetAmount - table.bets[HUMAN_SEAT] > table.stacks[HUMAN_SEAT]) {
         cout << "Недостаточно средств!" << endl;
+        return;
     }
+    
+    Action action = RulesEngine::normalize(table, { ActionType::RAISE, newBetAmount });
+    applyAction(action);
+    stateManager.playerRaise(humanPlayer->getName(), newBetAmount);
+    cout << "Вы повысили ставку до $" << newBetAmount << " (дополнительно: $" << raiseAmount << ")." << endl;
+    cout << "Бот должен уравнять ставку!" << endl;
 }
 
 void PokerGameManager::handlePlayerAllIn() {
-    int allInAmount = playerWallet.getBalance();
+    int allInAmount = table.stacks[HUMAN_SEAT];
     if (allInAmount > 0) {
-        playerWallet.placeBet(allInAmount);
+        applyAction(RulesEngine::normalize(table, { ActionType::ALL_IN, 0 }));
         stateManager.playerAllIn(humanPlayer->getName());
-        potSize += allInAmount;
         cout << "Вы пошли ва-банк на $" << allInAmount << "!" << endl;
-        
-        currentBetAmount = 0;
         cout << "Вы пошли ва-банк. Ожидайте ответа бота и раскрытия карт!" << endl;
     } else {
         cout << "У вас нет средств для ва-банка!" << endl;
@@ -709,8 +699,10 @@ void PokerGameManager::handlePlayerAllIn() {
 }
 
 int main() {
+#ifdef _WIN32
     SetConsoleOutputCP(65001);
     SetConsoleCP(65001);
+#endif
     
     try {
         PokerGameManager gameManager;
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+
+#include "Agent.h"
+#include "BatchSimulator.h"
+#include "Simulator.h"
+#include "TableRunner.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    try {
+        long long hands = argc > 1 ? stoll(argv[1]) : 100000;
+        unsigned seed = argc > 2 ? static_cast<unsigned>(stoul(argv[2])) : 1;
+        string firstSpec = argc > 3 ? argv[3] : "bot";
+        string secondSpec = argc > 4 ? argv[4] : "call";
+        int tables = argc > 5 ? stoi(argv[5]) : 1;
+        string mode = argc > 6 ? argv[6] : "0";
+        bool batch = mode == "batch";
+        unsigned threads = batch ? 0 : static_cast<unsigned>(stoul(mode));
+
+        unique_ptr<Agent> first = Agent::create(firstSpec, "Агент 1", seed * 2 + 1);
+        unique_ptr<Agent> second = Agent::create(secondSpec, "Агент 2", seed * 2 + 2);
+        if (!first || !second) {
+            cout << "Использование: poker_sim [раздачи] [seed] [агент1] [агент2] [столы] [потоки|batch]" << endl;
+            cout << "Агенты: bot, call, raise, allin, script:<FKCRA>, pushfold:<N>" << endl;
+            cout << "При нескольких столах раздачи считаются на каждый стол" << endl;
+            return 1;
+        }
+        if (batch && (Agent::getPushFoldThreshold(firstSpec) < 0 || Agent::getPushFoldThreshold(secondSpec) < 0)) {
+            cout << "Пакетный режим поддерживает только агентов pushfold:<N>" << endl;
+            return 1;
+        }
+
+        SimulationStats stats;
+        if (batch) {
+            BatchConfig config;
+            config.tables = tables;
+            config.thresholds[0] = Agent::getPushFoldThreshold(firstSpec);
+            config.thresholds[1] = Agent::getPushFoldThreshold(secondSpec);
+            BatchSimulator simulator(config, seed);
+            stats = simulator.run(hands);
+            cout << "Пакетный режим, столов: " << config.tables << endl;
+        } else if (tables > 1) {
+            RunnerConfig config;
+            config.tables = tables;
+            config.handsPerTable = hands;
+            config.seed = seed;
+            TableRunner runner([&](int seat) {
+                return seat == 0 ? Agent::create(firstSpec, first->getName(), seed)
+                                 : Agent::create(secondSpec, second->getName(), seed);
+            }, config);
+            ThreadPool pool(threads);
+            stats = runner.run(pool);
+            cout << "Столов: " << tables << ", потоков: " << pool.getThreadCount() << endl;
+        } else {
+            Simulator simulator(*first, *second, seed);
+            stats = simulator.run(hands);
+        }
+
+        cout << "Сыграно раздач: " << stats.hands << endl;
+        cout << "До шоудауна: " << stats.showdowns << ", ничьих: " << stats.ties << endl;
+        cout << first->getName() << " (" << firstSpec << "): побед " << stats.wins[0]
+             << ", итог $" << stats.netChips[0] << endl;
+        cout << second->getName() << " (" << secondSpec << "): побед " << stats.wins[1]
+             << ", итог $" << stats.netChips[1] << endl;
+        cout << fixed << setprecision(3) << "Время: " << stats.seconds << " с" << endl;
+        cout << setprecision(0) << "Скорость: " << stats.getHandsPerSecond() << " раздач/с" << endl;
+    } catch (const exception& e) {
+        cout << "Ошибка: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
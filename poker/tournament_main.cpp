@@ -0,0 +1,94 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "Agent.h"
+#include "Tournament.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    try {
+        int count = argc > 1 ? stoi(argv[1]) : 100;
+        int players = argc > 2 ? stoi(argv[2]) : 90;
+        unsigned seed = argc > 3 ? static_cast<unsigned>(stoul(argv[3])) : 1;
+        string agentList = argc > 4 ? argv[4] : "bot,call";
+        int seats = argc > 5 ? stoi(argv[5]) : 9;
+        unsigned threads = argc > 6 ? static_cast<unsigned>(stoul(argv[6])) : 0;
+        string schedule = argc > 7 ? argv[7] : "";
+
+        // Участники получают агентов из списка по кругу
+        vector<string> specs;
+        stringstream stream(agentList);
+        string spec;
+        while (getline(stream, spec, ',')) {
+            if (!Agent::create(spec, spec, 0)) {
+                specs.clear();
+                break;
+            }
+            specs.push_back(spec);
+        }
+
+        TournamentConfig config;
+        config.players = players;
+        config.seatsPerTable = seats;
+        config.seed = seed;
+        if (!schedule.empty()) {
+            config.levels = Tournament::parseSchedule(schedule);
+        }
+        if (specs.empty() || (!schedule.empty() && config.levels.empty())) {
+            cout << "Использование: poker_tournament [турниры] [игроков] [seed] [агенты через запятую] "
+                    "[мест за столом] [потоки] [блайнды 10/20,15/30,...]" << endl;
+            cout << "Агенты: bot, call, raise, allin, script:<FKCRA>, pushfold:<N>" << endl;
+            return 1;
+        }
+
+        AgentFactory factory = [&specs](int player) {
+            const string& playerSpec = specs[player % specs.size()];
+            return Agent::create(playerSpec, playerSpec + " #" + to_string(player), player);
+        };
+
+        ThreadPool pool(threads);
+        auto start = chrono::steady_clock::now();
+        vector<TournamentResult> results = Tournament::runMany(config, factory, count, pool);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        long long hands = 0, rounds = 0, breaks = 0, moves = 0, levels = 0;
+        vector<long long> wins(specs.size(), 0);
+        vector<double> placeSum(specs.size(), 0.0);
+        vector<long long> entries(specs.size(), 0);
+        for (const TournamentResult& result : results) {
+            hands += result.hands;
+            rounds += result.rounds;
+            breaks += result.tableBreaks;
+            moves += result.playerMoves;
+            levels += result.finalLevel + 1;
+            for (size_t place = 0; place < result.finishOrder.size(); place++) {
+                size_t type = result.finishOrder[place] % specs.size();
+                placeSum[type] += static_cast<double>(place + 1);
+                entries[type]++;
+                if (place == 0) wins[type]++;
+            }
+        }
+
+        double n = max(1, count);
+        cout << "Турниров: " << count << ", игроков: " << players << ", потоков: " << pool.getThreadCount() << endl;
+        cout << fixed << setprecision(1);
+        cout << "В среднем: раздач " << hands / n << ", раундов " << rounds / n
+             << ", уровней " << levels / n << endl;
+        cout << "Закрыто столов: " << breaks / n << ", пересадок: " << moves / n << " за турнир" << endl;
+        for (size_t type = 0; type < specs.size(); type++) {
+            cout << specs[type] << ": побед " << wins[type] << ", среднее место "
+                 << (entries[type] ? placeSum[type] / entries[type] : 0.0) << endl;
+        }
+        cout << setprecision(3) << "Время: " << elapsed.count() << " с" << endl;
+    } catch (const exception& e) {
+        cout << "Ошибка: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "Arena.h"
+#include "CardNotation.h"
+#include "TestCheck.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+ArenaConfig makeConfig(long long deals, bool duplicate) {
+    ArenaConfig config;
+    config.minDeals = deals;
+    config.maxDeals = deals;
+    config.checkInterval = deals;
+    config.duplicate = duplicate;
+    config.seed = 34;
+    return config;
+}
+
+// Одинаковые агенты на зеркальной сдаче: каждая пара раздач даёт ровно ноль
+void testMirroredDealsCancel() {
+    auto first = Agent::create("call", "ArenaCallA", 1);
+    auto second = Agent::create("call", "ArenaCallB", 2);
+    Arena arena(*first, *second, makeConfig(500, true));
+    ArenaResult result = arena.run();
+    CHECK(result.deals == 500);
+    CHECK(result.hands == 1000);
+    CHECK(result.mbPerHand == 0.0);
+    CHECK(result.standardDeviation == 0.0);
+    CHECK(result.allInAdjusted == 0);
+    CHECK(!result.significant);
+    CHECK(std::strcmp(result.stopReason, "исчерпан лимит раздач") == 0);
+
+    // Без дубликата те же агенты дают разброс по картам
+    Arena plain(*first, *second, makeConfig(500, false));
+    ArenaResult plainResult = plain.run();
+    CHECK(plainResult.hands == 500);
+    CHECK(plainResult.standardDeviation > 0.0);
+}
+
+// Пуш против сброса: половина дубликата на кнопке (+ББ), половина в ББ (+МБ), разброса нет
+void testStopsOnSignificance() {
+    auto pusher = Agent::create("allin", "ArenaPusher", 1);
+    auto folder = Agent::create("script:F", "ArenaFolder", 2);
+    ArenaConfig config = makeConfig(200, true);
+    config.maxDeals = 100000;
+    config.checkInterval = 100;
+    Arena arena(*pusher, *folder, config);
+    ArenaResult result = arena.run();
+    CHECK(result.significant);
+    CHECK(result.deals == 200);
+    CHECK(result.mbPerHand == 750.0);
+    CHECK(std::strcmp(result.stopReason, "различие значимо") == 0);
+}
+
+// Ва-банк до флопа засчитывается по эквити, разброс падает
+void testAllInAdjustment() {
+    auto first = Agent::create("allin", "ArenaAllInA", 1);
+    auto second = Agent::create("allin", "ArenaAllInB", 2);
+    ArenaConfig config = makeConfig(400, false);
+    config.allInAdjustment = false;
+    ArenaResult raw = Arena(*first, *second, config).run();
+    config.allInAdjustment = true;
+    ArenaResult adjusted = Arena(*first, *second, config).run();
+    CHECK(raw.allInAdjusted == 0);
+    CHECK(adjusted.allInAdjusted == adjusted.hands);
+    CHECK(adjusted.standardDeviation < raw.standardDeviation / 2);
+
+    TableState state;
+    std::vector<Card> cards = CardNotation::fromString("AsAhKsKh");
+    CHECK(cards.size() == 4);
+    for (int i = 0; i < 4; i++) {
+        state.holeCards[i / 2][i % 2] = cards[i].getCode();
+    }
+    std::mt19937 rng(1);
+    double equity = Arena::getAllInEquity(state, 0, rng, ArenaConfig().equity);
+    CHECK(equity > 0.78 && equity < 0.86);
+}
+
+}
+
+int main() {
+    testMirroredDealsCancel();
+    testStopsOnSignificance();
+    testAllInAdjustment();
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,128 @@
+#include "Bank.h"
+#include "TestCheck.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+// Итоги по раундам живут одну раздачу, а не всё время жизни банка
+void testRoundTotalsPerHand() {
+    Bank bank;
+    int first = bank.addPlayer("BankTestA");
+    int second = bank.addPlayer("BankTestB");
+    for (int hand = 0; hand < 3; hand++) {
+        bank.placeBet(first, 10);
+        bank.placeBet(second, 10);
+        bank.startNewRound();
+        bank.placeBet(first, 20);
+        CHECK(bank.getCurrentRound() == 1);
+        CHECK(bank.getRoundBetsByPlayer(first, 0) == 10);
+        CHECK(bank.getRoundBetsByPlayer(first, 1) == 20);
+        bank.distributePots({ 1, 0 }, first);
+        CHECK(bank.getCurrentRound() == 0);
+        CHECK(bank.getRoundBetsByPlayer(first, 1) == 0);
+        CHECK(bank.getPotAmount() == 0);
+    }
+    CHECK(bank.getTotalBetsByPlayer(first) == 90);
+}
+
+void testRemovedSeatIsClean() {
+    Bank bank;
+    bank.setAuditMode(true);
+    int first = bank.addPlayer("BankTestA");
+    int second = bank.addPlayer("BankTestB");
+    bank.placeBet(second, 50);
+    bank.removePlayer(second);
+    CHECK(bank.addPlayer("BankTestC") == second);
+    CHECK(bank.getTotalBetsByPlayer(second) == 0);
+    CHECK(bank.getRoundBetsByPlayer(second, 0) == 0);
+    CHECK(bank.getPlayerContribution(second) == 0);
+    CHECK(bank.getPlayerBetHistory(second).empty());
+    CHECK(bank.getSeat("BankTestC") == second);
+    CHECK(bank.getSeat("BankTestA") == first);
+}
+
+// Новый состав стола: сменившие игрока места чистые, оставшийся игрок сохраняет итоги
+void testSetActivePlayersClearsReassignedSeats() {
+    Bank bank;
+    bank.setAuditMode(true);
+    bank.setActivePlayers({ "BankTestA", "BankTestB", "BankTestC" });
+    bank.placeBet(0, 10);
+    bank.placeBet(1, 20);
+    bank.placeBet(2, 30);
+    bank.startNewRound();
+    bank.placeBet(1, 5);
+
+    bank.setActivePlayers({ "BankTestA", "BankTestD" });
+    CHECK(bank.getSeatCount() == 2);
+    CHECK(bank.getTotalBetsByPlayer(0) == 10);
+    CHECK(bank.getTotalBetsByPlayer(1) == 0);
+    CHECK(bank.getRoundBetsByPlayer(1, 0) == 0);
+    CHECK(bank.getRoundBetsByPlayer(1, 1) == 0);
+    CHECK(bank.getPlayerContribution(1) == 0);
+    CHECK(bank.getPlayerBetHistory(1).empty());
+    CHECK(bank.getPlayerBetHistory(0).size() == 1);
+
+    // Освободившееся место 2 не передаёт итоги следующему игроку
+    bank.setActivePlayers({ "BankTestA", "BankTestD", "BankTestE" });
+    CHECK(bank.getTotalBetsByPlayer(2) == 0);
+    CHECK(bank.getPlayerBetHistory(2).empty());
+}
+
+// Маски мест: уравнявшие, сбросившие и ва-банк в allPlayersCalled и сайд-потах
+void testCallFoldMasks() {
+    Bank bank;
+    int a = bank.addPlayer("BankTestA");
+    int b = bank.addPlayer("BankTestB");
+    int c = bank.addPlayer("BankTestC");
+    CHECK(bank.getActiveMask() == 0x07);
+    CHECK(bank.allPlayersCalled());
+
+    bank.placeBet(a, 10);
+    bank.placeBet(b, 10);
+    CHECK(!bank.allPlayersCalled());
+    bank.placeBet(c, 10);
+    CHECK(bank.allPlayersCalled());
+
+    // Рейз снимает отметку колла с остальных
+    bank.placeBet(b, 30);
+    CHECK(bank.getMaxBet() == 40);
+    CHECK(!bank.allPlayersCalled());
+    bank.foldPlayer(c);
+    CHECK(!bank.isPlayerActive(c));
+    CHECK(bank.getActiveMask() == 0x03);
+    CHECK(!bank.allPlayersCalled());
+    // Ва-банк на меньшую сумму уравнивать не обязан
+    bank.placeBet(a, 5, true);
+    CHECK(bank.allPlayersCalled());
+    CHECK(bank.getActivePlayers() == std::vector<std::string>({ "BankTestA", "BankTestB" }));
+
+    // 15 у A, 40 у B, 10 у сбросившего C: основной банк на двоих, остаток B возвращается ему
+    std::vector<PotLayer> pots = bank.getPots();
+    CHECK(pots.size() == 2);
+    CHECK(pots[0].amount == 40 && pots[0].eligible == 0x03);
+    CHECK(pots[1].amount == 25 && pots[1].eligible == 0x02);
+    std::vector<int> winnings = bank.distributePots({ 2, 1, 0 }, c);
+    CHECK(winnings == std::vector<int>({ 40, 25, 0 }));
+
+    // Новая раздача: все снова в игре, ставок нет
+    CHECK(bank.getActiveMask() == 0x07);
+    CHECK(bank.allPlayersCalled());
+    CHECK(bank.getPotAmount() == 0);
+
+    bank.placeBet(a, 20);
+    bank.startNewRound();
+    CHECK(bank.getMaxBet() == 0 && bank.getPlayerBet(a) == 0);
+    CHECK(bank.allPlayersCalled());
+    CHECK(bank.getPlayerContribution(a) == 20);
+}
+
+}
+
+int main() {
+    testRoundTotalsPerHand();
+    testRemovedSeatIsClean();
+    testSetActivePlayersClearsReassignedSeats();
+    testCallFoldMasks();
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,79 @@
+#include "BatchSimulator.h"
+#include "TestCheck.h"
+#include <cmath>
+
+namespace {
+
+BatchConfig makeConfig(int tables, int threshold) {
+    BatchConfig config;
+    config.tables = tables;
+    config.thresholds[0] = threshold;
+    config.thresholds[1] = threshold;
+    return config;
+}
+
+// Никто не пушит: кнопка сбрасывает малый блайнд, до вскрытия не доходит
+void testNobodyPushes() {
+    BatchSimulator simulator(makeConfig(64, 100), 32);
+    const SimulationStats& stats = simulator.run(1);
+    CHECK(stats.hands == 64);
+    CHECK(stats.showdowns == 0 && stats.ties == 0);
+    CHECK(stats.wins[1] == 64);
+    CHECK(stats.netChips[0] == -64 * 5 && stats.netChips[1] == 64 * 5);
+
+    // Кнопка переходит: за два раунда блайнды возвращаются
+    simulator.run(1);
+    CHECK(stats.hands == 128);
+    CHECK(stats.netChips[0] == 0 && stats.netChips[1] == 0);
+}
+
+// Пушат и отвечают всегда: каждая раздача - вскрытие на весь стек
+void testEveryoneAllIn() {
+    BatchSimulator simulator(makeConfig(100, -100), 32);
+    const SimulationStats& stats = simulator.run(20);
+    CHECK(stats.hands == 2000);
+    CHECK(stats.showdowns == stats.hands);
+    CHECK(stats.wins[0] + stats.wins[1] + stats.ties == stats.hands);
+    CHECK(stats.netChips[0] == -stats.netChips[1]);
+    CHECK(stats.netChips[0] == (stats.wins[0] - stats.wins[1]) * 1000);
+    CHECK(stats.ties > 0);
+}
+
+// Одинаковое зерно - одинаковые итоги
+void testDeterministic() {
+    BatchSimulator first(makeConfig(128, 8), 77);
+    BatchSimulator second(makeConfig(128, 8), 77);
+    const SimulationStats& a = first.run(10);
+    const SimulationStats& b = second.run(10);
+    CHECK(a.hands == 1280 && a.hands == b.hands);
+    CHECK(a.showdowns == b.showdowns && a.ties == b.ties);
+    CHECK(a.wins[0] == b.wins[0] && a.wins[1] == b.wins[1]);
+    CHECK(a.netChips[0] == b.netChips[0] && a.netChips[1] == b.netChips[1]);
+    CHECK(a.netChips[0] == -a.netChips[1]);
+}
+
+// Пакетный режим играет как два PushFoldAgent в Simulator: доля вскрытий совпадает
+void testMatchesPushFoldAgents() {
+    BatchSimulator batch(makeConfig(1000, 8), 5);
+    const SimulationStats& batchStats = batch.run(20);
+
+    auto first = Agent::create("pushfold:8", "BatchA", 1);
+    auto second = Agent::create("pushfold:8", "BatchB", 2);
+    Simulator simulator(*first, *second, 5);
+    const SimulationStats& agentStats = simulator.run(20000);
+
+    double batchRate = static_cast<double>(batchStats.showdowns) / batchStats.hands;
+    double agentRate = static_cast<double>(agentStats.showdowns) / agentStats.hands;
+    CHECK(batchRate > 0.0 && batchRate < 1.0);
+    CHECK(std::fabs(batchRate - agentRate) < 0.02);
+}
+
+}
+
+int main() {
+    testNobodyPushes();
+    testEveryoneAllIn();
+    testDeterministic();
+    testMatchesPushFoldAgents();
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,528 @@
+#include "BetHistory.h"
+#include "BetSegment.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> readLines(const std::string& file) {
+    std::vector<std::string> lines;
+    std::ifstream in(file);
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+void writeLines(const std::string& file, const std::vector<std::string>& lines) {
+    std::ofstream out(file, std::ios::trunc);
+    for (const std::string& line : lines) {
+        out << line << "\n";
+    }
+}
+
+// Записи одного блока, разнесённые на месяцы, сохраняют своё время
+void testTimestampsAcrossMonths() {
+    std::string source = TestCheck::tempPath("months.csv");
+    std::string exported = TestCheck::tempPath("months_export.csv");
+    std::string binary = TestCheck::tempPath("months.bin");
+    const std::vector<std::string> rows = {
+        "Player,Action,Amount,Round,Timestamp,Notes",
+        "Alice,CALL,10,1,2024-01-01 12:00:00,",
+        "Bob,RAISE,20,1,2024-03-01 08:30:15,",
+        "Alice,FOLD,0,2,2024-06-01 23:59:59,late"
+    };
+    writeLines(source, rows);
+
+    BetHistory history(TestCheck::tempPath("months_unused.csv"));
+    history.loadFromFile(source);
+    CHECK(history.getHistorySize() == 3);
+    history.exportToCSV(exported);
+    CHECK(readLines(exported) == rows);
+
+    history.setFileFormat(HistoryFormat::BINARY);
+    history.saveToFile(binary);
+    BetHistory restored(TestCheck::tempPath("months_unused.csv"));
+    restored.loadFromFile(binary);
+    restored.exportToCSV(exported);
+    CHECK(readLines(exported) == rows);
+
+    std::remove(source.c_str());
+    std::remove(exported.c_str());
+    std::remove(binary.c_str());
+}
+
+// Модель истории для сверки: записи в порядке добавления
+struct ModelRecord {
+    std::string player;
+    BetAction action;
+    int amount;
+    int round;
+};
+
+void checkAgainstModel(const BetHistory& history, const std::vector<ModelRecord>& model) {
+    CHECK(history.getHistorySize() == model.size());
+    size_t i = 0;
+    bool same = true;
+    history.forEachRecord([&](const BetRecordView& record) {
+        same = same && i < model.size() && PlayerRegistry::getName(record.playerId) == model[i].player &&
+               record.action == model[i].action && record.amount == model[i].amount && record.round == model[i].round;
+        i++;
+    });
+    CHECK(same && i == model.size());
+
+    for (const char* player : { "Alice", "Bob", "Carol" }) {
+        int total = 0;
+        size_t count = 0;
+        for (const ModelRecord& record : model) {
+            if (record.player == player) {
+                total += record.amount;
+                count++;
+            }
+        }
+        CHECK(history.getTotalBetsByPlayer(player) == total);
+        CHECK(history.getPlayerHistory(player).size() == count);
+    }
+    for (int round = 0; round < 20; round++) {
+        int pot = 0;
+        for (const ModelRecord& record : model) {
+            if (record.round == round) pot += record.amount;
+        }
+        CHECK(history.getTotalPotInRound(round) == pot);
+    }
+}
+
+// Удаление игроков и раундов оставляет надгробия; когда их больше половины,
+// хранилище уплотняется, а запросы по индексам дают то же, что и модель
+void testDeletionAndCompaction() {
+    BetHistory history(TestCheck::tempPath("compaction_unused.csv"));
+    std::vector<ModelRecord> model;
+    std::mt19937 rng(7);
+    const char* players[] = { "Alice", "Bob", "Carol" };
+    for (int i = 0; i < 3000; i++) {
+        ModelRecord record = { players[rng() % 3], rng() % 2 ? BetAction::CALL : BetAction::RAISE,
+                               static_cast<int>(rng() % 100), i / 150 };
+        history.addBet(record.player, record.action, record.amount, record.round);
+        model.push_back(record);
+    }
+    checkAgainstModel(history, model);
+
+    auto erase = [&model](auto predicate) {
+        model.erase(std::remove_if(model.begin(), model.end(), predicate), model.end());
+    };
+    history.clearPlayerHistory("Bob");
+    erase([](const ModelRecord& record) { return record.player == "Bob"; });
+    CHECK(history.getStorageSize() == 3000);
+    checkAgainstModel(history, model);
+
+    for (int round = 0; round < 6; round++) {
+        history.clearRoundHistory(round);
+        erase([round](const ModelRecord& record) { return record.round == round; });
+    }
+    CHECK(history.getStorageSize() == model.size());
+    checkAgainstModel(history, model);
+
+    history.addBet("Bob", BetAction::ALL_IN, 500, 19);
+    model.push_back({ "Bob", BetAction::ALL_IN, 500, 19 });
+    checkAgainstModel(history, model);
+}
+
+}
+
+// Счётчики игроков и рейтинг агрессии совпадают с пересчётом по живым записям
+void checkPlayerStats(const BetHistory& history) {
+    std::vector<BetRecord> records = history.snapshotHistory();
+    std::vector<PlayerId> order;  // игроки в порядке первой живой записи
+    std::map<PlayerId, PlayerBetStats> expected;
+    for (const BetRecord& record : records) {
+        if (expected.find(record.playerId) == expected.end()) {
+            order.push_back(record.playerId);
+        }
+        PlayerBetStats& stats = expected[record.playerId];
+        stats.actionCounts[static_cast<size_t>(record.action)]++;
+        stats.totalAmount += record.amount;
+        stats.records++;
+    }
+
+    bool countsMatch = true;
+    for (const auto& entry : expected) {
+        const PlayerBetStats* stats = history.getPlayerBetStats(entry.first);
+        countsMatch = countsMatch && stats && stats->records == entry.second.records &&
+                      stats->totalAmount == entry.second.totalAmount &&
+                      std::equal(std::begin(stats->actionCounts), std::end(stats->actionCounts),
+                                 std::begin(entry.second.actionCounts));
+    }
+    CHECK(countsMatch);
+
+    std::stable_sort(order.begin(), order.end(), [&expected](PlayerId a, PlayerId b) {
+        return expected[a].getAggressionFactor() > expected[b].getAggressionFactor();
+    });
+    std::vector<std::string> names;
+    for (PlayerId player : order) {
+        names.push_back(PlayerRegistry::getName(player));
+    }
+    CHECK(history.getMostAggressivePlayers() == names);
+    std::vector<std::string> top(names.begin(), names.begin() + std::min<size_t>(2, names.size()));
+    CHECK(history.getMostAggressivePlayers(2) == top);
+    std::reverse(names.begin(), names.end());
+    CHECK(history.getTightestPlayers() == names);
+}
+
+void testPlayerStatsAndRanking() {
+    BetHistory history(TestCheck::tempPath("ranking_unused.csv"));
+    const char* names[] = { "Alice", "Bob", "Carol", "Dave", "Eve" };
+    std::mt19937 rng(48);
+    for (int step = 0; step < 3000; step++) {
+        int kind = static_cast<int>(rng() % 100);
+        const char* name = names[rng() % 5];
+        if (kind < 2) {
+            history.clearPlayerHistory(name);
+        } else if (kind < 4) {
+            history.clearRoundHistory(static_cast<int>(rng() % 10));
+        } else {
+            BetAction action = static_cast<BetAction>(rng() % BET_ACTION_COUNT);
+            history.addBet(PlayerRegistry::getId(name), action, static_cast<int>(rng() % 100),
+                           static_cast<int>(rng() % 10));
+        }
+        if (step % 250 == 0) {
+            checkPlayerStats(history);
+        }
+    }
+    checkPlayerStats(history);
+    CHECK(history.getPlayerBetStats(PlayerRegistry::getId("Nobody")) == nullptr);
+}
+
+int64_t msOf(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point timeAt(int64_t timeMs) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(timeMs)));
+}
+
+void addToTotal(TimeBucket& bucket, const BetRecord& record) {
+    bucket.actionCounts[static_cast<size_t>(record.action)]++;
+    bucket.totalAmount += record.amount;
+    bucket.records++;
+}
+
+bool sameBucket(const TimeBucket& a, const TimeBucket& b) {
+    return a.start == b.start && a.totalAmount == b.totalAmount && a.records == b.records &&
+           std::equal(std::begin(a.actionCounts), std::end(a.actionCounts), std::begin(b.actionCounts));
+}
+
+// Время вперёд и назад на месяцы: каждая запись в своём блоке времени и читается точно
+void testTimeBlocks() {
+    const int64_t DAY_MS = 24 * 60 * 60 * 1000LL;
+    const int64_t base = 1700000000123LL;
+    const int64_t offsets[] = { 0, 1, 30 * DAY_MS, 30 * DAY_MS + 5, -40 * DAY_MS, 2, 200 * DAY_MS, -1 };
+    std::string file = TestCheck::tempPath("time_blocks.bin");
+    // Времена задаются через двоичный снимок: сегмент хранит мс как есть
+    BetSegmentWriter writer;
+    CHECK(writer.open(file, 0));
+    uint32_t alice = writer.addPlayer("Alice");
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        SegmentRecord record = {};
+        record.player = alice;
+        record.action = static_cast<uint8_t>(BetAction::CALL);
+        record.amount = static_cast<int32_t>(i);
+        record.timeMs = base + offsets[i];
+        writer.addRecord(record);
+    }
+    CHECK(writer.finish());
+    BetHistory history(TestCheck::tempPath("time_blocks.csv"));
+    history.loadFromFile(file);
+
+    size_t i = 0;
+    bool same = history.getHistorySize() == sizeof(offsets) / sizeof(offsets[0]);
+    history.forEachRecord([&](const BetRecordView& record) {
+        same = same && record.amount == static_cast<int>(i) && record.timeMs == base + offsets[i];
+        i++;
+    });
+    CHECK(same);
+    std::vector<BetRecord> between = history.getHistoryBetween(timeAt(base - 50 * DAY_MS), timeAt(base + 2));
+    CHECK(between.size() == 4);
+    std::remove(file.c_str());
+}
+
+// Отбор, сводки и итоги по отрезку совпадают с пересчётом по живым записям
+void checkTimeQueries(const BetHistory& history, std::mt19937& rng, int64_t firstMs, int64_t spanMs) {
+    const int64_t MINUTE_MS = 60 * 1000;
+    const int64_t HOUR_MS = 60 * MINUTE_MS;
+    std::vector<BetRecord> records = history.snapshotHistory();
+    for (int query = 0; query < 20; query++) {
+        int64_t beginMs = firstMs - MINUTE_MS + static_cast<int64_t>(rng() % static_cast<uint64_t>(spanMs));
+        int64_t endMs = beginMs + static_cast<int64_t>(rng() % static_cast<uint64_t>(spanMs));
+        if (query == 0) {
+            beginMs = firstMs - HOUR_MS;
+            endMs = firstMs + spanMs + HOUR_MS;
+        }
+
+        std::vector<BetRecord> between = history.getHistoryBetween(timeAt(beginMs), timeAt(endMs));
+        std::vector<BetRecord> expected;
+        TimeBucket expectedTotal;
+        std::map<int64_t, TimeBucket> minutes;
+        std::map<int64_t, TimeBucket> hours;
+        for (const BetRecord& record : records) {
+            int64_t timeMs = msOf(record.timestamp);
+            if (timeMs >= beginMs && timeMs < endMs) {
+                expected.push_back(record);
+                addToTotal(expectedTotal, record);
+            }
+            // Отрезки сводки берутся по началу, а не по времени записи
+            int64_t minute = timeMs / MINUTE_MS * MINUTE_MS;
+            int64_t hour = timeMs / HOUR_MS * HOUR_MS;
+            if (minute >= beginMs && minute < endMs) addToTotal(minutes[minute], record);
+            if (hour >= beginMs && hour < endMs) addToTotal(hours[hour], record);
+        }
+
+        bool same = between.size() == expected.size();
+        for (size_t i = 0; same && i < between.size(); i++) {
+            same = between[i].timestamp == expected[i].timestamp && between[i].amount == expected[i].amount &&
+                   between[i].playerId == expected[i].playerId;
+        }
+        CHECK(same);
+        expectedTotal.start = timeAt(beginMs);
+        TimeBucket total = history.getTotalsBetween(timeAt(beginMs), timeAt(endMs));
+        total.start = expectedTotal.start;
+        CHECK(sameBucket(total, expectedTotal));
+
+        for (auto& rollup : { std::make_pair(TimeGranularity::MINUTE, &minutes),
+                              std::make_pair(TimeGranularity::HOUR, &hours) }) {
+            std::vector<TimeBucket> buckets = history.getRollup(rollup.first, timeAt(beginMs), timeAt(endMs));
+            bool match = buckets.size() == rollup.second->size();
+            auto it = rollup.second->begin();
+            for (size_t i = 0; match && i < buckets.size(); i++, ++it) {
+                it->second.start = timeAt(it->first);
+                match = sameBucket(buckets[i], it->second);
+            }
+            CHECK(match);
+        }
+    }
+}
+
+// Время записей в CSV: по порядку, затем вперемешку, затем с удалёнными записями
+void testTimeQueries() {
+    std::string file = TestCheck::tempPath("times.csv");
+    std::mt19937 rng(50);
+    const char* names[] = { "Alice", "Bob", "Carol" };
+    const char* actions[] = { "FOLD", "CHECK", "CALL", "RAISE", "ALL_IN" };
+    std::vector<std::string> rows = { "Player,Action,Amount,Round,Timestamp,Notes" };
+    int second = 0;
+    for (int i = 0; i < 2000; i++) {
+        second += static_cast<int>(rng() % 15);
+        char timestamp[32];
+        std::snprintf(timestamp, sizeof(timestamp), "2024-05-%02d %02d:%02d:%02d", 10 + second / 86400,
+                      second / 3600 % 24, second / 60 % 60, second % 60);
+        rows.push_back(std::string(names[rng() % 3]) + "," + actions[rng() % 5] + "," + std::to_string(rng() % 200) +
+                       "," + std::to_string(i / 50) + "," + timestamp + ",");
+    }
+    writeLines(file, rows);
+
+    BetHistory history(file);
+    history.loadFromFile();
+    CHECK(history.getHistorySize() == 2000);
+    std::vector<BetRecord> records = history.snapshotHistory();
+    int64_t firstMs = msOf(records.front().timestamp);
+    int64_t spanMs = msOf(records.back().timestamp) - firstMs + 1;
+    checkTimeQueries(history, rng, firstMs, spanMs);
+
+    // Одна ранняя запись не по порядку: всё после неё отбирается через индекс хвоста
+    std::vector<std::string> early = rows;
+    early[2].swap(early[1 + 2000 / 2]);
+    writeLines(file, early);
+    history.loadFromFile();
+    checkTimeQueries(history, rng, firstMs, spanMs);
+
+    // Несколько записей из прошлого вперемешку
+    for (int i = 0; i < 20; i++) {
+        std::swap(rows[1 + rng() % 2000], rows[1 + rng() % 2000]);
+    }
+    writeLines(file, rows);
+    history.loadFromFile();
+    checkTimeQueries(history, rng, firstMs, spanMs);
+
+    history.clearPlayerHistory("Bob");
+    history.clearRoundHistory(7);
+    checkTimeQueries(history, rng, firstMs, spanMs);
+    std::remove(file.c_str());
+}
+
+// Курсор выгрузки не пропускает и не повторяет записи после удаления части истории
+void testExportCursor() {
+    std::string exported = TestCheck::tempPath("history_export.csv");
+    std::remove(exported.c_str());
+    BetHistory history(TestCheck::tempPath("history_export_unused.csv"));
+    PlayerId alice = PlayerRegistry::getId("Alice");
+    PlayerId bob = PlayerRegistry::getId("Bob");
+    history.addBet(alice, BetAction::CALL, 10, 1);
+    history.addBet(bob, BetAction::RAISE, 20, 1);
+    history.addBet(alice, BetAction::FOLD, 0, 2);
+
+    ExportCursor cursor;
+    CHECK(history.exportToCSV(exported, cursor) == 3);
+    CHECK(history.exportToCSV(exported, cursor) == 0);
+
+    history.clearPlayerHistory("Alice");
+    history.addBet(bob, BetAction::CALL, 30, 3);
+    history.addBet(alice, BetAction::CHECK, 0, 3);
+    BetFilter onlyBob;
+    onlyBob.player = bob;
+    ExportCursor bobCursor = cursor;
+    CHECK(history.exportToCSV(exported, bobCursor, onlyBob) == 1);
+    CHECK(history.exportToCSV(exported, cursor) == 2);
+
+    history.clearHistory();
+    history.addBet(bob, BetAction::FOLD, 0, 4);
+    CHECK(history.exportToCSV(exported, cursor) == 1);
+    CHECK(readLines(exported).size() == 1 + 3 + 1 + 2 + 1);
+    std::remove(exported.c_str());
+}
+
+void removeAutoSaveFiles(const std::string& file) {
+    std::remove(file.c_str());
+    std::remove((file + ".wal").c_str());
+    std::remove((file + ".tmp").c_str());
+}
+
+// Журнал прошлого запуска восстанавливается при включении автосохранения, а не теряется
+void testLogRecoveredOnAutoSave() {
+    std::string file = TestCheck::tempPath("wal_recovery.csv");
+    removeAutoSaveFiles(file);
+    {
+        BetHistory history(file);
+        history.setAutoSave(true);
+        for (int i = 0; i < 10; i++) {
+            history.addBet(PlayerRegistry::getId("Alice"), BetAction::CALL, 10 + i, 1);
+        }
+        history.flushLog();
+    }
+
+    // Поверх непустой истории журнал не трогается
+    BetHistory busy(file);
+    busy.addBet(PlayerRegistry::getId("Bob"), BetAction::RAISE, 50, 1);
+    busy.setAutoSave(true);
+    CHECK(readLines(busy.getLogFilename()).size() >= 10);
+
+    BetHistory recovered(file);
+    recovered.setAutoSave(true);
+    CHECK(recovered.getHistorySize() == 10);
+    CHECK(recovered.getTotalBetsByPlayer("Alice") == 145);
+    recovered.addBet(PlayerRegistry::getId("Bob"), BetAction::RAISE, 50, 2);
+    recovered.flushLog();
+
+    BetHistory reloaded(file);
+    reloaded.loadFromFile();
+    CHECK(reloaded.getHistorySize() == 11);
+    removeAutoSaveFiles(file);
+}
+
+// Сбой между заменой снимка и очисткой журнала: журнал, уже вошедший в снимок, не удваивает записи
+void testCompactionCrashGap(HistoryFormat format, const std::string& name) {
+    std::string file = TestCheck::tempPath(name);
+    removeAutoSaveFiles(file);
+    std::vector<std::string> staleLog;
+    {
+        BetHistory history(file);
+        history.setFileFormat(format);
+        history.setAutoSave(true);
+        for (int i = 0; i < 5; i++) {
+            history.addBet(PlayerRegistry::getId("Alice"), BetAction::CALL, 10, 1);
+        }
+        history.compactLog();
+        for (int i = 0; i < 3; i++) {
+            history.addBet(PlayerRegistry::getId("Bob"), BetAction::RAISE, 20, 2);
+        }
+        history.flushLog();
+        staleLog = readLines(history.getLogFilename());
+        history.compactLog();
+        history.addBet(PlayerRegistry::getId("Carol"), BetAction::FOLD, 0, 3);
+        history.flushLog();
+        // Очистка журнала "не случилась": старые строки перед новыми
+        std::vector<std::string> log = readLines(history.getLogFilename());
+        staleLog.insert(staleLog.end(), log.begin(), log.end());
+    }
+    writeLines(file + ".wal", staleLog);
+
+    BetHistory reloaded(file);
+    reloaded.loadFromFile();
+    CHECK(reloaded.getHistorySize() == 9);
+    CHECK(reloaded.getTotalBetsByPlayer("Bob") == 60);
+    CHECK(reloaded.getPlayerHistory("Carol").size() == 1);
+    removeAutoSaveFiles(file);
+}
+
+// Снимок CSV хранит миллисекунды: время после сохранения и загрузки то же
+void testCsvSnapshotKeepsMilliseconds() {
+    std::string file = TestCheck::tempPath("snapshot_ms.csv");
+    removeAutoSaveFiles(file);
+    std::vector<std::string> rows = {
+        "Player,Action,Amount,Round,Timestamp,Notes",
+        "Alice,CALL,10,1,2024-01-01 12:00:00.007,",
+        "Bob,RAISE,20,1,2024-01-01 12:00:00.999,"
+    };
+    writeLines(file, rows);
+    BetHistory history(file);
+    history.loadFromFile();
+    std::vector<BetRecord> records = history.snapshotHistory();
+    CHECK(records.size() == 2 && msOf(records[1].timestamp) - msOf(records[0].timestamp) == 992);
+    for (int i = 0; i < 20; i++) {
+        history.addBet(PlayerRegistry::getId("Carol"), BetAction::CHECK, 0, 2);
+    }
+    history.saveToFile();
+
+    BetHistory loaded(file);
+    loaded.loadFromFile();
+    std::vector<BetRecord> reloaded = loaded.snapshotHistory();
+    records = history.snapshotHistory();
+    bool same = reloaded.size() == records.size();
+    for (size_t i = 0; same && i < records.size(); i++) {
+        same = reloaded[i].timestamp == records[i].timestamp;
+    }
+    CHECK(same);
+    removeAutoSaveFiles(file);
+}
+
+// Табуляция и перевод строки в имени не ломают строку журнала
+void testLogSanitizesNames() {
+    std::string file = TestCheck::tempPath("wal_names.csv");
+    removeAutoSaveFiles(file);
+    {
+        BetHistory history(file);
+        history.setAutoSave(true);
+        history.addBet(PlayerRegistry::getId("Tab\tName\nLine"), BetAction::RAISE, 30, 1, "note\twith tab");
+        history.addBet(PlayerRegistry::getId("Alice"), BetAction::CALL, 30, 1);
+        history.flushLog();
+        CHECK(readLines(history.getLogFilename()).size() == 3);
+    }
+    BetHistory recovered(file);
+    recovered.setAutoSave(true);
+    CHECK(recovered.getHistorySize() == 2);
+    CHECK(recovered.getTotalBetsByPlayer("Tab Name Line") == 30);
+    CHECK(recovered.getTotalBetsByPlayer("Alice") == 30);
+    std::vector<BetRecord> records = recovered.snapshotHistory();
+    CHECK(records.size() == 2 && records[0].notes == "note\twith tab");
+    removeAutoSaveFiles(file);
+}
+
+int main() {
+    testTimestampsAcrossMonths();
+    testTimeBlocks();
+    testDeletionAndCompaction();
+    testPlayerStatsAndRanking();
+    testTimeQueries();
+    testExportCursor();
+    testLogRecoveredOnAutoSave();
+    testCompactionCrashGap(HistoryFormat::CSV, "wal_gap.csv");
+    testCompactionCrashGap(HistoryFormat::BINARY, "wal_gap.bin");
+    testCsvSnapshotKeepsMilliseconds();
+    testLogSanitizesNames();
+    return TEST_EXIT_CODE();
+}
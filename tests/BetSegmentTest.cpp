@@ -0,0 +1,94 @@
+#include "BetSegment.h"
+#include "TestCheck.h"
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+namespace {
+
+SegmentRecord makeRecord(uint32_t player, uint16_t note, int32_t amount, int64_t timeMs) {
+    SegmentRecord record = {};
+    record.player = player;
+    record.action = 2;
+    record.note = note;
+    record.amount = amount;
+    record.round = 1;
+    record.timeMs = timeMs;
+    return record;
+}
+
+bool writeSegment(const std::string& file, size_t records) {
+    BetSegmentWriter writer;
+    if (!writer.open(file, 7)) return false;
+    uint32_t alice = writer.addPlayer("Alice");
+    uint32_t bob = writer.addPlayer("Bob");
+    writer.addNote("первая");
+    writer.addNote("");
+    for (size_t i = 0; i < records; i++) {
+        writer.addRecord(makeRecord(i % 2 ? bob : alice, static_cast<uint16_t>(i % 3), static_cast<int32_t>(i),
+                                    int64_t(1700000000000) + static_cast<int64_t>(i)));
+    }
+    return writer.finish();
+}
+
+// Записи (больше одного блока записи), словари и checkpoint читаются как записаны
+void testRoundTrip() {
+    std::string file = TestCheck::tempPath("segment.bin");
+    const size_t count = 10000;
+    CHECK(writeSegment(file, count));
+    CHECK(BetSegment::isSegmentFile(file));
+
+    BetSegmentReader reader;
+    CHECK(reader.open(file));
+    CHECK(reader.getCheckpoint() == 7);
+    CHECK(reader.getRecordCount() == count);
+    CHECK(reader.getPlayerCount() == 2);
+    CHECK(reader.getPlayerName(0) == "Alice");
+    CHECK(reader.getPlayerName(1) == "Bob");
+    CHECK(reader.getNoteCount() == 2);
+    CHECK(reader.getNote(0) == "первая");
+    CHECK(reader.getNote(1).empty());
+    bool same = reader.getRecordCount() == count;
+    for (size_t i = 0; same && i < count; i++) {
+        const SegmentRecord& record = reader.getRecord(i);
+        same = record.player == i % 2 && record.note == i % 3 && record.amount == static_cast<int32_t>(i) &&
+               record.timeMs == int64_t(1700000000000) + static_cast<int64_t>(i);
+    }
+    CHECK(same);
+    reader.close();
+    std::remove(file.c_str());
+}
+
+// Смещения таблиц в footer, сумма которых переполняет uint64, не проходят проверку
+void testWrappedFooterOffsets() {
+    std::string file = TestCheck::tempPath("segment_wrapped.bin");
+    CHECK(writeSegment(file, 3));
+
+    std::fstream io(file, std::ios::binary | std::ios::in | std::ios::out);
+    io.seekg(0, std::ios::end);
+    std::streamoff footerOffset = static_cast<std::streamoff>(io.tellg()) - static_cast<std::streamoff>(sizeof(SegmentFooter));
+    SegmentFooter footer;
+    io.seekg(footerOffset);
+    io.read(reinterpret_cast<char*>(&footer), sizeof(footer));
+
+    // Таблица игроков "до" таблицы заметок по модулю 2^64
+    footer.playerCount = std::numeric_limits<uint32_t>::max();
+    uint64_t playerTableSize = (uint64_t(footer.playerCount) + 1) * sizeof(uint64_t);
+    footer.playerTableOffset = footer.noteTableOffset - playerTableSize;
+    io.seekp(footerOffset);
+    io.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    io.close();
+
+    BetSegmentReader reader;
+    CHECK(!reader.open(file));
+    CHECK(!reader.isOpen());
+    std::remove(file.c_str());
+}
+
+}
+
+int main() {
+    testRoundTrip();
+    testWrappedFooterOffsets();
+    return TEST_EXIT_CODE();
+}
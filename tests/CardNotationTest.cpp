@@ -0,0 +1,117 @@
+#include "CardNotation.h"
+#include "TestCheck.h"
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+std::from_chars_result parse(const char* text, Span<Card> cards, size_t& count) {
+    return CardNotation::parseCards(text, text + std::strlen(text), cards, count);
+}
+
+// Каждая из 52 карт форматируется и разбирается обратно в тот же код
+void testCardRoundTrip() {
+    bool same = true;
+    for (uint8_t code = 0; code < 52; code++) {
+        Card card = Card::fromCode(code);
+        char text[2];
+        auto formatted = CardNotation::formatCard(text, text + 2, card);
+        Card parsed = Card::fromCode(0);
+        auto result = CardNotation::parseCard(text, text + 2, parsed);
+        same = same && formatted.ec == std::errc() && result.ec == std::errc() && result.ptr == text + 2 &&
+               parsed.getCode() == code;
+    }
+    CHECK(same);
+    CHECK(CardNotation::toString(Card::fromCode(51)) == "Ac");
+
+    char small[3];
+    Card cards[2] = { Card::fromCode(0), Card::fromCode(1) };
+    CHECK(CardNotation::formatCard(small, small + 1, cards[0]).ec == std::errc::value_too_large);
+    CHECK(CardNotation::formatCards(small, small + 3, cards, 2).ec == std::errc::value_too_large);
+}
+
+void testParseCards() {
+    std::array<Card, 4> cards;
+    size_t count = 0;
+    auto result = parse("As Kh,td\t9C", cards, count);
+    CHECK(result.ec == std::errc());
+    CHECK(count == 4);
+    CHECK(CardNotation::toString(CardSpan(cards.data(), count)) == "AsKhTd9c");
+
+    // Ошибка указывает на первый неразобранный символ
+    const char* badRank = "As 1s";
+    result = parse(badRank, cards, count);
+    CHECK(result.ec == std::errc::invalid_argument);
+    CHECK(result.ptr == badRank + 3);
+    CHECK(count == 1);
+
+    const char* badSuit = "AsKx";
+    result = parse(badSuit, cards, count);
+    CHECK(result.ec == std::errc::invalid_argument && result.ptr == badSuit + 2);
+
+    const char* truncated = "AsK";
+    result = parse(truncated, cards, count);
+    CHECK(result.ec == std::errc::invalid_argument && result.ptr == truncated + 2);
+
+    // Буфер вызывающего не переполняется
+    const char* many = "AsKsQsJsTs";
+    result = parse(many, cards, count);
+    CHECK(result.ec == std::errc::value_too_large);
+    CHECK(count == 4);
+    CHECK(result.ptr == many + 8);
+
+    CHECK(CardNotation::fromString("AsKh").size() == 2);
+    CHECK(CardNotation::fromString("AsKz").empty());
+    CHECK(CardNotation::fromString("").empty());
+}
+
+void testBatch() {
+    const char text[] = "AsKh\n\nTd 9d 8c\r\n2c";
+    HandBatch batch;
+    auto result = CardNotation::parseBatch(text, text + sizeof(text) - 1, batch);
+    CHECK(result.ec == std::errc());
+    CHECK(batch.getHandCount() == 3);
+    CHECK(batch.getCardCount(1) == 3);
+    CHECK(CardNotation::formatBatch(batch) == "AsKh\nTd9d8c\n2c\n");
+
+    // Разобранные до ошибки руки остаются, недоразобранная - нет
+    const char broken[] = "AsKh\nQd Xx";
+    HandBatch partial;
+    result = CardNotation::parseBatch(broken, broken + sizeof(broken) - 1, partial);
+    CHECK(result.ec == std::errc::invalid_argument);
+    CHECK(result.ptr == broken + 8);
+    CHECK(partial.getHandCount() == 1);
+    CHECK(partial.codes.size() == 2);
+}
+
+// Файл больше блока чтения: руки на границе блоков не рвутся
+void testBatchFileRoundTrip() {
+    std::string file = TestCheck::tempPath("hands.txt");
+    HandBatch batch;
+    const size_t hands = 200000;
+    for (size_t hand = 0; hand < hands; hand++) {
+        size_t count = 2 + hand % 6;
+        for (size_t i = 0; i < count; i++) {
+            batch.codes.push_back(static_cast<uint8_t>((hand * 7 + i * 13) % 52));
+        }
+        batch.offsets.push_back(static_cast<uint32_t>(batch.codes.size()));
+    }
+    CHECK(CardNotation::saveBatch(file, batch));
+
+    HandBatch loaded;
+    CHECK(CardNotation::loadBatch(file, loaded));
+    CHECK(loaded.codes == batch.codes);
+    CHECK(loaded.offsets == batch.offsets);
+    std::remove(file.c_str());
+}
+
+}
+
+int main() {
+    testCardRoundTrip();
+    testParseCards();
+    testBatch();
+    testBatchFileRoundTrip();
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,107 @@
+#include "BetHistory.h"
+#include "CsvIngest.h"
+#include "CsvWriter.h"
+#include "TestCheck.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Кавычки, "" и запятые внутри кавычек; лишние запятые вне кавычек - в растягиваемом поле
+void testSplitFields() {
+    std::vector<uint32_t> commas;
+    std::string_view fields[3];
+    CHECK(CsvIngest::splitFields("a,\"b,c\",\"say \"\"hi\"\"\"", fields, 3, 2, commas));
+    CHECK(fields[0] == "a");
+    CHECK(CsvIngest::unescape(fields[1]) == "b,c");
+    CHECK(CsvIngest::unescape(fields[2]) == "say \"hi\"");
+
+    CHECK(CsvIngest::splitFields("a,b,old, unescaped, note", fields, 3, 2, commas));
+    CHECK(fields[1] == "b");
+    CHECK(fields[2] == "old, unescaped, note");
+
+    CHECK(CsvIngest::splitFields("a,b,c,d", fields, 3, 1, commas));
+    CHECK(fields[1] == "b,c");
+    CHECK(fields[2] == "d");
+
+    CHECK(!CsvIngest::splitFields("a,b", fields, 3, 2, commas));
+}
+
+// Строки, записанные CsvWriter, читаются параллельно маленькими окнами в порядке файла
+void testParallelIngestKeepsOrder() {
+    std::string file = TestCheck::tempPath("ingest.csv");
+    const int count = 3000;
+    CsvWriter writer(256);
+    CHECK(writer.open(file));
+    for (int i = 0; i < count; i++) {
+        writer.addField(i);
+        writer.addField("note, " + std::to_string(i) + " \"quoted\"\nsplit");
+        writer.endRow();
+    }
+    CHECK(writer.close());
+
+    const unsigned slots = 4;
+    std::vector<std::vector<std::string>> parsed(slots);
+    std::vector<std::string> merged;
+    bool fieldsOk = true;
+    auto parse = [&parsed, &fieldsOk](size_t slot, std::string_view text) {
+        parsed[slot].clear();
+        std::vector<uint32_t> commas;
+        std::string_view fields[2];
+        CsvIngest::forEachLine(text, [&](std::string_view line) {
+            int index = 0;
+            if (!CsvIngest::splitFields(line, fields, 2, 1, commas) || !CsvIngest::parseNumber(fields[0], index)) {
+                fieldsOk = false;
+                return;
+            }
+            parsed[slot].push_back(std::to_string(index) + "|" + CsvIngest::unescape(fields[1]));
+        });
+    };
+    auto merge = [&parsed, &merged](size_t slot) {
+        merged.insert(merged.end(), parsed[slot].begin(), parsed[slot].end());
+    };
+    CHECK(CsvIngest::ingest(file, 0, slots, parse, merge, 97));
+    CHECK(fieldsOk);
+    CHECK(merged.size() == static_cast<size_t>(count));
+    bool same = merged.size() == static_cast<size_t>(count);
+    for (int i = 0; same && i < count; i++) {
+        same = merged[i] == std::to_string(i) + "|note, " + std::to_string(i) + " \"quoted\" split";
+    }
+    CHECK(same);
+    std::remove(file.c_str());
+}
+
+// Имена и заметки с запятыми и кавычками переживают сохранение и параллельную загрузку истории
+void testBetHistoryEscaping() {
+    std::string file = TestCheck::tempPath("escaping.csv");
+    const std::string names[] = { "Smith, John", "Quote \"Q\" Man", "Plain" };
+    const size_t count = 5000;
+    BetHistory history(file);
+    for (size_t i = 0; i < count; i++) {
+        history.addBet(PlayerRegistry::getId(names[i % 3]), BetAction::RAISE, static_cast<int>(i), 1,
+                       "raise, \"big\" #" + std::to_string(i % 7));
+    }
+    history.saveToFile();
+
+    BetHistory loaded(file);
+    loaded.loadFromFile();
+    size_t i = 0;
+    bool same = loaded.getHistorySize() == count;
+    loaded.forEachRecord([&](const BetRecordView& record) {
+        same = same && PlayerRegistry::getName(record.playerId) == names[i % 3] &&
+               record.amount == static_cast<int>(i) && record.notes == "raise, \"big\" #" + std::to_string(i % 7);
+        i++;
+    });
+    CHECK(same);
+    std::remove(file.c_str());
+}
+
+}
+
+int main() {
+    testSplitFields();
+    testParallelIngestKeepsOrder();
+    testBetHistoryEscaping();
+    return TEST_EXIT_CODE();
+}
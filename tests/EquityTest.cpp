@@ -0,0 +1,44 @@
+#include "Equity.h"
+#include "RulesEngine.h"
+#include "TestCheck.h"
+#include <cmath>
+
+namespace {
+
+CardMask aces() {
+    return (CardMask(1) << (Card::DECK_SIZE - 1)) | (CardMask(1) << (Card::DECK_SIZE - 2));
+}
+
+// Соперников больше, чем мест за столом: оценка ограничивается MAX_SEATS - 1
+void testManyOpponents() {
+    for (SamplingMethod method : { SamplingMethod::RANDOM, SamplingMethod::STRATIFIED, SamplingMethod::QUASI_RANDOM }) {
+        std::mt19937 rng(1);
+        MonteCarloConfig config;
+        config.method = method;
+        config.maxSamples = 20000;
+        MonteCarloResult crowded = Equity::vsRandom(aces(), 0, 12, rng, config);
+        MonteCarloResult full = Equity::vsRandom(aces(), 0, MAX_SEATS - 1, rng, config);
+        CHECK(crowded.samples > 0);
+        CHECK(std::fabs(crowded.mean - full.mean) < 0.03);
+        CHECK(crowded.mean > 0.25 && crowded.mean < 0.37);
+    }
+}
+
+void testExactHeadsUp() {
+    // Полный борд 2 3 4 7 J: один исход, тузы сильнее королей
+    CardMask board = 0;
+    for (int code : { 0, 5, 10, 22, 36 }) {
+        board |= CardMask(1) << code;
+    }
+    CardMask kings = (CardMask(1) << 44) | (CardMask(1) << 45);
+    CHECK(Equity::exactHeadsUp(aces(), kings, board) == 1.0);
+    CHECK(Equity::exactHeadsUp(kings, aces(), board) == 0.0);
+}
+
+}
+
+int main() {
+    testManyOpponents();
+    testExactHeadsUp();
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,76 @@
+#include "HandArena.h"
+#include "StateManager.h"
+#include "TestCheck.h"
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Память после reset() выдаётся заново с начала первого блока
+void testResetReusesBuffer() {
+    HandArena arena(1024);
+    std::pmr::vector<int> first(arena.getResource());
+    first.reserve(16);
+    const int* before = first.data();
+    first = std::pmr::vector<int>(arena.getResource());
+    arena.reset();
+    std::pmr::vector<int> second(arena.getResource());
+    second.reserve(16);
+    CHECK(second.data() == before);
+}
+
+GameSession* startHand(StateManager& manager, const std::string& sessionId) {
+    for (const char* name : { "ArenaTestA", "ArenaTestB" }) {
+        manager.joinGame(sessionId, std::make_shared<Player>(name));
+        manager.setPlayerState(name, PlayerState::ACTIVE);
+    }
+    manager.setState(GameState::WAITING_FOR_PLAYERS);
+    manager.startGame(sessionId);
+    return manager.getCurrentSession();
+}
+
+// Банк прошлой раздачи, который кто-то держит, не затирается следующей раздачей
+void testHeldBankSurvivesNextHand() {
+    StateManager manager;
+    GameSession* session = startHand(manager, manager.createNewGame());
+    CHECK(session != nullptr && manager.getCurrentState() == GameState::PREFLOP);
+
+    std::shared_ptr<Bank> held = session->bank;
+    held->setAuditMode(true);
+    int seat = held->addPlayer("ArenaTestA");
+    for (int i = 1; i <= 50; i++) held->placeBet(seat, i);
+    const HandArena* heldArena = session->handArena.get();
+
+    manager.setState(GameState::GAME_OVER);
+    manager.setState(GameState::PREFLOP);
+    CHECK(session->bank != held);
+    CHECK(session->handArena.get() != heldArena);
+
+    // Новая раздача пишет в свою арену
+    session->bank->setAuditMode(true);
+    int other = session->bank->addPlayer("ArenaTestB");
+    for (int i = 0; i < 50; i++) session->bank->placeBet(other, 1000);
+
+    const auto& history = held->getBetHistory();
+    bool same = history.size() == 50;
+    for (size_t i = 0; same && i < history.size(); i++) {
+        same = history[i].amount == static_cast<int>(i) + 1;
+    }
+    CHECK(same);
+    CHECK(held->getTotalBetsByPlayer(seat) == 50 * 51 / 2);
+
+    // Без внешних держателей арена переиспользуется
+    held.reset();
+    const HandArena* current = session->handArena.get();
+    manager.setState(GameState::GAME_OVER);
+    manager.setState(GameState::PREFLOP);
+    CHECK(session->handArena.get() == current);
+}
+
+}
+
+int main() {
+    testResetReusesBuffer();
+    testHeldBankSurvivesNextHand();
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,151 @@
+#include "HudStats.h"
+#include "StateManager.h"
+#include "TestCheck.h"
+
+namespace {
+
+bool counterIs(const HudStats& hud, PlayerId player, HudStat stat, uint32_t hits, uint32_t chances) {
+    HudCounter counter = hud.getCounter(player, stat);
+    return counter.hits == hits && counter.chances == chances;
+}
+
+// Рейз, 3-бет, контбет и сброс на него; затем раздача со вскрытием
+void testCounters() {
+    PlayerId a = PlayerRegistry::getId("HudA");
+    PlayerId b = PlayerRegistry::getId("HudB");
+    PlayerId c = PlayerRegistry::getId("HudC");
+    HudStats hud;
+
+    hud.beginHand({ a, b, c });
+    hud.recordAction(a, BetAction::RAISE);
+    hud.recordAction(b, BetAction::RAISE);
+    hud.recordAction(c, BetAction::FOLD);
+    hud.recordAction(a, BetAction::CALL);
+    hud.setStreet(GamePhase::FLOP);
+    CHECK(hud.getPreflopAggressor() == b);
+    hud.recordAction(b, BetAction::RAISE);
+    hud.recordAction(a, BetAction::FOLD);
+    hud.endHand();
+
+    CHECK(counterIs(hud, a, HudStat::VPIP, 1, 1));
+    CHECK(counterIs(hud, a, HudStat::PFR, 1, 1));
+    CHECK(counterIs(hud, a, HudStat::THREE_BET, 0, 0));
+    CHECK(counterIs(hud, b, HudStat::THREE_BET, 1, 1));
+    CHECK(counterIs(hud, c, HudStat::VPIP, 0, 1));
+    CHECK(counterIs(hud, c, HudStat::THREE_BET, 0, 0));
+    CHECK(counterIs(hud, b, HudStat::CBET, 1, 1));
+    CHECK(counterIs(hud, a, HudStat::FOLD_TO_CBET, 1, 1));
+    CHECK(counterIs(hud, a, HudStat::WTSD, 0, 1));
+    CHECK(counterIs(hud, c, HudStat::WTSD, 0, 0));
+
+    hud.beginHand({ a, b });
+    hud.recordAction(a, BetAction::CALL);
+    hud.recordAction(b, BetAction::CHECK);
+    hud.setStreet(GamePhase::FLOP);
+    hud.recordAction(a, BetAction::RAISE);
+    hud.recordAction(b, BetAction::CALL);
+    hud.recordShowdown({ b });
+    hud.endHand();
+
+    CHECK(counterIs(hud, a, HudStat::VPIP, 2, 2));
+    CHECK(counterIs(hud, a, HudStat::PFR, 1, 2));
+    CHECK(counterIs(hud, b, HudStat::VPIP, 1, 2));
+    CHECK(counterIs(hud, a, HudStat::WTSD, 1, 2));
+    CHECK(counterIs(hud, a, HudStat::WSD, 0, 1));
+    CHECK(counterIs(hud, b, HudStat::WSD, 1, 1));
+    CHECK(hud.getHandCount(a) == 2);
+    CHECK(hud.getHandCount(c) == 1);
+    CHECK(hud.getAggressionFactor(a) == 1.0);
+    CHECK(hud.getAggressionFactor(b) == 1.0);
+}
+
+// Окно последних раздач вычитает выпавшие раздачи, итог за всё время - нет
+void testWindow() {
+    PlayerId d = PlayerRegistry::getId("HudD");
+    HudStats hud(2);
+    const BetAction actions[] = { BetAction::CALL, BetAction::FOLD, BetAction::FOLD, BetAction::RAISE };
+    for (BetAction action : actions) {
+        hud.beginHand({ d });
+        hud.recordAction(d, action);
+    }
+    hud.endHand();
+    HudCounter total = hud.getCounter(d, HudStat::VPIP);
+    HudCounter window = hud.getWindowCounter(d, HudStat::VPIP);
+    CHECK(total.hits == 2 && total.chances == 4);
+    CHECK(window.hits == 1 && window.chances == 2);
+    CHECK(hud.getWindowRate(d, HudStat::VPIP) == 0.5);
+}
+
+// Бот, посаженный за стол, читает HUD своей сессии
+void testBotsGetSessionHud() {
+    StateManager manager;
+    manager.createNewGame();
+    auto first = std::make_shared<BotPlayer>("HudBot1");
+    manager.addPlayer(first);
+    CHECK(first->getHudStats() != nullptr);
+    CHECK(first->getHudStats() == manager.getAllSessions().back().hudStats);
+
+    std::string other = manager.createNewGame();
+    auto second = std::make_shared<BotPlayer>("HudBot2");
+    CHECK(manager.joinGame(other, second));
+    CHECK(second->getHudStats() != nullptr);
+    CHECK(second->getHudStats() != first->getHudStats());
+}
+
+// Две раздачи, как их ведёт консольная игра: одна сессия, улицы через nextRound,
+// конец раздачи - GAME_OVER после сброса или SHOWDOWN с победителями
+void testConsoleHandsFeedHud() {
+    StateManager manager;
+    std::string sessionId = manager.createNewGame();
+    auto human = std::make_shared<Player>("HudHuman");
+    auto bot = std::make_shared<BotPlayer>("HudConsoleBot");
+    manager.addPlayer(human);
+    manager.addPlayer(bot);
+    manager.setState(GameState::WAITING_FOR_PLAYERS);
+    PlayerId h = human->getId();
+    PlayerId b = bot->getId();
+
+    for (const auto& name : { "HudHuman", "HudConsoleBot" }) manager.setPlayerState(name, PlayerState::ACTIVE);
+    CHECK(manager.startGame(sessionId));
+    manager.playerRaise("HudHuman", 20);
+    manager.playerCall("HudConsoleBot", 10);
+    manager.nextRound();
+    CHECK(manager.getCurrentState() == GameState::FLOP);
+    manager.playerCheck("HudConsoleBot");
+    manager.playerRaise("HudHuman", 30);
+    manager.playerFold("HudConsoleBot");
+    manager.setState(GameState::GAME_OVER);
+
+    for (const auto& name : { "HudHuman", "HudConsoleBot" }) manager.setPlayerState(name, PlayerState::ACTIVE);
+    CHECK(manager.startGame(sessionId));
+    CHECK(manager.getCurrentRound() == 0);
+    manager.playerCall("HudHuman", 5);
+    manager.playerCheck("HudConsoleBot");
+    for (int street = 0; street < 3; street++) manager.nextRound();
+    CHECK(manager.getCurrentState() == GameState::RIVER);
+    manager.setShowdownWinners({ "HudConsoleBot" });
+    manager.setState(GameState::SHOWDOWN);
+
+    const HudStats* hud = bot->getHudStats().get();
+    CHECK(hud != nullptr);
+    if (!hud) return;
+    CHECK(hud->getHandCount(h) == 2);
+    CHECK(hud->getHandCount(b) == 2);
+    CHECK(counterIs(*hud, h, HudStat::VPIP, 2, 2));
+    CHECK(counterIs(*hud, h, HudStat::PFR, 1, 2));
+    CHECK(counterIs(*hud, h, HudStat::CBET, 1, 1));
+    CHECK(counterIs(*hud, b, HudStat::FOLD_TO_CBET, 1, 1));
+    CHECK(counterIs(*hud, h, HudStat::WTSD, 1, 2));
+    CHECK(counterIs(*hud, h, HudStat::WSD, 0, 1));
+    CHECK(counterIs(*hud, b, HudStat::WSD, 1, 1));
+}
+
+}
+
+int main() {
+    testCounters();
+    testWindow();
+    testBotsGetSessionHud();
+    testConsoleHandsFeedHud();
+    return TEST_EXIT_CODE();
+}
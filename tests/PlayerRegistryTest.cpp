@@ -0,0 +1,92 @@
+#include "PlayerRegistry.h"
+#include "TestCheck.h"
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Потоки регистрируют пересекающиеся имена: у имени один ID, у разных имён - разные
+void testConcurrentInterning() {
+    const int threadCount = 8;
+    const int names = 2000;
+    size_t before = PlayerRegistry::getCount();
+    std::vector<std::vector<PlayerId>> ids(threadCount, std::vector<PlayerId>(names));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([t, &ids]() {
+            // Каждый поток идёт со своего места, чтобы первые регистрации приходились на разные имена
+            for (int i = 0; i < names; i++) {
+                int index = (i + t * names / threadCount) % names;
+                ids[t][index] = PlayerRegistry::getId("RegistryPlayer" + std::to_string(index));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    bool same = true;
+    std::set<PlayerId> unique;
+    for (int i = 0; i < names; i++) {
+        for (int t = 1; t < threadCount; t++) {
+            same = same && ids[t][i] == ids[0][i];
+        }
+        unique.insert(ids[0][i]);
+        same = same && PlayerRegistry::getName(ids[0][i]) == "RegistryPlayer" + std::to_string(i) &&
+               PlayerRegistry::findId("RegistryPlayer" + std::to_string(i)) == ids[0][i];
+    }
+    CHECK(same);
+    CHECK(unique.size() == static_cast<size_t>(names));
+    CHECK(PlayerRegistry::getCount() == before + names);
+    CHECK(*unique.rbegin() < PlayerRegistry::getCount());
+}
+
+// Ссылка на имя переживает рост справочника; неизвестные имена и ID не регистрируются
+void testLookups() {
+    PlayerId id = PlayerRegistry::getId("RegistryStable");
+    const std::string& name = PlayerRegistry::getName(id);
+    for (int i = 0; i < 5000; i++) {
+        PlayerRegistry::getId("RegistryGrowth" + std::to_string(i));
+    }
+    CHECK(name == "RegistryStable");
+    CHECK(&PlayerRegistry::getName(id) == &name);
+    CHECK(PlayerRegistry::getId("RegistryStable") == id);
+
+    size_t count = PlayerRegistry::getCount();
+    CHECK(PlayerRegistry::findId("RegistryMissing") == INVALID_PLAYER_ID);
+    CHECK(PlayerRegistry::getName(INVALID_PLAYER_ID).empty());
+    CHECK(PlayerRegistry::getCount() == count);
+}
+
+void testPlayerTable() {
+    PlayerTable<int> table;
+    PlayerId first = PlayerRegistry::getId("RegistryTableA");
+    PlayerId second = PlayerRegistry::getId("RegistryTableB");
+    CHECK(!table.contains(second) && table.find(second) == nullptr);
+    table[second] = 7;
+    table[first] += 3;
+    CHECK(table.size() == 2);
+    CHECK(*table.find(first) == 3 && *table.find(second) == 7);
+
+    std::vector<PlayerId> order;
+    table.forEach([&order](PlayerId id, const int&) { order.push_back(id); });
+    CHECK(order.size() == 2 && order[0] == first && order[1] == second);
+
+    table.erase(first);
+    table.erase(first);
+    CHECK(table.size() == 1 && !table.contains(first));
+    CHECK(table[first] == 0);
+    table.clear();
+    CHECK(table.size() == 0 && !table.contains(second));
+}
+
+}
+
+int main() {
+    testConcurrentInterning();
+    testLookups();
+    testPlayerTable();
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,71 @@
+#include "RulesEngine.h"
+#include "TestCheck.h"
+
+namespace {
+
+// Три места, кнопка 0: малый блайнд 1, большой 2, первым ходит место 0
+TableState threeSeats(int32_t smallBlindStack) {
+    TableState state = {};
+    state.seatCount = 3;
+    state.smallBlind = 5;
+    state.bigBlind = 10;
+    state.stacks[0] = 1000;
+    state.stacks[1] = smallBlindStack;
+    state.stacks[2] = 1000;
+    RulesEngine::startHand(state, 0);
+    return state;
+}
+
+// Неполный ва-банк: уже сходивший может только сбросить или уравнять,
+// ещё не ходивший после полного рейза сохраняет право повысить
+void testIncompleteAllInDoesNotReopen() {
+    TableState state = threeSeats(25);
+    CHECK(state.toAct == 0);
+    CHECK(RulesEngine::apply(state, { ActionType::RAISE, 20 }));
+    CHECK(state.toAct == 1);
+    CHECK(RulesEngine::apply(state, { ActionType::ALL_IN, 25 }));
+    CHECK(state.currentBet == 25);
+    CHECK(state.lastRaise == 10);
+
+    CHECK(state.toAct == 2);
+    CHECK(RulesEngine::canRaise(state, 2));
+    CHECK(RulesEngine::apply(state, { ActionType::CALL, 0 }));
+
+    CHECK(state.toAct == 0);
+    CHECK(!RulesEngine::canRaise(state, 0));
+    Action actions[RulesEngine::MAX_LEGAL_ACTIONS];
+    int count = RulesEngine::legalActions(state, actions);
+    CHECK(count == 2);
+    CHECK(actions[0].type == ActionType::FOLD && actions[1].type == ActionType::CALL);
+    CHECK(!RulesEngine::isLegal(state, { ActionType::RAISE, 100 }));
+    CHECK(!RulesEngine::isLegal(state, { ActionType::ALL_IN, 1000 }));
+    CHECK(RulesEngine::normalize(state, { ActionType::RAISE, 100 }).type == ActionType::CALL);
+    CHECK(RulesEngine::normalize(state, { ActionType::ALL_IN, 0 }).type == ActionType::CALL);
+    CHECK(!RulesEngine::apply(state, { ActionType::RAISE, 100 }));
+
+    CHECK(RulesEngine::apply(state, { ActionType::CALL, 0 }));
+    CHECK(state.phase == GamePhase::FLOP);
+    CHECK(RulesEngine::getPotAmount(state) == 75);
+    // На новой улице повышение снова открыто всем
+    CHECK(RulesEngine::canRaise(state, state.toAct));
+}
+
+// Полный рейз открывает повышение всем, кто уже сходил
+void testFullRaiseReopens() {
+    TableState state = threeSeats(1000);
+    CHECK(RulesEngine::apply(state, { ActionType::RAISE, 20 }));
+    CHECK(RulesEngine::apply(state, { ActionType::RAISE, 30 }));
+    CHECK(state.toAct == 2);
+    CHECK(RulesEngine::apply(state, { ActionType::CALL, 0 }));
+    CHECK(state.toAct == 0);
+    CHECK(RulesEngine::canRaise(state, 0));
+    CHECK(RulesEngine::isLegal(state, { ActionType::RAISE, 40 }));
+}
+
+}
+
+int main() {
+    testIncompleteAllInDoesNotReopen();
+    testFullRaiseReopens();
+    return TEST_EXIT_CODE();
+}
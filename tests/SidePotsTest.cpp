@@ -0,0 +1,105 @@
+#include "SidePots.h"
+#include "TestCheck.h"
+#include <random>
+
+namespace {
+
+int32_t sum(const int32_t* values, int count) {
+    int32_t total = 0;
+    for (int i = 0; i < count; i++) total += values[i];
+    return total;
+}
+
+// Три ва-банка разной глубины, уравнявший и сбросивший; ничья в основном банке
+// с нечётной фишкой - первому победителю после кнопки
+void testThreeAllInsWithOddChip() {
+    const int32_t committed[MAX_SEATS] = { 30, 60, 100, 100, 5 };
+    const uint16_t live = 0x0F;  // место 4 сбросило
+    PotLayer layers[MAX_SEATS];
+    int count = SidePots::build(committed, 5, live, layers);
+    CHECK(count == 3);
+    CHECK(layers[0].amount == 125 && layers[0].eligible == 0x0F);
+    CHECK(layers[1].amount == 90 && layers[1].eligible == 0x0E);
+    CHECK(layers[2].amount == 80 && layers[2].eligible == 0x0C);
+
+    const int scores[MAX_SEATS] = { 9, 9, 5, 5, 100 };
+    int32_t payouts[MAX_SEATS] = {};
+    SidePots::award(layers, count, scores, 5, 0, payouts);
+    CHECK(payouts[0] == 62);
+    CHECK(payouts[1] == 63 + 90);
+    CHECK(payouts[2] == 40 && payouts[3] == 40);
+    CHECK(payouts[4] == 0);
+    CHECK(sum(payouts, 5) == sum(committed, 5));
+}
+
+// Делёж на троих: обе лишние фишки уходят по кругу от кнопки
+void testThreeWaySplit() {
+    const int32_t committed[MAX_SEATS] = { 34, 34, 34, 0 };
+    PotLayer layers[MAX_SEATS];
+    int count = SidePots::build(committed, 4, 0x07, layers);
+    CHECK(count == 1 && layers[0].amount == 102);
+
+    const int32_t odd[MAX_SEATS] = { 33, 33, 33, 1 };
+    count = SidePots::build(odd, 4, 0x07, layers);
+    CHECK(count == 1 && layers[0].amount == 100);
+    const int scores[MAX_SEATS] = { 7, 7, 7, 0 };
+    int32_t payouts[MAX_SEATS] = {};
+    SidePots::award(layers, count, scores, 4, 1, payouts);
+    CHECK(payouts[2] == 34 && payouts[0] == 33 && payouts[1] == 33);
+}
+
+// Сбросивший внёс больше всех оставшихся: его фишки сверху идут в последний слой
+void testFoldedAboveLastLevel() {
+    const int32_t committed[MAX_SEATS] = { 20, 50, 150, 50 };
+    PotLayer layers[MAX_SEATS];
+    int count = SidePots::build(committed, 4, 0x0B, layers);
+    CHECK(count == 2);
+    CHECK(layers[0].amount == 80 && layers[0].eligible == 0x0B);
+    CHECK(layers[1].amount == 190 && layers[1].eligible == 0x0A);
+}
+
+// Случайные взносы: слои вложены, сумма слоёв и выплат равна банку
+void testRandomInvariants() {
+    std::mt19937 rng(37);
+    bool ok = true;
+    for (int round = 0; round < 2000 && ok; round++) {
+        int seats = 2 + static_cast<int>(rng() % (MAX_SEATS - 1));
+        int32_t committed[MAX_SEATS] = {};
+        int scores[MAX_SEATS] = {};
+        uint16_t live = 0;
+        for (int seat = 0; seat < seats; seat++) {
+            committed[seat] = static_cast<int32_t>(rng() % 6) * 25 + static_cast<int32_t>(rng() % 3);
+            scores[seat] = static_cast<int>(rng() % 4);
+            if (rng() % 4 != 0) live |= static_cast<uint16_t>(1u << seat);
+        }
+        if (!live) live = 1;
+        PotLayer layers[MAX_SEATS];
+        int count = SidePots::build(committed, seats, live, layers);
+        int32_t layerTotal = 0;
+        for (int i = 0; i < count; i++) {
+            layerTotal += layers[i].amount;
+            ok = ok && (layers[i].eligible & ~live) == 0 && layers[i].eligible != 0;
+            ok = ok && (i == 0 || (layers[i].eligible & ~layers[i - 1].eligible) == 0);
+        }
+        int32_t total = sum(committed, seats);
+        ok = ok && layerTotal == total;
+
+        int32_t payouts[MAX_SEATS] = {};
+        SidePots::award(layers, count, scores, seats, static_cast<int>(rng() % seats), payouts);
+        ok = ok && sum(payouts, seats) == total;
+        for (int seat = 0; seat < seats; seat++) {
+            ok = ok && (payouts[seat] == 0 || (live & (1u << seat)));
+        }
+    }
+    CHECK(ok);
+}
+
+}
+
+int main() {
+    testThreeAllInsWithOddChip();
+    testThreeWaySplit();
+    testFoldedAboveLastLevel();
+    testRandomInvariants();
+    return TEST_EXIT_CODE();
+}
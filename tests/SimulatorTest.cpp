@@ -0,0 +1,75 @@
+#include "Simulator.h"
+#include "TestCheck.h"
+#include <memory>
+
+namespace {
+
+void testCreateAgents() {
+    for (const char* spec : { "bot", "bot:raise=0.5,sampling=quasi", "call", "raise", "allin", "script:FKCRA", "pushfold:8" }) {
+        std::unique_ptr<Agent> agent = Agent::create(spec, "SimAgent", 1);
+        CHECK(agent != nullptr);
+        if (agent) CHECK(agent->getName() == "SimAgent");
+    }
+    CHECK(Agent::create("nobody", "SimAgent", 1) == nullptr);
+    CHECK(Agent::create("bot:nonsense=1", "SimAgent", 1) == nullptr);
+    CHECK(Agent::getPushFoldThreshold("pushfold:12") == 12);
+    CHECK(Agent::getPushFoldThreshold("call") == -1);
+}
+
+bool sameStats(const SimulationStats& a, const SimulationStats& b) {
+    return a.hands == b.hands && a.showdowns == b.showdowns && a.ties == b.ties && a.wins[0] == b.wins[0] &&
+           a.wins[1] == b.wins[1] && a.netChips[0] == b.netChips[0] && a.netChips[1] == b.netChips[1];
+}
+
+// Два коллера всегда доходят до вскрытия; фишки только переходят между местами
+void testCallersZeroSum() {
+    auto first = Agent::create("call", "SimCallA", 1);
+    auto second = Agent::create("call", "SimCallB", 2);
+    Simulator simulator(*first, *second, 29);
+    const SimulationStats& stats = simulator.run(2000);
+    CHECK(stats.hands == 2000);
+    CHECK(stats.showdowns == 2000);
+    CHECK(stats.wins[0] + stats.wins[1] + stats.ties == stats.hands);
+    CHECK(stats.netChips[0] == -stats.netChips[1]);
+    CHECK(stats.wins[0] > 0 && stats.wins[1] > 0);
+}
+
+// Всегда сбрасывающий теряет малый блайнд на кнопке и большой - в большом блайнде
+void testFolderLosesBlinds() {
+    auto folder = Agent::create("script:F", "SimFolder", 1);
+    auto caller = Agent::create("call", "SimCaller", 2);
+    Simulator simulator(*folder, *caller, 29);
+    const SimulationStats& stats = simulator.run(1000);
+    CHECK(stats.showdowns == 0);
+    CHECK(stats.wins[1] == 1000);
+    CHECK(stats.netChips[0] == -(500 * 5 + 500 * 10));
+}
+
+// Одинаковые зёрна - одинаковые итоги, reseed и resetStats повторяют прогон
+void testDeterministic() {
+    auto a1 = Agent::create("bot", "SimBotA", 7);
+    auto b1 = Agent::create("bot", "SimBotB", 8);
+    Simulator first(*a1, *b1, 99);
+    SimulationStats expected = first.run(300);
+
+    auto a2 = Agent::create("bot", "SimBotA", 7);
+    auto b2 = Agent::create("bot", "SimBotB", 8);
+    Simulator second(*a2, *b2, 99);
+    CHECK(sameStats(second.run(300), expected));
+
+    a2->reseed(7);
+    b2->reseed(8);
+    second.reseed(99);
+    second.resetStats();
+    CHECK(sameStats(second.run(300), expected));
+}
+
+}
+
+int main() {
+    testCreateAgents();
+    testCallersZeroSum();
+    testFolderLosesBlinds();
+    testDeterministic();
+    return TEST_EXIT_CODE();
+}
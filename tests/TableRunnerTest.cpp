@@ -0,0 +1,88 @@
+#include "TableRunner.h"
+#include "TestCheck.h"
+#include <atomic>
+
+namespace {
+
+// Все задачи выполняются, в том числе отправленные из потоков пула
+void testPoolRunsNestedTasks() {
+    ThreadPool pool(4);
+    CHECK(pool.getThreadCount() == 4);
+    std::atomic<int> done(0);
+    std::atomic<bool> workersOk(true);
+    for (int i = 0; i < 1000; i++) {
+        pool.submit([&pool, &done, &workersOk](unsigned worker) {
+            if (worker >= pool.getThreadCount()) workersOk = false;
+            pool.submit([&done](unsigned) { done++; });
+            done++;
+        });
+    }
+    pool.wait();
+    CHECK(done == 2000);
+    CHECK(workersOk);
+
+    // Пул переиспользуется после wait()
+    pool.submit([&done](unsigned) { done++; });
+    pool.wait();
+    CHECK(done == 2001);
+}
+
+void testMergeStats() {
+    SimulationStats first;
+    first.hands = 10;
+    first.showdowns = 4;
+    first.ties = 1;
+    first.wins[0] = 6;
+    first.wins[1] = 3;
+    first.netChips[0] = 50;
+    first.netChips[1] = -50;
+    first.seconds = 2.0;
+    SimulationStats second;
+    second.hands = 5;
+    second.showdowns = 2;
+    second.wins[1] = 5;
+    second.netChips[0] = -20;
+    second.netChips[1] = 20;
+    second.seconds = 1.0;
+    first.merge(second);
+    CHECK(first.hands == 15 && first.showdowns == 6 && first.ties == 1);
+    CHECK(first.wins[0] == 6 && first.wins[1] == 8);
+    CHECK(first.netChips[0] == 30 && first.netChips[1] == -30);
+    CHECK(first.seconds == 2.0);
+}
+
+SimulationStats runTables(unsigned threads, int tablesPerTask) {
+    RunnerConfig config;
+    config.tables = 37;
+    config.handsPerTable = 40;
+    config.seed = 31;
+    config.tablesPerTask = tablesPerTask;
+    TableRunner runner([](int seat) { return Agent::create("bot", seat == 0 ? "RunnerA" : "RunnerB", 1); }, config);
+    ThreadPool pool(threads);
+    return runner.run(pool);
+}
+
+// Итог не зависит от числа потоков и нарезки столов на задачи
+void testRunnerMergeIsStable() {
+    SimulationStats single = runTables(1, 8);
+    CHECK(single.hands == 37 * 40);
+    CHECK(single.wins[0] + single.wins[1] + single.ties == single.hands);
+    CHECK(single.netChips[0] == -single.netChips[1]);
+
+    for (int tablesPerTask : { 1, 5, 8 }) {
+        SimulationStats parallel = runTables(4, tablesPerTask);
+        CHECK(parallel.hands == single.hands && parallel.showdowns == single.showdowns && parallel.ties == single.ties);
+        CHECK(parallel.wins[0] == single.wins[0] && parallel.wins[1] == single.wins[1]);
+        CHECK(parallel.netChips[0] == single.netChips[0] && parallel.netChips[1] == single.netChips[1]);
+    }
+    CHECK(TableRunner::getTableSeed(31, 0) != TableRunner::getTableSeed(31, 1));
+}
+
+}
+
+int main() {
+    testPoolRunsNestedTasks();
+    testMergeStats();
+    testRunnerMergeIsStable();
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,36 @@
+#ifndef POKER_TESTCHECK_H
+#define POKER_TESTCHECK_H
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+// Минимальные проверки для тестов ctest: провал печатается и учитывается,
+// тест продолжает работу; код возврата main - TEST_EXIT_CODE().
+namespace TestCheck {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void fail(const char* expression, const char* file, int line) {
+    std::cout << "Ошибка: " << file << ":" << line << ": " << expression << std::endl;
+    failures()++;
+}
+
+// Путь во временном каталоге, уникальный для теста
+inline std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("poker_test_" + name)).string();
+}
+
+}
+
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) TestCheck::fail(#expression, __FILE__, __LINE__); \
+    } while (0)
+
+#define TEST_EXIT_CODE() (TestCheck::failures() == 0 ? 0 : 1)
+
+#endif
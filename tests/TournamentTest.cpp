@@ -0,0 +1,56 @@
+#include "Tournament.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+void testLevelsPastSchedule() {
+    std::vector<BlindLevel> levels = { { 10, 20 }, { 15, 30 } };
+    BlindLevel level = Tournament::getLevel(levels, 1);
+    CHECK(level.smallBlind == 15 && level.bigBlind == 30);
+    level = Tournament::getLevel(levels, 3);
+    CHECK(level.smallBlind == 60 && level.bigBlind == 120);
+
+    // Далеко за сеткой блайнды упираются в предел, а не переполняют int
+    level = Tournament::getLevel(levels, 1000);
+    CHECK(level.bigBlind > std::numeric_limits<int>::max() / 2);
+    CHECK(level.smallBlind > 0 && level.smallBlind <= level.bigBlind);
+    level = Tournament::getLevel(levels, 1000, 270000);
+    CHECK(level.bigBlind == 245760);
+    level = Tournament::getLevel(levels, -5);
+    CHECK(level.bigBlind == 20);
+
+    BlindLevel fallback = Tournament::getLevel({}, 0);
+    CHECK(fallback.bigBlind == Tournament::getDefaultSchedule().front().bigBlind);
+}
+
+// Турнир с быстрым ростом блайндов доигрывается, каждый участник получает место
+void testLongTournamentFinishes() {
+    TournamentConfig config;
+    config.players = 20;
+    config.seatsPerTable = 6;
+    config.handsPerLevel = 1;
+    config.levels = { { 1, 2 } };
+    AgentFactory factory = [](int player) {
+        return Agent::create(player % 2 ? "call" : "bot", "P" + std::to_string(player), player);
+    };
+    TournamentResult result = Tournament(config, factory).run();
+    CHECK(result.finishOrder.size() == 20);
+    std::vector<int> order = result.finishOrder;
+    std::sort(order.begin(), order.end());
+    bool permutation = true;
+    for (int i = 0; i < static_cast<int>(order.size()); i++) {
+        permutation = permutation && order[i] == i;
+    }
+    CHECK(permutation);
+    CHECK(result.rounds < config.maxRounds);
+}
+
+}
+
+int main() {
+    testLevelsPastSchedule();
+    testLongTournamentFinishes();
+    return TEST_EXIT_CODE();
+}
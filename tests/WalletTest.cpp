@@ -0,0 +1,74 @@
+#include "Wallet.h"
+#include "TestCheck.h"
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+// Кошельки по умолчанию (PlayerTable создаёт их при росте) не трогают справочник игроков
+void testDefaultWalletHasNoOwner() {
+    size_t players = PlayerRegistry::getCount();
+    PlayerTable<Wallet> wallets;
+    wallets[PlayerRegistry::getId("WalletTestOwner")];
+    players++;
+    for (int i = 0; i < 100; i++) {
+        Wallet wallet;
+        CHECK(wallet.getOwnerId() == INVALID_PLAYER_ID);
+        CHECK(wallet.getOwner() == "Unknown");
+    }
+    CHECK(PlayerRegistry::getCount() == players);
+}
+
+size_t countLines(const std::string& file) {
+    std::ifstream in(file);
+    std::string line;
+    size_t count = 0;
+    while (std::getline(in, line)) {
+        count++;
+    }
+    return count;
+}
+
+// Курсор выгрузки не пропускает транзакции после очистки и перезагрузки истории
+void testExportCursor() {
+    std::string exported = TestCheck::tempPath("wallet_export.csv");
+    std::string saved = TestCheck::tempPath("wallet_saved.csv");
+    std::remove(exported.c_str());
+
+    Wallet wallet("CursorOwner", 1000);
+    wallet.deposit(10);
+    wallet.deposit(20);
+    ExportCursor cursor;
+    CHECK(wallet.exportTransactionsToCSV(exported, cursor) == 3);
+    CHECK(wallet.exportTransactionsToCSV(exported, cursor) == 0);
+
+    wallet.clearHistory();
+    for (int i = 0; i < 5; i++) {
+        wallet.deposit(1);
+    }
+    CHECK(wallet.exportTransactionsToCSV(exported, cursor) == 5);
+
+    wallet.reset();
+    CHECK(wallet.exportTransactionsToCSV(exported, cursor) == 1);
+
+    Wallet other("CursorOwner", 500);
+    other.deposit(5);
+    other.deposit(6);
+    other.deposit(7);
+    other.saveToFile(saved);
+    wallet.loadFromFile(saved);
+    CHECK(wallet.getTransactionCount() == 4);
+    CHECK(wallet.exportTransactionsToCSV(exported, cursor) == 4);
+    CHECK(countLines(exported) == 1 + 3 + 5 + 1 + 4);
+
+    std::remove(exported.c_str());
+    std::remove(saved.c_str());
+}
+
+}
+
+int main() {
+    testDefaultWalletHasNoOwner();
+    testExportCursor();
+    return TEST_EXIT_CODE();
+}